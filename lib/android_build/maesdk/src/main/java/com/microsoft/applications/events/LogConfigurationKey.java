@@ -70,6 +70,12 @@ public enum LogConfigurationKey {
   /** The trace filepath. */
   CFG_STR_TRACE_FOLDER_PATH("traceFolderPath", String.class),
 
+  /** Size in bytes at which the trace file is rotated, 0 for no rotation. */
+  CFG_INT_TRACE_FILE_SIZE("traceFileSize", Long.class),
+
+  /** Map of trace component names to the minimum trace level of that component. */
+  CFG_MAP_TRACE_COMPONENT_LEVELS("traceComponentLevels", ILogConfiguration.class),
+
   /** The SDK mode. */
   CFG_INT_SDK_MODE("sdkmode", Long.class),
 
@@ -113,6 +119,9 @@ public enum LogConfigurationKey {
   /** Parameter that allows to load a set of custom transmit profile on SDK start */
   CFG_STR_TRANSMIT_PROFILES("transmitProfiles", String.class),
 
+  /** Number of threads helping to inspect events logged in groups with registered data inspectors. */
+  CFG_INT_DATA_INSPECTOR_THREADS("dataInspectorThreads", Long.class),
+
   /** LogManagerFactory manager name */
   CFG_STR_FACTORY_NAME("name", String.class),
 
@@ -0,0 +1,50 @@
+//
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// SPDX-License-Identifier: Apache-2.0
+//
+#include "AggregatedMetric.hpp"
+#include "stats/MetricAggregator.hpp"
+
+namespace MAT_NS_BEGIN
+{
+    namespace Models {
+
+        AggregatedMetric::AggregatedMetric(std::string const& name,
+            std::string const& units,
+            unsigned const intervalInSec,
+            EventProperties const& eventProperties,
+            ILogger* pLogger) :
+            AggregatedMetric(name, units, intervalInSec, std::string(), std::string(), std::string(), eventProperties, pLogger)
+        {
+        }
+
+        AggregatedMetric::AggregatedMetric(std::string const& name,
+            std::string const& units,
+            unsigned const intervalInSec,
+            std::string const& instanceName,
+            std::string const& objectClass,
+            std::string const& objectId,
+            EventProperties const& eventProperties,
+            ILogger* pLogger)
+        {
+            AggregatedMetricData metric(name, 0, 0);
+            metric.units = units;
+            metric.instanceName = instanceName;
+            metric.objectClass = objectClass;
+            metric.objectId = objectId;
+            m_pAggregatedMetricImpl = new MetricAggregator(metric, intervalInSec, eventProperties, pLogger);
+        }
+
+        AggregatedMetric::~AggregatedMetric()
+        {
+            delete static_cast<MetricAggregator*>(m_pAggregatedMetricImpl);
+        }
+
+        void AggregatedMetric::PushMetric(double value)
+        {
+            static_cast<MetricAggregator*>(m_pAggregatedMetricImpl)->Push(value);
+        }
+
+    } // Models
+
+} MAT_NS_END
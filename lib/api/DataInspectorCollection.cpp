@@ -0,0 +1,230 @@
+//
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// SPDX-License-Identifier: Apache-2.0
+//
+#include "DataInspectorCollection.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+namespace MAT_NS_BEGIN {
+
+    DataInspectorCollection::DataInspectorCollection(size_t workerThreads) :
+        m_inspectors(std::make_shared<const Inspectors>()),
+        m_count(0),
+        m_stopping(false)
+    {
+        m_workers.reserve(workerThreads);
+        for (size_t i = 0; i < workerThreads; i++)
+        {
+            m_workers.emplace_back(&DataInspectorCollection::threadFunc, this);
+        }
+    }
+
+    DataInspectorCollection::~DataInspectorCollection() noexcept
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_workLock);
+            m_stopping = true;
+        }
+        m_workAvailable.notify_all();
+        for (auto& worker : m_workers)
+        {
+            worker.join();
+        }
+    }
+
+    std::shared_ptr<const DataInspectorCollection::Inspectors> DataInspectorCollection::snapshot() const noexcept
+    {
+        return std::atomic_load(&m_inspectors);
+    }
+
+    void DataInspectorCollection::publish(std::shared_ptr<const Inspectors> const& inspectors) noexcept
+    {
+        std::atomic_store(&m_inspectors, inspectors);
+        m_count.store(inspectors->size(), std::memory_order_release);
+    }
+
+    bool DataInspectorCollection::Set(std::shared_ptr<IDataInspector> const& dataInspector)
+    {
+        std::lock_guard<std::mutex> lock(m_writeLock);
+        auto inspectors = std::make_shared<Inspectors>(*snapshot());
+        auto it = std::find_if(inspectors->begin(), inspectors->end(), [&dataInspector](std::shared_ptr<IDataInspector> const& current) {
+            return strcmp(dataInspector->GetName(), current->GetName()) == 0;
+        });
+        bool replaced = (it != inspectors->end());
+        if (replaced)
+        {
+            inspectors->erase(it);
+        }
+        inspectors->push_back(dataInspector);
+        publish(inspectors);
+        return replaced;
+    }
+
+    void DataInspectorCollection::Remove(std::string const& name)
+    {
+        std::lock_guard<std::mutex> lock(m_writeLock);
+        auto inspectors = std::make_shared<Inspectors>(*snapshot());
+        auto it = std::find_if(inspectors->begin(), inspectors->end(), [&name](std::shared_ptr<IDataInspector> const& inspector) {
+            return strcmp(inspector->GetName(), name.c_str()) == 0;
+        });
+        if (it != inspectors->end())
+        {
+            inspectors->erase(it);
+            publish(inspectors);
+        }
+    }
+
+    void DataInspectorCollection::Clear()
+    {
+        std::lock_guard<std::mutex> lock(m_writeLock);
+        publish(std::make_shared<const Inspectors>());
+    }
+
+    std::shared_ptr<IDataInspector> DataInspectorCollection::Get(std::string const& name) const
+    {
+        auto inspectors = snapshot();
+        auto it = std::find_if(inspectors->begin(), inspectors->end(), [&name](std::shared_ptr<IDataInspector> const& inspector) {
+            return strcmp(inspector->GetName(), name.c_str()) == 0;
+        });
+        return (it != inspectors->end()) ? *it : nullptr;
+    }
+
+    void DataInspectorCollection::inspect(Inspectors const& inspectors, ::CsProtocol::Record& record) noexcept
+    {
+        for (auto const& inspector : inspectors)
+        {
+            inspector->InspectRecord(record);
+        }
+    }
+
+    void DataInspectorCollection::InspectRecord(::CsProtocol::Record& record) const noexcept
+    {
+        if (IsEmpty())
+        {
+            return;
+        }
+        inspect(*snapshot(), record);
+    }
+
+    void DataInspectorCollection::InspectRecords(std::vector<IncomingEventContextPtr> const& events)
+    {
+        if (IsEmpty())
+        {
+            return;
+        }
+
+        auto inspectors = snapshot();
+        // The calling thread takes a chunk too
+        size_t const threads = m_workers.size() + 1;
+        size_t const chunkSize = std::max(MinRecordsPerChunk, (events.size() + threads - 1) / threads);
+        if (m_workers.empty() || events.size() <= chunkSize)
+        {
+            for (auto const& event : events)
+            {
+                inspect(*inspectors, *(event->source));
+            }
+            return;
+        }
+
+        auto job = std::make_shared<Job>();
+        job->inspectors = inspectors;
+        job->events = &events;
+        job->chunkSize = chunkSize;
+        job->chunkCount = (events.size() + chunkSize - 1) / chunkSize;
+        job->nextChunk = 0;
+        job->doneChunks = 0;
+        {
+            std::lock_guard<std::mutex> lock(m_workLock);
+            m_jobs.push_back(job);
+        }
+        m_workAvailable.notify_all();
+
+        while (runChunk(*job))
+        {
+        }
+
+        // The events belong to the caller, the workers must be done with them before returning
+        std::unique_lock<std::mutex> lock(m_workLock);
+        auto it = std::find(m_jobs.begin(), m_jobs.end(), job);
+        if (it != m_jobs.end())
+        {
+            m_jobs.erase(it);
+        }
+        m_jobDone.wait(lock, [&job]() { return job->doneChunks.load(std::memory_order_acquire) == job->chunkCount; });
+    }
+
+    void DataInspectorCollection::InspectSemanticContext(std::string const& contextName, std::string const& contextValue, bool isGlobalContext, std::string const& associatedTenant) const noexcept
+    {
+        if (IsEmpty())
+        {
+            return;
+        }
+        for (auto const& inspector : *snapshot())
+        {
+            inspector->InspectSemanticContext(contextName, contextValue, isGlobalContext, associatedTenant);
+        }
+    }
+
+    void DataInspectorCollection::InspectSemanticContext(std::string const& contextName, GUID_t contextValue, bool isGlobalContext, std::string const& associatedTenant) const noexcept
+    {
+        if (IsEmpty())
+        {
+            return;
+        }
+        for (auto const& inspector : *snapshot())
+        {
+            inspector->InspectSemanticContext(contextName, contextValue, isGlobalContext, associatedTenant);
+        }
+    }
+
+    bool DataInspectorCollection::runChunk(Job& job)
+    {
+        size_t const chunk = job.nextChunk.fetch_add(1);
+        if (chunk >= job.chunkCount)
+        {
+            return false;
+        }
+
+        size_t const begin = chunk * job.chunkSize;
+        size_t const end = std::min(begin + job.chunkSize, job.events->size());
+        for (size_t i = begin; i < end; i++)
+        {
+            inspect(*job.inspectors, *((*job.events)[i]->source));
+        }
+
+        if (job.doneChunks.fetch_add(1, std::memory_order_acq_rel) + 1 == job.chunkCount)
+        {
+            // Taking the lock keeps the caller from missing the notification between its check and wait
+            {
+                std::lock_guard<std::mutex> lock(m_workLock);
+            }
+            m_jobDone.notify_all();
+        }
+        return true;
+    }
+
+    void DataInspectorCollection::threadFunc()
+    {
+        std::unique_lock<std::mutex> lock(m_workLock);
+        for (;;)
+        {
+            m_workAvailable.wait(lock, [this]() { return m_stopping || !m_jobs.empty(); });
+            if (m_jobs.empty())
+            {
+                return;
+            }
+
+            std::shared_ptr<Job> job = m_jobs.front();
+            lock.unlock();
+            bool claimed = runChunk(*job);
+            lock.lock();
+            if (!claimed && !m_jobs.empty() && m_jobs.front() == job)
+            {
+                m_jobs.pop_front();
+            }
+        }
+    }
+
+} MAT_NS_END
@@ -0,0 +1,126 @@
+//
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// SPDX-License-Identifier: Apache-2.0
+//
+#ifndef DATAINSPECTORCOLLECTION_HPP
+#define DATAINSPECTORCOLLECTION_HPP
+
+#include "ctmacros.hpp"
+#include "IDataInspector.hpp"
+#include "system/Contexts.hpp"
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace MAT_NS_BEGIN {
+
+    /// <summary>
+    /// Data inspectors of a LogManager, at most one per name.
+    ///
+    /// Inspectors are registered rarely and looked up for every event, so the
+    /// registered set is an immutable snapshot replaced on every change:
+    /// inspecting a record takes no lock held by other inspecting threads, and
+    /// an inspector removed meanwhile stays alive until the inspections using
+    /// it are done. With worker threads, larger groups of records are split
+    /// into chunks inspected by the workers and the calling thread together.
+    /// </summary>
+    class DataInspectorCollection
+    {
+    public:
+        /// <summary>
+        /// Groups of fewer records are inspected on the calling thread only
+        /// </summary>
+        static constexpr size_t MinRecordsPerChunk = 4;
+
+        /// <param name="workerThreads">Threads helping to inspect groups of records, 0 for none</param>
+        explicit DataInspectorCollection(size_t workerThreads = 0);
+        ~DataInspectorCollection() noexcept;
+
+        DataInspectorCollection(DataInspectorCollection const&) = delete;
+        DataInspectorCollection& operator=(DataInspectorCollection const&) = delete;
+
+        /// <summary>
+        /// Adds an inspector, replacing the one of the same name
+        /// </summary>
+        /// <returns>true if an inspector of the same name was replaced</returns>
+        bool Set(std::shared_ptr<IDataInspector> const& dataInspector);
+
+        void Remove(std::string const& name);
+
+        void Clear();
+
+        std::shared_ptr<IDataInspector> Get(std::string const& name) const;
+
+        bool IsEmpty() const noexcept
+        {
+            return m_count.load(std::memory_order_acquire) == 0;
+        }
+
+        size_t GetWorkerCount() const noexcept
+        {
+            return m_workers.size();
+        }
+
+        /// <summary>
+        /// Runs all inspectors on a record, on the calling thread
+        /// </summary>
+        void InspectRecord(::CsProtocol::Record& record) const noexcept;
+
+        /// <summary>
+        /// Runs all inspectors on the records of a group of events and returns
+        /// once all of them are inspected
+        /// </summary>
+        void InspectRecords(std::vector<IncomingEventContextPtr> const& events);
+
+        /// <summary>
+        /// Runs all inspectors on a semantic context value, on the calling thread
+        /// </summary>
+        void InspectSemanticContext(std::string const& contextName, std::string const& contextValue, bool isGlobalContext, std::string const& associatedTenant) const noexcept;
+
+        void InspectSemanticContext(std::string const& contextName, GUID_t contextValue, bool isGlobalContext, std::string const& associatedTenant) const noexcept;
+
+    protected:
+        using Inspectors = std::vector<std::shared_ptr<IDataInspector>>;
+
+        /// <summary>
+        /// Records of one InspectRecords() call, claimed chunk by chunk
+        /// </summary>
+        struct Job
+        {
+            std::shared_ptr<const Inspectors>           inspectors;
+            std::vector<IncomingEventContextPtr> const* events;
+            size_t                                      chunkSize;
+            size_t                                      chunkCount;
+            std::atomic<size_t>                         nextChunk;
+            std::atomic<size_t>                         doneChunks;
+        };
+
+        std::shared_ptr<const Inspectors> snapshot() const noexcept;
+        void publish(std::shared_ptr<const Inspectors> const& inspectors) noexcept;
+        bool runChunk(Job& job);
+        void threadFunc();
+
+        static void inspect(Inspectors const& inspectors, ::CsProtocol::Record& record) noexcept;
+
+        // Replaced under m_writeLock, read with std::atomic_load
+        std::shared_ptr<const Inspectors>   m_inspectors;
+        std::atomic<size_t>                 m_count;
+        std::mutex                          m_writeLock;
+
+        std::mutex                          m_workLock;
+        std::condition_variable             m_workAvailable;
+        std::condition_variable             m_jobDone;
+        std::deque<std::shared_ptr<Job>>    m_jobs;
+        bool                                m_stopping;
+        std::vector<std::thread>            m_workers;
+    };
+
+} MAT_NS_END
+
+#endif // DATAINSPECTORCOLLECTION_HPP
@@ -4,24 +4,153 @@
 //
 #include "DataViewerCollection.hpp"
 #include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
 #include <mutex>
+#include <thread>
 
 namespace MAT_NS_BEGIN {
 
     MATSDK_LOG_INST_COMPONENT_CLASS(DataViewerCollection, "EventsSDK.DataViewerCollection", "Microsoft Telemetry Client - DataViewerCollection class");
 
+    /// <summary>
+    /// Bounded queue of packets and the thread handing them to the viewers
+    /// </summary>
+    class DataViewerCollection::DispatchQueue
+    {
+    public:
+        using Packet = std::shared_ptr<const std::vector<uint8_t>>;
+
+        explicit DispatchQueue(DataViewerCollection const& owner) :
+            m_owner(owner)
+        {
+        }
+
+        ~DispatchQueue()
+        {
+            {
+                std::lock_guard<std::mutex> lock(m_lock);
+                m_stopping = true;
+            }
+            m_changed.notify_all();
+            if (m_thread.joinable())
+            {
+                m_thread.join();
+            }
+        }
+
+        void Push(Packet&& packet)
+        {
+            std::lock_guard<std::mutex> lock(m_lock);
+            if (!m_thread.joinable())
+            {
+                m_thread = std::thread(&DispatchQueue::threadFunc, this);
+            }
+            if (m_queue.size() >= MaxPendingPackets)
+            {
+                m_queue.pop_front();
+                m_dropped++;
+                LOG_WARN("Data viewers do not keep up, dropped %llu packets so far", static_cast<unsigned long long>(m_dropped.load()));
+            }
+            m_queue.push_back(std::move(packet));
+            m_changed.notify_all();
+        }
+
+        void WaitForDispatch()
+        {
+            std::unique_lock<std::mutex> lock(m_lock);
+            m_changed.wait(lock, [this]() { return m_queue.empty() && !m_dispatching; });
+        }
+
+        std::atomic<uint64_t> m_dispatched { 0 };
+        std::atomic<uint64_t> m_dropped { 0 };
+
+    protected:
+        void threadFunc()
+        {
+            std::unique_lock<std::mutex> lock(m_lock);
+            for (;;)
+            {
+                m_changed.wait(lock, [this]() { return m_stopping || !m_queue.empty(); });
+                if (m_queue.empty())
+                {
+                    break;
+                }
+                Packet packet = std::move(m_queue.front());
+                m_queue.pop_front();
+                m_dispatching = true;
+                lock.unlock();
+
+                // Viewers run without any lock held, they may register or unregister viewers
+                for (auto const& viewer : m_owner.GetViewers())
+                {
+                    viewer->ReceiveData(*packet);
+                }
+                m_dispatched++;
+
+                lock.lock();
+                m_dispatching = false;
+                m_changed.notify_all();
+            }
+        }
+
+        DataViewerCollection const& m_owner;
+        std::mutex                  m_lock;
+        std::condition_variable     m_changed;
+        std::deque<Packet>          m_queue;
+        bool                        m_dispatching = false;
+        bool                        m_stopping = false;
+        std::thread                 m_thread;
+    };
+
+    DataViewerCollection::DataViewerCollection() :
+        m_dispatchQueue(new DispatchQueue(*this))
+    {
+    }
+
+    DataViewerCollection::~DataViewerCollection() noexcept
+    {
+        // Hands over the packets still waiting while the viewers are around
+        m_dispatchQueue.reset();
+    }
+
     void DataViewerCollection::DispatchDataViewerEvent(const std::vector<uint8_t>& packetData) const noexcept
     {
         if (IsViewerEnabled() == false)
             return;
 
-        LOCKGUARD(m_dataViewerMapLock);
-        for(const auto& viewer : m_dataViewerCollection)
+        try
         {
-            // Task 3568800: Integrate ThreadPool to IDataViewerCollection
-            viewer->ReceiveData(packetData);
+            m_dispatchQueue->Push(std::make_shared<const std::vector<uint8_t>>(packetData));
         }
-    };
+        catch (...)
+        {
+            m_dispatchQueue->m_dropped++;
+            LOG_ERROR("Failed to queue a packet for the data viewers");
+        }
+    }
+
+    void DataViewerCollection::WaitForDispatch() const
+    {
+        m_dispatchQueue->WaitForDispatch();
+    }
+
+    uint64_t DataViewerCollection::GetDispatchedCount() const noexcept
+    {
+        return m_dispatchQueue->m_dispatched.load();
+    }
+
+    uint64_t DataViewerCollection::GetDroppedCount() const noexcept
+    {
+        return m_dispatchQueue->m_dropped.load();
+    }
+
+    std::vector<std::shared_ptr<IDataViewer>> DataViewerCollection::GetViewers() const
+    {
+        LOCKGUARD(m_dataViewerMapLock);
+        return m_dataViewerCollection;
+    }
 
     void DataViewerCollection::RegisterViewer(const std::shared_ptr<IDataViewer>& dataViewer)
     {
@@ -9,14 +9,28 @@
 #include "IDataViewerCollection.hpp"
 #include "pal/PAL.hpp"
 
+#include <memory>
 #include <mutex>
 #include <vector>
 
 namespace MAT_NS_BEGIN {
 
+    /// <summary>
+    /// Registered data viewers. Packets are handed to the viewers on a thread of
+    /// their own, started with the first packet, so that a slow viewer does not
+    /// hold back uploads. Up to MaxPendingPackets packets wait for the viewers,
+    /// beyond that the oldest waiting packet is dropped.
+    /// </summary>
     class DataViewerCollection : public IDataViewerCollection
     {
     public:
+        static constexpr size_t MaxPendingPackets = 32;
+
+        DataViewerCollection();
+
+        /// <summary>
+        /// Queues a copy of the packet, shared by all viewers.
+        /// </summary>
         virtual void DispatchDataViewerEvent(const std::vector<uint8_t>& packetData) const noexcept override;
 
         virtual void RegisterViewer(const std::shared_ptr<IDataViewer>& dataViewer) override;
@@ -31,14 +45,33 @@ namespace MAT_NS_BEGIN {
 
         virtual bool IsViewerRegistered(const char* viewerName) const override;
 
-        virtual ~DataViewerCollection() noexcept {};
+        /// <summary>
+        /// Waits until the viewers have received all packets queued so far.
+        /// </summary>
+        void WaitForDispatch() const;
+
+        /// <summary>
+        /// Number of packets handed to the viewers.
+        /// </summary>
+        uint64_t GetDispatchedCount() const noexcept;
+
+        /// <summary>
+        /// Number of packets dropped because the viewers did not keep up.
+        /// </summary>
+        uint64_t GetDroppedCount() const noexcept;
+
+        virtual ~DataViewerCollection() noexcept;
     private:
         MATSDK_LOG_DECL_COMPONENT_CLASS();
 
+        class DispatchQueue;
+
         mutable std::recursive_mutex m_dataViewerMapLock;
+        std::unique_ptr<DispatchQueue> m_dispatchQueue;
 
     protected:
         std::shared_ptr<IDataViewer> GetViewerFromCollection(const char* viewerName) const;
+        std::vector<std::shared_ptr<IDataViewer>> GetViewers() const;
         std::vector<std::shared_ptr<IDataViewer>> m_dataViewerCollection;
     };
 
@@ -4,6 +4,10 @@
 //
 #include "LogManagerFactory.hpp"
 #include "LogManagerImpl.hpp"
+#include "pal/WorkerPool.hpp"
+#ifdef HAVE_MAT_DEFAULT_HTTP_CLIENT
+#include "http/HttpClientFactory.hpp"
+#endif
 
 #include <cstdio>
 #include <cstdlib>
@@ -25,6 +29,57 @@ namespace MAT_NS_BEGIN
     std::recursive_mutex ILogManagerInternal::managers_lock;
     std::set<ILogManager*> ILogManagerInternal::managers;
 
+    static const size_t DEFAULT_SHARED_WORKER_THREADS = 2;
+
+    // Runtime shared by the instances created with CFG_BOOL_FACTORY_SHARED_RUNTIME,
+    // kept alive by the instances and configurations which use it
+    static std::weak_ptr<PAL::WorkerPool> sharedWorkerPool;
+#ifdef HAVE_MAT_DEFAULT_HTTP_CLIENT
+    static std::weak_ptr<IHttpClient> sharedHttpClient;
+#endif
+
+    /// <summary>
+    /// Gives the configuration a lane of the shared worker pool and the shared
+    /// HTTP client, unless it opts out or already has its own modules.
+    /// </summary>
+    static void attachSharedRuntime(ILogConfiguration& configuration)
+    {
+        if (!configuration.HasConfig(CFG_MAP_FACTORY_CONFIG))
+        {
+            return;
+        }
+        auto factoryConfig = configuration[CFG_MAP_FACTORY_CONFIG];
+        if ((factoryConfig.type != Variant::TYPE_OBJ) || !static_cast<bool>(factoryConfig[CFG_BOOL_FACTORY_SHARED_RUNTIME]))
+        {
+            return;
+        }
+
+        if (configuration.GetModule(CFG_MODULE_TASK_DISPATCHER) == nullptr)
+        {
+            auto pool = sharedWorkerPool.lock();
+            if (pool == nullptr)
+            {
+                int64_t threads = factoryConfig[CFG_INT_FACTORY_WORKER_THREADS];
+                pool = PAL::WorkerPool::Create((threads > 0) ? static_cast<size_t>(threads) : DEFAULT_SHARED_WORKER_THREADS);
+                sharedWorkerPool = pool;
+            }
+            configuration.AddModule(CFG_MODULE_TASK_DISPATCHER, pool->CreateLane());
+        }
+
+#ifdef HAVE_MAT_DEFAULT_HTTP_CLIENT
+        if (configuration.GetModule(CFG_MODULE_HTTP_CLIENT) == nullptr)
+        {
+            auto client = sharedHttpClient.lock();
+            if (client == nullptr)
+            {
+                client = HttpClientFactory::Create();
+                sharedHttpClient = client;
+            }
+            configuration.AddModule(CFG_MODULE_HTTP_CLIENT, client);
+        }
+#endif
+    }
+
     /// <summary>
     /// Creates an instance of ILogManager using specified configuration.
     /// </summary>
@@ -33,6 +88,7 @@ namespace MAT_NS_BEGIN
     ILogManager* LogManagerFactory::Create(ILogConfiguration& configuration)
     {
         LOCKGUARD(ILogManagerInternal::managers_lock);
+        attachSharedRuntime(configuration);
         auto logManager = new LogManagerImpl(configuration);
         ILogManagerInternal::managers.emplace(logManager);
         return logManager;
@@ -13,6 +13,7 @@
 #include "offline/OfflineStorageHandler.hpp"
 
 #include "system/TelemetrySystem.hpp"
+#include "bwcontrol/BandwidthController_Default.hpp"
 
 #include "EventProperty.hpp"
 #include "TransmitProfiles.hpp"
@@ -87,14 +88,13 @@
 
 namespace MAT_NS_BEGIN
 {
-    void DeadLoggers::AddMap(LoggerMap&& source)
+    void DeadLoggers::AddLoggers(std::vector<std::unique_ptr<Logger>>&& source)
     {
         std::lock_guard<std::mutex> lock(m_deadLoggersMutex);
         m_deadLoggers.reserve(m_deadLoggers.size() + source.size());
-        for (auto& kv : source)
+        for (auto& logger : source)
         {
-            m_deadLoggers.emplace_back(std::move(kv.second));
-            assert(!kv.second);
+            m_deadLoggers.emplace_back(std::move(logger));
         }
         source.clear();  // source is dead
     }
@@ -120,37 +120,60 @@ namespace MAT_NS_BEGIN
 #if 1
     // TODO: integrate Tracing API from v1
     // Meanwhile we'd set the g_logLevel using ILogConfiguration settings
-    static void setLogLevel(ILogConfiguration& configuration)
+    static PAL::LogLevel toLogLevel(uint32_t traceLevel)
     {
-        uint32_t minTraceLevel = configuration[CFG_INT_TRACE_LEVEL_MIN];
-
-        switch (minTraceLevel)
+        switch (traceLevel)
         {
         case ACTTraceLevel_Debug:
-            PAL::detail::g_logLevel = PAL::LogLevel::Detail;
-            break;
+            return PAL::LogLevel::Detail;
         case ACTTraceLevel_Trace:
-            PAL::detail::g_logLevel = PAL::LogLevel::Detail;
-            break;
+            return PAL::LogLevel::Detail;
         case ACTTraceLevel_Info:
-            PAL::detail::g_logLevel = PAL::LogLevel::Info;
-            break;
+            return PAL::LogLevel::Info;
         case ACTTraceLevel_Warn:
-            PAL::detail::g_logLevel = PAL::LogLevel::Warning;
-            break;
+            return PAL::LogLevel::Warning;
         case ACTTraceLevel_Error:
-            PAL::detail::g_logLevel = PAL::LogLevel::Error;
-            break;
+            return PAL::LogLevel::Error;
         case ACTTraceLevel_Fatal:
-            PAL::detail::g_logLevel = PAL::LogLevel::Error;
-            break;
+            return PAL::LogLevel::Error;
         default:
-            PAL::detail::g_logLevel = PAL::LogLevel::Warning;
-            break;
+            return PAL::LogLevel::Warning;
+        }
+    }
+
+    static void setLogLevel(ILogConfiguration& configuration)
+    {
+        uint32_t minTraceLevel = configuration[CFG_INT_TRACE_LEVEL_MIN];
+        PAL::detail::g_logLevel = toLogLevel(minTraceLevel);
+
+        if (configuration.HasConfig(CFG_MAP_TRACE_COMPONENT_LEVELS))
+        {
+            Variant& componentLevels = configuration[CFG_MAP_TRACE_COMPONENT_LEVELS];
+            if (componentLevels.type == Variant::TYPE_OBJ)
+            {
+                for (auto& kv : static_cast<VariantMap&>(componentLevels))
+                {
+                    uint32_t componentTraceLevel = static_cast<uint32_t>(static_cast<int64_t>(kv.second));
+                    if (!PAL::setComponentLogLevel(kv.first.c_str(), toLogLevel(componentTraceLevel)))
+                    {
+                        LOG_WARN("Trace level of component %s not set", kv.first.c_str());
+                    }
+                }
+            }
         }
     }
 #endif
 
+    static size_t dataInspectorThreads(ILogConfiguration& configuration)
+    {
+        if (!configuration.HasConfig(CFG_INT_DATA_INSPECTOR_THREADS))
+        {
+            return 0;
+        }
+        int64_t threads = configuration[CFG_INT_DATA_INSPECTOR_THREADS];
+        return (threads > 0) ? static_cast<size_t>(threads) : 0;
+    }
+
     DeadLoggers LogManagerImpl::s_deadLoggers;
 
     LogManagerImpl::LogManagerImpl(ILogConfiguration& configuration) :
@@ -161,7 +184,8 @@ namespace MAT_NS_BEGIN
     LogManagerImpl::LogManagerImpl(ILogConfiguration& configuration, bool deferSystemStart) :
         m_logConfiguration(configuration),
         m_bandwidthController(nullptr),
-        m_offlineStorage(nullptr)
+        m_offlineStorage(nullptr),
+        m_dataInspectors(dataInspectorThreads(configuration))
     {
         m_httpClient = std::static_pointer_cast<IHttpClient>(configuration.GetModule(CFG_MODULE_HTTP_CLIENT));
         m_taskDispatcher = std::static_pointer_cast<ITaskDispatcher>(configuration.GetModule(CFG_MODULE_TASK_DISPATCHER));
@@ -298,6 +322,11 @@ namespace MAT_NS_BEGIN
 
         if (m_bandwidthController == nullptr)
         {
+            uint32_t bandwidthShare = static_cast<uint32_t>((*m_config)[CFG_MAP_TPM][CFG_INT_TPM_BANDWIDTH_SHARE]);
+            if (bandwidthShare > 0)
+            {
+                m_ownBandwidthController.reset(new BandwidthController_Default(bandwidthShare));
+            }
             m_bandwidthController = m_ownBandwidthController.get();
         }
         else
@@ -385,7 +414,7 @@ namespace MAT_NS_BEGIN
         {
             if (m_logConfiguration[CFG_BOOL_DISABLE_ZOMBIE_LOGGERS])
             {
-                m_loggers.clear();
+                m_loggers.Release();
             }
             else
             {
@@ -396,16 +425,14 @@ namespace MAT_NS_BEGIN
                 // and well and ILogger methods should work. After that
                 // RecordShutdown(), those ILogger methods do nothing and in
                 // particular do not touch this now-defunct LogManagerImpl.
-                for (auto& kv : m_loggers)
+                auto loggers = m_loggers.Release();
+                for (auto& logger : loggers)
                 {
                     // this waits until no active calls on this logger
-                    kv.second->RecordShutdown();
+                    logger->RecordShutdown();
                 }
 
-                s_deadLoggers.AddMap(std::move(m_loggers));
-
-                // Ensure that AddMap clears m_loggers (it does, it should continue to).
-                assert(m_loggers.empty());
+                s_deadLoggers.AddLoggers(std::move(loggers));
             }
 
             LOG_INFO("Tearing down modules");
@@ -546,13 +573,7 @@ namespace MAT_NS_BEGIN
         LOG_TRACE("SetContext(\"%s\", ..., %u)", name.c_str(), piiKind);
         EventProperty prop(value, piiKind);
         m_context.SetCustomField(name, prop);
-        {
-            LOCKGUARD(m_dataInspectorGuard);
-            for(const auto& dataInspector : m_dataInspectors)
-            {
-                dataInspector->InspectSemanticContext(name, value, /*isGlobalContext: */ true, std::string{});
-            }
-        }
+        m_dataInspectors.InspectSemanticContext(name, value, /*isGlobalContext: */ true, std::string{});
         return STATUS_SUCCESS;
     }
 
@@ -624,13 +645,7 @@ namespace MAT_NS_BEGIN
         EventProperty prop(value, piiKind);
         m_context.SetCustomField(name, prop);
         m_context.SetCustomField(name, prop);
-        {
-            LOCKGUARD(m_dataInspectorGuard);
-            for(const auto& dataInspector : m_dataInspectors)
-            {
-                dataInspector->InspectSemanticContext(name, value, /*isGlobalContext: */ true, std::string{});
-            }
-        }
+        m_dataInspectors.InspectSemanticContext(name, value, /*isGlobalContext: */ true, std::string{});
         return STATUS_SUCCESS;
     }
 
@@ -644,38 +659,32 @@ namespace MAT_NS_BEGIN
 
     ILogger* LogManagerImpl::GetLogger(const std::string& tenantToken, const std::string& source, const std::string& scope)
     {
+        // Existing loggers are found without locking, they stay registered until teardown
+        Logger* logger = m_loggers.Find(tenantToken, source);
+        if (logger == nullptr)
         {
             LOCKGUARD(m_lock);
             if (!m_alive)
             {
                 return nullptr;
             }
+            LOG_TRACE("GetLogger(tenantId=\"%.*s\", source=\"%s\")", MATSDK_TENANT_ID_ARGS(tenantToken), source.c_str());
+            logger = m_loggers.FindOrAdd(tenantToken, source,
+                [this, &scope](std::string const& normalizedTenantToken, std::string const& normalizedSource) {
+                    return std::unique_ptr<Logger>(new Logger(normalizedTenantToken, normalizedSource, scope, *this, m_context, *m_config));
+                });
+            if (logger == nullptr)
+            {
+                return nullptr;
+            }
         }
-        //
-        LOG_TRACE("GetLogger(tenantId=\"%s\", source=\"%s\")", tenantTokenToId(tenantToken).c_str(), source.c_str());
 
-        std::string normalizedTenantToken = toLower(tenantToken);
-        std::string normalizedSource = toLower(source);
-        std::string hash = normalizedTenantToken + "/" + normalizedSource;
-
-        LOCKGUARD(m_lock);
-        if (!m_alive)
-        {
-            return nullptr;
-        }
-        auto it = m_loggers.find(hash);
-        if (it == std::end(m_loggers))
-        {
-            m_loggers[hash] = std::make_unique<Logger>(
-                normalizedTenantToken, normalizedSource, scope,
-                *this, m_context, *m_config);
-        }
         uint8_t level = m_diagLevelFilter.GetDefaultLevel();
         if (level != DIAG_LEVEL_DEFAULT)
         {
-            m_loggers[hash]->SetLevel(level);
+            logger->SetLevel(level);
         }
-        return m_loggers[hash].get();
+        return logger;
     }
 
     /// <summary>
@@ -722,7 +731,7 @@ namespace MAT_NS_BEGIN
 
     void LogManagerImpl::sendEvent(IncomingEventContextPtr const& event)
     {
-        LOCKGUARD(m_lock);
+        std::unique_lock<std::recursive_mutex> lock(m_lock);
         if (GetSystem())
         {
             if (m_customDecorator)
@@ -730,18 +739,48 @@ namespace MAT_NS_BEGIN
                 m_customDecorator->decorate(*(event->source));
             }
 
+            if (!m_dataInspectors.IsEmpty())
             {
-                LOCKGUARD(m_dataInspectorGuard);
-
-                for (const auto& dataInspector : m_dataInspectors)
+                // Inspectors may be slow, other threads keep logging meanwhile
+                lock.unlock();
+                m_dataInspectors.InspectRecord(*(event->source));
+                lock.lock();
+                if (!GetSystem())
                 {
-                    dataInspector->InspectRecord(*(event->source));
+                    return;
                 }
             }
             GetSystem()->sendEvent(event);
         }
     }
 
+    void LogManagerImpl::sendEvents(std::vector<IncomingEventContextPtr> const& events)
+    {
+        std::unique_lock<std::recursive_mutex> lock(m_lock);
+        if (GetSystem())
+        {
+            if (m_customDecorator)
+            {
+                for (const auto& event : events)
+                {
+                    m_customDecorator->decorate(*(event->source));
+                }
+            }
+
+            if (!m_dataInspectors.IsEmpty())
+            {
+                lock.unlock();
+                m_dataInspectors.InspectRecords(events);
+                lock.lock();
+                if (!GetSystem())
+                {
+                    return;
+                }
+            }
+            GetSystem()->sendEvents(events);
+        }
+    }
+
     ILogController* LogManagerImpl::GetLogController()
     {
         return this;
@@ -829,54 +868,31 @@ namespace MAT_NS_BEGIN
 
     void LogManagerImpl::SetDataInspector(const std::shared_ptr<IDataInspector>& dataInspector)
     {
-        LOCKGUARD(m_dataInspectorGuard);
         if(dataInspector == nullptr)
         {
             LOG_WARN("Attempting to set nullptr as DataInspector");
             return;
         }
 
-        auto itDataInspector = std::find_if(m_dataInspectors.begin(), m_dataInspectors.end(), [&dataInspector](const std::shared_ptr<IDataInspector>& currentInspector)
-        {
-            return strcmp(dataInspector->GetName(), currentInspector->GetName()) == 0;
-        });
-
-        if (itDataInspector != m_dataInspectors.end())
+        if (m_dataInspectors.Set(dataInspector))
         {
             LOG_WARN("Replacing specified IDataInspector with passed in inspector");
-            m_dataInspectors.erase(itDataInspector);
         }
-
-        m_dataInspectors.push_back(dataInspector);
     }
 
     void LogManagerImpl::ClearDataInspectors()
     {
-        LOCKGUARD(m_dataInspectorGuard);
-        std::vector<std::shared_ptr<IDataInspector>>{}.swap(m_dataInspectors);
+        m_dataInspectors.Clear();
     }
 
     void LogManagerImpl::RemoveDataInspector(const std::string& name)
     {
-        LOCKGUARD(m_dataInspectorGuard);
-        auto itDataInspector = std::find_if(m_dataInspectors.begin(), m_dataInspectors.end(), [&name](const std::shared_ptr<IDataInspector>& inspector){
-            return strcmp(inspector->GetName(), name.c_str()) == 0;
-        });
-
-        if (itDataInspector != m_dataInspectors.end())
-        {
-            m_dataInspectors.erase(itDataInspector);
-        }
+        m_dataInspectors.Remove(name);
     }
 
     std::shared_ptr<IDataInspector> LogManagerImpl::GetDataInspector(const std::string& name) noexcept
     {
-        LOCKGUARD(m_dataInspectorGuard);
-        auto it = std::find_if(m_dataInspectors.begin(), m_dataInspectors.end(), [&name](const std::shared_ptr<IDataInspector>& inspector){
-            return strcmp(inspector->GetName(), name.c_str()) == 0;
-        });
-
-        return it != m_dataInspectors.end() ? *it : nullptr;
+        return m_dataInspectors.Get(name);
     }
 
     status_t LogManagerImpl::DeleteData()
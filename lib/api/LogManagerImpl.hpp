@@ -18,6 +18,7 @@
 
 #include "api/ContextFieldsProvider.hpp"
 #include "api/Logger.hpp"
+#include "api/LoggerRegistry.hpp"
 
 #include "DebugEvents.hpp"
 #include <memory>
@@ -25,6 +26,7 @@
 #include "IBandwidthController.hpp"
 #include "api/AuthTokensController.hpp"
 #include "api/DataViewerCollection.hpp"
+#include "api/DataInspectorCollection.hpp"
 #include "filter/EventFilterCollection.hpp"
 
 #include "AllowedLevelsCollection.hpp"
@@ -123,18 +125,17 @@ namespace MAT_NS_BEGIN
         std::shared_ptr<IDecoratorModule> m_customDecorator;
 
         virtual void sendEvent(IncomingEventContextPtr const& event) = 0;
+        virtual void sendEvents(std::vector<IncomingEventContextPtr> const& events) = 0;
         virtual const ContextFieldsProvider& GetContext() = 0;
         virtual const DiagLevelFilter& GetLevelFilter() = 0;
     };
 
     class Logger;
 
-    using LoggerMap = std::map<std::string, std::unique_ptr<Logger>>;
-
     class DeadLoggers
     {
        public:
-        void AddMap(LoggerMap&& source);
+        void AddLoggers(std::vector<std::unique_ptr<Logger>>&& source);
         size_t GetDeadLoggerCount() const noexcept;
 
         std::vector<std::unique_ptr<Logger>> m_deadLoggers;
@@ -273,6 +274,12 @@ namespace MAT_NS_BEGIN
         /// <param name="event">The event.</param>
         virtual void sendEvent(IncomingEventContextPtr const& event) override;
 
+        /// <summary>
+        /// Adds a batch of incoming events under a single lock acquisition.
+        /// </summary>
+        /// <param name="events">The events.</param>
+        virtual void sendEvents(std::vector<IncomingEventContextPtr> const& events) override;
+
         void SetLevelFilter(uint8_t defaultLevel, uint8_t levelMin, uint8_t levelMax) override;
 
         void SetLevelFilter(uint8_t defaultLevel, const std::set<uint8_t>& allowedLevels) override;
@@ -317,7 +324,7 @@ namespace MAT_NS_BEGIN
 
         static DeadLoggers s_deadLoggers;
         std::recursive_mutex m_lock;
-        LoggerMap m_loggers;
+        LoggerRegistry m_loggers;
         ContextFieldsProvider m_context;
 
         std::shared_ptr<IHttpClient> m_httpClient;
@@ -345,8 +352,7 @@ namespace MAT_NS_BEGIN
         EventFilterCollection m_filters;
         std::vector<std::unique_ptr<IModule>> m_modules;
         DataViewerCollection m_dataViewerCollection;
-        std::vector<std::shared_ptr<IDataInspector>> m_dataInspectors;
-        std::recursive_mutex m_dataInspectorGuard;
+        DataInspectorCollection m_dataInspectors;
 
         std::mutex m_pause_mutex;
         std::condition_variable m_pause_cv;
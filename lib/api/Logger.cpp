@@ -334,6 +334,80 @@ namespace MAT_NS_BEGIN
         DispatchEvent(DebugEvent(DebugEventType::EVT_LOG_EVENT, size_t(latency), size_t(0), static_cast<void*>(&record), sizeof(record)));
     }
 
+    /// <summary>
+    /// Logs a batch of events.
+    /// </summary>
+    /// <param name="events">The properties of each event.</param>
+    void Logger::LogEvents(std::vector<EventProperties> const& events)
+    {
+        ActiveLoggerCall active(*this);
+        if (active.LoggerIsDead())
+        {
+            return;
+        }
+
+        LOG_TRACE("%p: LogEvents(count=%zu, ...)", this, events.size());
+
+        // Records and contexts must not be reallocated once a context
+        // points at its record, hence both vectors are sized up-front.
+        std::vector<::CsProtocol::Record> records(events.size());
+        std::vector<EventLatency> latencies(events.size(), EventLatency_Normal);
+        std::vector<IncomingEventContext> contexts;
+        contexts.reserve(events.size());
+        std::vector<size_t> submitted;
+        submitted.reserve(events.size());
+
+        for (size_t i = 0; i < events.size(); i++)
+        {
+            EventProperties const& properties = events[i];
+            if (!CanEventPropertiesBeSent(properties))
+            {
+                DispatchEvent(DebugEventType::EVT_FILTERED);
+                continue;
+            }
+
+            if (properties.GetLatency() > EventLatency_Unspecified)
+            {
+                latencies[i] = properties.GetLatency();
+            }
+
+            ::CsProtocol::Record& record = records[i];
+            if (!applyCommonDecorators(record, properties, latencies[i]))
+            {
+                LOG_ERROR("Failed to log %s event %s/%s: invalid arguments provided",
+                          "custom",
+                          tenantTokenToId(m_tenantToken).c_str(),
+                          properties.GetName().empty() ? "<unnamed>" : properties.GetName().c_str());
+                continue;
+            }
+
+            submitted.push_back(i);
+            if (!canSubmit(record, properties))
+            {
+                continue;
+            }
+
+            contexts.emplace_back(PAL::generateRecordId(), m_tenantToken, properties.GetLatency(), properties.GetPersistence(), &record);
+            contexts.back().policyBitFlags = properties.GetPolicyBitFlags();
+        }
+
+        if (!contexts.empty())
+        {
+            std::vector<IncomingEventContextPtr> batch;
+            batch.reserve(contexts.size());
+            for (auto& context : contexts)
+            {
+                batch.push_back(&context);
+            }
+            m_logManager.sendEvents(batch);
+        }
+
+        for (size_t i : submitted)
+        {
+            DispatchEvent(DebugEvent(DebugEventType::EVT_LOG_EVENT, size_t(latencies[i]), size_t(0), static_cast<void*>(&records[i]), sizeof(records[i])));
+        }
+    }
+
     /// <summary>
     /// Logs a failure event - such as an application exception.
     /// </summary>
@@ -536,8 +610,25 @@ namespace MAT_NS_BEGIN
             return;
         }
 
-        const auto policyBitFlags = props.GetPolicyBitFlags();
-        const auto persistence = props.GetPersistence();
+        if (!canSubmit(record, props))
+        {
+            return;
+        }
+
+        IncomingEventContext event(PAL::generateRecordId(), m_tenantToken, props.GetLatency(), props.GetPersistence(), &record);
+        event.policyBitFlags = props.GetPolicyBitFlags();
+
+        m_logManager.sendEvent(&event);
+    }
+
+    /// <summary>
+    /// Applies the diagnostic level filter and latency policy to a decorated record.
+    /// </summary>
+    /// <param name="record">The record.</param>
+    /// <param name="props">The properties.</param>
+    /// <returns>true if the record should be passed to the log manager, false if it was filtered or dropped</returns>
+    bool Logger::canSubmit(::CsProtocol::Record const& record, const EventProperties& props)
+    {
         const auto latency = props.GetLatency();
         auto levelFilter = m_logManager.GetLevelFilter();
         if (levelFilter.IsLevelFilterEnabled())
@@ -553,7 +644,7 @@ namespace MAT_NS_BEGIN
             // then prefer to drop. This is user error: user set the range
             // restrition, but didn't specify the defaults.
             //
-            uint8_t level = (it != m_props.cend()) ? static_cast<uint8_t>(it->second.as_int64) : m_level;
+            uint8_t level = (it != m_props.cend()) ? static_cast<uint8_t>(it->second.as_int64) : m_level.load();
             if (level == DIAG_LEVEL_DEFAULT)
             {
                 level = levelFilter.GetDefaultLevel();
@@ -563,13 +654,13 @@ namespace MAT_NS_BEGIN
                     LOG_INFO("Event %s/%s dropped: no diagnostic level assigned!",
                              tenantTokenToId(m_tenantToken).c_str(), record.baseType.c_str());
                     DispatchEvent(DebugEventType::EVT_FILTERED);
-                    return;
+                    return false;
                 }
             }
             if (!levelFilter.IsLevelEnabled(level))
             {
                 DispatchEvent(DebugEventType::EVT_FILTERED);
-                return;
+                return false;
             }
         }
 
@@ -578,14 +669,10 @@ namespace MAT_NS_BEGIN
             DispatchEvent(DebugEventType::EVT_DROPPED);
             LOG_INFO("Event %s/%s dropped: calculated latency 0 (Off)",
                      tenantTokenToId(m_tenantToken).c_str(), record.baseType.c_str());
-            return;
+            return false;
         }
 
-        // TODO: [MG] - check if optimization is possible in generateUuidString
-        IncomingEventContext event(PAL::generateUuidString(), m_tenantToken, latency, persistence, &record);
-        event.policyBitFlags = policyBitFlags;
-
-        m_logManager.sendEvent(&event);
+        return true;
     }
 
     void Logger::onSubmitted()
@@ -24,6 +24,8 @@
 
 #include "filter/EventFilterCollection.hpp"
 
+#include <atomic>
+
 namespace MAT_NS_BEGIN
 {
     class BaseDecorator;
@@ -142,6 +144,8 @@ namespace MAT_NS_BEGIN
 
         virtual void LogEvent(EventProperties const& properties) override;
 
+        virtual void LogEvents(std::vector<EventProperties> const& events) override;
+
         virtual void LogFailure(std::string const& signature,
                                 std::string const& detail,
                                 std::string const& category,
@@ -234,6 +238,9 @@ namespace MAT_NS_BEGIN
         virtual void
         submit(::CsProtocol::Record& record, const EventProperties& props);
 
+        bool
+        canSubmit(::CsProtocol::Record const& record, const EventProperties& props);
+
         bool
         CanEventPropertiesBeSent(EventProperties const& properties) const noexcept;
 
@@ -248,7 +255,7 @@ namespace MAT_NS_BEGIN
         // "*"      - allows C API caller to attach their guest ILogger to parent's Host global context
         // "<id>"   - allows to rewire this ILogger to alternate semantic context
         std::string m_scope;
-        uint8_t m_level;
+        std::atomic<uint8_t> m_level;
 
         ILogManagerInternal& m_logManager;
         ContextFieldsProvider m_context;
@@ -0,0 +1,143 @@
+//
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// SPDX-License-Identifier: Apache-2.0
+//
+#include "LoggerRegistry.hpp"
+#include "api/Logger.hpp"
+#include "utils/StringUtils.hpp"
+
+namespace MAT_NS_BEGIN
+{
+
+    namespace
+    {
+        // ASCII only, toLower() would look up the locale for every character
+        inline unsigned char lowercase(char c) noexcept
+        {
+            unsigned char u = static_cast<unsigned char>(c);
+            return (u >= 'A' && u <= 'Z') ? static_cast<unsigned char>(u + ('a' - 'A')) : u;
+        }
+
+        std::string lowercaseCopy(std::string const& str)
+        {
+            std::string result(str);
+            for (char& c : result)
+            {
+                c = static_cast<char>(lowercase(c));
+            }
+            return result;
+        }
+    }
+
+    LoggerRegistry::LoggerRegistry() noexcept :
+        m_released(false)
+    {
+        for (auto& bucket : m_buckets)
+        {
+            bucket.store(nullptr, std::memory_order_relaxed);
+        }
+    }
+
+    LoggerRegistry::~LoggerRegistry() noexcept = default;
+
+    uint64_t LoggerRegistry::hashOf(std::string const& tenantToken, std::string const& source) noexcept
+    {
+        // FNV-1a of "<token>/<source>" in lowercase
+        uint64_t hash = 14695981039346656037ull;
+        for (char c : tenantToken)
+        {
+            hash = (hash ^ lowercase(c)) * 1099511628211ull;
+        }
+        hash = (hash ^ static_cast<unsigned char>('/')) * 1099511628211ull;
+        for (char c : source)
+        {
+            hash = (hash ^ lowercase(c)) * 1099511628211ull;
+        }
+        return hash;
+    }
+
+    bool LoggerRegistry::equalsLowercase(std::string const& str, std::string const& lowercaseStr) noexcept
+    {
+        if (str.size() != lowercaseStr.size())
+        {
+            return false;
+        }
+        for (size_t i = 0; i < str.size(); i++)
+        {
+            if (lowercase(str[i]) != static_cast<unsigned char>(lowercaseStr[i]))
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    LoggerRegistry::Entry const* LoggerRegistry::findEntry(uint64_t hash, std::string const& tenantToken, std::string const& source) const noexcept
+    {
+        for (Entry const* entry = m_buckets[hash % BucketCount].load(std::memory_order_acquire); entry != nullptr; entry = entry->next)
+        {
+            if (entry->hash == hash && equalsLowercase(tenantToken, entry->tenantToken) && equalsLowercase(source, entry->source))
+            {
+                return entry;
+            }
+        }
+        return nullptr;
+    }
+
+    Logger* LoggerRegistry::Find(std::string const& tenantToken, std::string const& source) const noexcept
+    {
+        if (m_released.load(std::memory_order_acquire))
+        {
+            return nullptr;
+        }
+        Entry const* entry = findEntry(hashOf(tenantToken, source), tenantToken, source);
+        return (entry != nullptr) ? entry->logger : nullptr;
+    }
+
+    Logger* LoggerRegistry::FindOrAdd(std::string const& tenantToken, std::string const& source, LoggerFactory const& create)
+    {
+        uint64_t hash = hashOf(tenantToken, source);
+        std::lock_guard<std::mutex> lock(m_writeLock);
+        if (m_released.load(std::memory_order_relaxed))
+        {
+            return nullptr;
+        }
+
+        // Another thread may have added it since the caller's lookup
+        Entry const* existing = findEntry(hash, tenantToken, source);
+        if (existing != nullptr)
+        {
+            return existing->logger;
+        }
+
+        std::unique_ptr<Entry> entry(new Entry { hash, lowercaseCopy(tenantToken), lowercaseCopy(source), nullptr, nullptr });
+        std::unique_ptr<Logger> logger = create(toLower(tenantToken), toLower(source));
+        entry->logger = logger.get();
+        std::atomic<Entry*>& bucket = m_buckets[hash % BucketCount];
+        entry->next = bucket.load(std::memory_order_relaxed);
+
+        // Owned before published, readers must never see an entry that could still go away
+        Entry* published = entry.get();
+        m_loggers.push_back(std::move(logger));
+        m_entries.push_back(std::move(entry));
+        bucket.store(published, std::memory_order_release);
+        return published->logger;
+    }
+
+    std::vector<std::unique_ptr<Logger>> LoggerRegistry::Release()
+    {
+        std::lock_guard<std::mutex> lock(m_writeLock);
+        m_released.store(true, std::memory_order_release);
+        // Entries stay, a concurrent lookup may still be walking them
+        std::vector<std::unique_ptr<Logger>> loggers;
+        loggers.swap(m_loggers);
+        return loggers;
+    }
+
+    size_t LoggerRegistry::GetSize() const
+    {
+        std::lock_guard<std::mutex> lock(m_writeLock);
+        return m_loggers.size();
+    }
+
+} MAT_NS_END
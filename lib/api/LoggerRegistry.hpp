@@ -0,0 +1,85 @@
+//
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// SPDX-License-Identifier: Apache-2.0
+//
+#ifndef LOGGERREGISTRY_HPP
+#define LOGGERREGISTRY_HPP
+
+#include "ctmacros.hpp"
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace MAT_NS_BEGIN
+{
+
+    class Logger;
+
+    /// <summary>
+    /// Loggers of a LogManager, keyed by case-insensitive tenant token and source.
+    /// Loggers are only ever added until Release() hands all of them over, so an
+    /// existing logger is found without taking a lock or allocating memory.
+    /// </summary>
+    class LoggerRegistry
+    {
+    public:
+        using LoggerFactory = std::function<std::unique_ptr<Logger>(std::string const& normalizedTenantToken, std::string const& normalizedSource)>;
+
+        LoggerRegistry() noexcept;
+        ~LoggerRegistry() noexcept;
+
+        LoggerRegistry(LoggerRegistry const&) = delete;
+        LoggerRegistry& operator=(LoggerRegistry const&) = delete;
+
+        /// <summary>
+        /// Returns the logger of a tenant token and source, nullptr if there is none or the loggers were released
+        /// </summary>
+        Logger* Find(std::string const& tenantToken, std::string const& source) const noexcept;
+
+        /// <summary>
+        /// Returns the logger of a tenant token and source, creating it with toLower() of the token
+        /// and source if there is none yet. Returns nullptr once the loggers were released.
+        /// </summary>
+        Logger* FindOrAdd(std::string const& tenantToken, std::string const& source, LoggerFactory const& create);
+
+        /// <summary>
+        /// Hands over all loggers, lookups find nothing afterwards
+        /// </summary>
+        std::vector<std::unique_ptr<Logger>> Release();
+
+        size_t GetSize() const;
+
+    protected:
+        struct Entry
+        {
+            uint64_t    hash;
+            std::string tenantToken;  // ASCII lowercase
+            std::string source;       // ASCII lowercase
+            Logger*     logger;
+            Entry*      next;
+        };
+
+        static uint64_t hashOf(std::string const& tenantToken, std::string const& source) noexcept;
+        static bool equalsLowercase(std::string const& str, std::string const& lowercase) noexcept;
+        Entry const* findEntry(uint64_t hash, std::string const& tenantToken, std::string const& source) const noexcept;
+
+        static constexpr size_t BucketCount = 128;
+
+        // Entries are published with a release store of the bucket head and
+        // never change or go away afterwards, until the registry is destroyed
+        std::atomic<Entry*>                  m_buckets[BucketCount];
+        std::atomic<bool>                    m_released;
+
+        mutable std::mutex                   m_writeLock;
+        std::vector<std::unique_ptr<Entry>>  m_entries;
+        std::vector<std::unique_ptr<Logger>> m_loggers;
+    };
+
+} MAT_NS_END
+
+#endif // LOGGERREGISTRY_HPP
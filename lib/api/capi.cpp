@@ -20,6 +20,8 @@
 #include <mutex>
 #include <map>
 #include <cstdint>
+#include <iterator>
+#include <vector>
 
 static const char * libSemver = TELEMETRY_EVENTS_VERSION;
 
@@ -28,6 +30,18 @@ using namespace MAT;
 static std::mutex mtx;
 static std::map<evt_handle_t, capi_client> clients;
 
+/// <summary>
+/// Logger resolved once with EVT_OP_GET_LOGGER, owned by the client it was obtained from
+/// </summary>
+struct capi_logger
+{
+    evt_handle_t client;
+    ILogger*     logger;
+};
+
+static evt_handle_t lastLoggerHandle = 0;
+static std::map<evt_handle_t, capi_logger> loggers;
+
 /// <summary>
 /// Convert from C API handle to internal C API client struct.
 ///
@@ -53,6 +67,10 @@ void remove_client(evt_handle_t handle)
 {
     LOCKGUARD(mtx);
     clients.erase(handle);
+    for (auto it = loggers.begin(); it != loggers.end();)
+    {
+        it = (it->second.client == handle) ? loggers.erase(it) : std::next(it);
+    }
 }
 
 #define VERIFY_CLIENT_HANDLE(client, ctx)                       \
@@ -231,22 +249,10 @@ evt_status_t mat_open_with_params(evt_context_t *ctx)
 }
 
 /**
- * Marashal C struct to C++ API
+ * Logger scope of a C API client
  */
-evt_status_t mat_log(evt_context_t *ctx)
+static std::string mat_get_scope(capi_client* client)
 {
-    VERIFY_CLIENT_HANDLE(client, ctx);
-
-    ILogConfiguration & config = client->config;
-    const evt_prop *evt = static_cast<evt_prop*>(ctx->data);
-    EventProperties props;
-    props.unpack(evt, ctx->size);
-
-    auto m = props.GetProperties();
-    EventProperty &prop = m[COMMONFIELDS_IKEY];
-    std::string token = prop.as_string;
-    props.erase(COMMONFIELDS_IKEY);
-
     // Privacy feature for OTEL C API client:
     //
     // C API customer that does not explicitly pass down JSON
@@ -254,37 +260,189 @@ evt_status_t mat_log(evt_context_t *ctx)
     //
     // should not be able to capture the host's context vars.
     std::string scope = CONTEXT_SCOPE_NONE;
+    MAT::VariantMap &config_map = client->config[CFG_MAP_FACTORY_CONFIG];
+    const auto & it = config_map.find(CFG_STR_CONTEXT_SCOPE);
+    if (it != config_map.cend())
     {
-        MAT::VariantMap &config_map = config[CFG_MAP_FACTORY_CONFIG];
-        const auto & it = config_map.find(CFG_STR_CONTEXT_SCOPE);
-        if (it != config_map.cend())
+        scope = static_cast<const char *>(it->second);
+        // Specifying "*" in JSON config allows Guest C API logger to capture Host context variables
+        if (scope == CONTEXT_SCOPE_ALL)
         {
-            scope = static_cast<const char *>(it->second);
-            // Specifying "*" in JSON config allows Guest C API logger to capture Host context variables
-            if (scope == CONTEXT_SCOPE_ALL)
-            {
-                scope = CONTEXT_SCOPE_EMPTY;
-            }
+            scope = CONTEXT_SCOPE_EMPTY;
         }
     }
+    return scope;
+}
 
-    const auto & it = m.find(COMMONFIELDS_EVENT_SOURCE);
-    std::string source = ((it != m.cend()) && (it->second.type == EventProperty::TYPE_STRING)) ? it->second.as_string : "";
+/**
+ * Resolve the logger for C API event: consumes iKey and source from event properties
+ */
+static ILogger* mat_get_logger(capi_client* client, EventProperties& props)
+{
+    std::string token;
+    std::string source;
+    {
+        const auto & m = props.GetProperties();
+        auto it = m.find(COMMONFIELDS_IKEY);
+        if ((it != m.cend()) && (it->second.type == EventProperty::TYPE_STRING))
+        {
+            token = it->second.as_string;
+        }
+        it = m.find(COMMONFIELDS_EVENT_SOURCE);
+        if ((it != m.cend()) && (it->second.type == EventProperty::TYPE_STRING))
+        {
+            source = it->second.as_string;
+        }
+    }
+    props.erase(COMMONFIELDS_IKEY);
 
-    ILogger *logger = client->logmanager->GetLogger(token, source, scope);
+    ILogger *logger = client->logmanager->GetLogger(token, source, mat_get_scope(client));
+    if (logger != nullptr)
+    {
+        logger->SetParentContext(nullptr);
+    }
+    return logger;
+}
+
+/**
+ * Marashal C struct to C++ API
+ */
+evt_status_t mat_log(evt_context_t *ctx)
+{
+    VERIFY_CLIENT_HANDLE(client, ctx);
+
+    const evt_prop *evt = static_cast<evt_prop*>(ctx->data);
+    EventProperties props;
+    props.unpack(evt, ctx->size);
+
+    ILogger *logger = mat_get_logger(client, props);
     if (logger == nullptr)
     {
         ctx->result = EFAULT; /* invalid address */
     }
     else
     {
-        logger->SetParentContext(nullptr);
         logger->LogEvent(props);
         ctx->result = EOK;
     }
     return ctx->result;
 }
 
+/**
+ * Marshal a batch of C structs to C++ API. Consecutive events that resolve
+ * to the same logger are passed down with a single ILogger::LogEvents call.
+ */
+evt_status_t mat_log_batch(evt_context_t *ctx)
+{
+    VERIFY_CLIENT_HANDLE(client, ctx);
+
+    evt_prop **evts = static_cast<evt_prop**>(ctx->data);
+    if ((evts == nullptr) && (ctx->size != 0))
+    {
+        ctx->result = EFAULT; /* bad address */
+        return ctx->result;
+    }
+
+    ctx->result = EOK;
+    ILogger *batchLogger = nullptr;
+    std::vector<EventProperties> batch;
+    batch.reserve(ctx->size);
+    for (uint32_t i = 0; i < ctx->size; i++)
+    {
+        EventProperties props;
+        props.unpack(evts[i], 0);
+
+        ILogger *logger = mat_get_logger(client, props);
+        if (logger == nullptr)
+        {
+            ctx->result = EFAULT; /* invalid address */
+            continue;
+        }
+
+        if ((logger != batchLogger) && (!batch.empty()))
+        {
+            batchLogger->LogEvents(batch);
+            batch.clear();
+        }
+        batchLogger = logger;
+        batch.push_back(std::move(props));
+    }
+
+    if (!batch.empty())
+    {
+        batchLogger->LogEvents(batch);
+    }
+    return ctx->result;
+}
+
+/**
+ * Resolve a logger once and hand out a handle to it, so that events logged
+ * with EVT_OP_LOG_WITH_LOGGER skip the per-event logger lookup
+ */
+evt_status_t mat_get_logger_handle(evt_context_t *ctx)
+{
+    VERIFY_CLIENT_HANDLE(client, ctx);
+
+    const evt_get_logger_data_t* data = static_cast<evt_get_logger_data_t*>(ctx->data);
+    if ((data == nullptr) || (data->token == nullptr))
+    {
+        ctx->result = EFAULT; /* bad address */
+        return ctx->result;
+    }
+
+    ILogger *logger = client->logmanager->GetLogger(data->token, (data->source != nullptr) ? data->source : "", mat_get_scope(client));
+    if (logger == nullptr)
+    {
+        ctx->result = EFAULT; /* invalid address */
+        return ctx->result;
+    }
+    logger->SetParentContext(nullptr);
+
+    {
+        LOCKGUARD(mtx);
+        evt_handle_t code = ++lastLoggerHandle;
+        loggers[code] = { ctx->handle, logger };
+        ctx->handle = code;
+    }
+    ctx->result = EOK;
+    return ctx->result;
+}
+
+/**
+ * Marshal C struct to the logger of a handle obtained with EVT_OP_GET_LOGGER
+ */
+evt_status_t mat_log_with_logger(evt_context_t *ctx)
+{
+    if (ctx == nullptr)
+    {
+        return EFAULT; /* bad address */
+    }
+
+    ILogger *logger = nullptr;
+    {
+        LOCKGUARD(mtx);
+        const auto it = loggers.find(ctx->handle);
+        if (it != loggers.cend())
+        {
+            logger = it->second.logger;
+        }
+    }
+    if (logger == nullptr)
+    {
+        return ENOENT;
+    }
+
+    const evt_prop *evt = static_cast<evt_prop*>(ctx->data);
+    EventProperties props;
+    props.unpack(evt, ctx->size);
+    // The logger already knows its tenant, do not send it as a custom property
+    props.erase(COMMONFIELDS_IKEY);
+
+    logger->LogEvent(props);
+    ctx->result = EOK;
+    return ctx->result;
+}
+
 evt_status_t mat_close(evt_context_t *ctx)
 {
     VERIFY_CLIENT_HANDLE(client, ctx);
@@ -386,6 +544,18 @@ extern "C" {
                 result = mat_log(ctx);
                 break;
 
+            case EVT_OP_LOG_BATCH:
+                result = mat_log_batch(ctx);
+                break;
+
+            case EVT_OP_GET_LOGGER:
+                result = mat_get_logger_handle(ctx);
+                break;
+
+            case EVT_OP_LOG_WITH_LOGGER:
+                result = mat_log_with_logger(ctx);
+                break;
+
             case EVT_OP_PAUSE:
                 result = mat_pause(ctx);
                 break;
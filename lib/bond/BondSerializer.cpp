@@ -11,23 +11,112 @@
 #include "bond/generated/CsProtocol_readers.hpp"
 #include "oacr.h"
 
+namespace bond_lite {
+
+    /// <summary>
+    /// Compact Binary writer that splices previously encoded Part A extension
+    /// structs into the output instead of walking their fields again.
+    /// The encoding of a struct does not depend on the writer state, so the
+    /// spliced bytes are identical to what the generated writer would emit.
+    /// </summary>
+    class PartACachingProtocolWriter : public CompactBinaryProtocolWriter
+    {
+      public:
+        PartACachingProtocolWriter(std::vector<uint8_t>& output, MAT::BondSerializer::PartACache& cache)
+          : CompactBinaryProtocolWriter(output),
+            m_cache(cache)
+        {
+        }
+
+        template<typename T>
+        void WriteCached(MAT::BondSerializer::PartACacheEntry<T>& entry, T const& value, bool isBase)
+        {
+            if (isBase)
+            {
+                CompactBinaryProtocolWriter& writer = *this;
+                Serialize(writer, value, isBase);
+                return;
+            }
+
+            if (entry.valid && entry.value == value)
+            {
+                m_cache.hits++;
+            }
+            else
+            {
+                m_cache.misses++;
+                entry.value = value;
+                entry.bytes.clear();
+                CompactBinaryProtocolWriter writer(entry.bytes);
+                Serialize(writer, value, isBase);
+                entry.valid = true;
+            }
+            WriteBlob(entry.bytes.data(), entry.bytes.size());
+        }
+
+        MAT::BondSerializer::PartACache& m_cache;
+    };
+
+    // Found by argument-dependent lookup from the generated Record writer,
+    // and preferred over the generated templates for this writer type.
+
+    void Serialize(PartACachingProtocolWriter& writer, ::CsProtocol::Protocol const& value, bool isBase)
+    {
+        writer.WriteCached(writer.m_cache.protocol, value, isBase);
+    }
+
+    void Serialize(PartACachingProtocolWriter& writer, ::CsProtocol::User const& value, bool isBase)
+    {
+        writer.WriteCached(writer.m_cache.user, value, isBase);
+    }
+
+    void Serialize(PartACachingProtocolWriter& writer, ::CsProtocol::Device const& value, bool isBase)
+    {
+        writer.WriteCached(writer.m_cache.device, value, isBase);
+    }
+
+    void Serialize(PartACachingProtocolWriter& writer, ::CsProtocol::Os const& value, bool isBase)
+    {
+        writer.WriteCached(writer.m_cache.os, value, isBase);
+    }
+
+    void Serialize(PartACachingProtocolWriter& writer, ::CsProtocol::App const& value, bool isBase)
+    {
+        writer.WriteCached(writer.m_cache.app, value, isBase);
+    }
+
+    void Serialize(PartACachingProtocolWriter& writer, ::CsProtocol::Net const& value, bool isBase)
+    {
+        writer.WriteCached(writer.m_cache.net, value, isBase);
+    }
+
+} // namespace bond_lite
+
 namespace MAT_NS_BEGIN {
 
+    BondSerializer::BondSerializer(IRuntimeConfig& config) :
+        m_integrity(config)
+    {
+    }
+
     bool BondSerializer::handleSerialize(IncomingEventContextPtr const& ctx)
     {
         OACR_USE_PTR(this);
         {
-            bond_lite::CompactBinaryProtocolWriter writer(ctx->record.blob);
+            LOCKGUARD(m_partACacheLock);
+            ctx->record.blob.reserve(m_partACache.lastRecordSize);
+            bond_lite::PartACachingProtocolWriter writer(ctx->record.blob, m_partACache);
             bond_lite::Serialize(writer, *ctx->source);
+            m_partACache.lastRecordSize = ctx->record.blob.size();
         }
+        m_integrity.Sign(ctx->record);
 
-        LOG_TRACE("Event %s/%s submitted, priority %u (%s), serialized size %u bytes, ID %s",
+        LOG_TRACE("Event %s/%s submitted, priority %u (%s), serialized size %u bytes, ID %llu",
             tenantTokenToId(ctx->record.tenantToken).c_str(), ctx->source->baseType.c_str(),
             ctx->record.latency, latencyToStr(ctx->record.latency),
-            static_cast<unsigned>(ctx->record.blob.size()), ctx->record.id.c_str());
+            static_cast<unsigned>(ctx->record.blob.size()), static_cast<unsigned long long>(ctx->record.id));
 
         return true;
     }
 
 } MAT_NS_END
-
@@ -6,12 +6,55 @@
 #pragma once
 #include "system/Contexts.hpp"
 #include "system/Route.hpp"
+#include "offline/RecordIntegrity.hpp"
+
+#include <mutex>
+#include <vector>
 
 namespace MAT_NS_BEGIN {
 
 
 class BondSerializer {
+  public:
+    /// <summary>
+    /// Bond encoding of the last Part A extension struct of one type,
+    /// along with the value it was encoded from.
+    /// </summary>
+    template<typename T>
+    struct PartACacheEntry {
+        T                    value;
+        std::vector<uint8_t> bytes;
+        bool                 valid = false;
+    };
+
+    /// <summary>
+    /// Part A extensions that rarely change between events. extSdk is not
+    /// cached since its sequence number differs for every event.
+    /// </summary>
+    struct PartACache {
+        PartACacheEntry<::CsProtocol::Protocol> protocol;
+        PartACacheEntry<::CsProtocol::User>     user;
+        PartACacheEntry<::CsProtocol::Device>   device;
+        PartACacheEntry<::CsProtocol::Os>       os;
+        PartACacheEntry<::CsProtocol::App>      app;
+        PartACacheEntry<::CsProtocol::Net>      net;
+        size_t                                  lastRecordSize = 0;
+        size_t                                  hits = 0;
+        size_t                                  misses = 0;
+    };
+
+    BondSerializer() = default;
+
+    /// <summary>
+    /// Signs serialized records as configured by CFG_BOOL_ENABLE_CRC32 and CFG_BOOL_ENABLE_HMAC.
+    /// </summary>
+    explicit BondSerializer(IRuntimeConfig& config);
+
   protected:
+    std::mutex      m_partACacheLock;
+    PartACache      m_partACache;
+    RecordIntegrity m_integrity;
+
     bool handleSerialize(IncomingEventContextPtr const& ctx);
 
   public:
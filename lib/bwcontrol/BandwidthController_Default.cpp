@@ -0,0 +1,87 @@
+//
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// SPDX-License-Identifier: Apache-2.0
+//
+#include "BandwidthController_Default.hpp"
+
+#include <algorithm>
+#include <limits>
+
+namespace MAT_NS_BEGIN {
+
+    MATSDK_LOG_INST_COMPONENT_CLASS(BandwidthController_Default, "EventsSDK.BWC", "Events telemetry client - BandwidthController_Default class");
+
+    BandwidthController_Default::BandwidthController_Default(unsigned sharePercent, uint64_t windowMs) :
+        m_sharePercent(std::min(std::max(sharePercent, 1u), 100u)),
+        m_windowMs(std::max<uint64_t>(windowMs, 1))
+    {
+    }
+
+    unsigned BandwidthController_Default::GetProposedBandwidthBps()
+    {
+        LOCKGUARD(m_lock);
+        uint64_t bandwidth = estimate(getMonotonicTimeMs());
+        if (bandwidth == 0)
+        {
+            return std::numeric_limits<unsigned>::max();
+        }
+        uint64_t proposed = std::max<uint64_t>(1, bandwidth * m_sharePercent / 100);
+        return static_cast<unsigned>(std::min<uint64_t>(proposed, std::numeric_limits<unsigned>::max() - 1));
+    }
+
+    unsigned BandwidthController_Default::GetEstimatedBandwidthBps()
+    {
+        LOCKGUARD(m_lock);
+        return static_cast<unsigned>(std::min<uint64_t>(estimate(getMonotonicTimeMs()), std::numeric_limits<unsigned>::max() - 1));
+    }
+
+    void BandwidthController_Default::OnUploadCompleted(unsigned bytes, unsigned durationMs, bool appLimited)
+    {
+        LOCKGUARD(m_lock);
+        uint64_t nowMs = getMonotonicTimeMs();
+        m_deliveries.push_back(Delivery { nowMs, bytes });
+
+        // Uploads running in parallel share the link, so count everything
+        // delivered while this one was in flight
+        uint64_t startMs = (nowMs > durationMs) ? (nowMs - durationMs) : 0;
+        uint64_t delivered = 0;
+        for (auto it = m_deliveries.rbegin(); (it != m_deliveries.rend()) && (it->timeMs > startMs); ++it)
+        {
+            delivered += it->bytes;
+        }
+        uint64_t rateBps = delivered * 1000 / std::max(durationMs, 1u);
+        m_samples.push_back(RateSample { nowMs, rateBps, appLimited });
+        LOG_TRACE("Upload of %u bytes took %u ms, delivery rate %llu B/s%s", bytes, durationMs,
+            static_cast<unsigned long long>(rateBps), appLimited ? " (app-limited)" : "");
+    }
+
+    uint64_t BandwidthController_Default::getMonotonicTimeMs() const
+    {
+        return PAL::getMonotonicTimeMs();
+    }
+
+    uint64_t BandwidthController_Default::estimate(uint64_t nowMs)
+    {
+        uint64_t expiry = (nowMs > m_windowMs) ? (nowMs - m_windowMs) : 0;
+        while (!m_deliveries.empty() && (m_deliveries.front().timeMs < expiry))
+        {
+            m_deliveries.pop_front();
+        }
+        while (!m_samples.empty() && (m_samples.front().timeMs < expiry))
+        {
+            m_samples.pop_front();
+        }
+
+        // App-limited samples only underestimate the link, but they still
+        // count once a full upload has shown the link is the bottleneck
+        bool linkLimited = false;
+        uint64_t bandwidth = 0;
+        for (auto const& sample : m_samples)
+        {
+            linkLimited |= !sample.appLimited;
+            bandwidth = std::max(bandwidth, sample.rateBps);
+        }
+        return linkLimited ? bandwidth : 0;
+    }
+
+} MAT_NS_END
@@ -0,0 +1,75 @@
+//
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// SPDX-License-Identifier: Apache-2.0
+//
+#ifndef BANDWIDTHCONTROLLER_DEFAULT_HPP
+#define BANDWIDTHCONTROLLER_DEFAULT_HPP
+
+#include "IBandwidthController.hpp"
+#include "pal/PAL.hpp"
+
+#include <cstdint>
+#include <deque>
+#include <mutex>
+
+namespace MAT_NS_BEGIN {
+
+    /// <summary>
+    /// Portable bandwidth controller that estimates the link throughput from
+    /// completed uploads, similar to BBR: every upload yields a delivery rate
+    /// sample (bytes delivered while it was in flight, divided by its duration)
+    /// and the bottleneck bandwidth is the largest sample within a sliding
+    /// window. The proposed bandwidth is a configured share of that estimate.
+    /// </summary>
+    class BandwidthController_Default : public IBandwidthController
+    {
+    public:
+        static constexpr uint64_t DefaultWindowMs = 10000;
+
+        BandwidthController_Default(unsigned sharePercent, uint64_t windowMs = DefaultWindowMs);
+        virtual ~BandwidthController_Default() = default;
+
+        /// <summary>
+        /// Share of the estimated bandwidth, or UINT_MAX while there is no
+        /// estimate, i.e. uploads are not limited.
+        /// </summary>
+        virtual unsigned GetProposedBandwidthBps() override;
+
+        virtual void OnUploadCompleted(unsigned bytes, unsigned durationMs, bool appLimited) override;
+
+        /// <summary>
+        /// Estimated bottleneck bandwidth in bytes per second, 0 if unknown.
+        /// Only uploads that filled their budget make an estimate: smaller ones
+        /// measure the application rather than the link.
+        /// </summary>
+        unsigned GetEstimatedBandwidthBps();
+
+    protected:
+        MATSDK_LOG_DECL_COMPONENT_CLASS();
+
+        struct Delivery
+        {
+            uint64_t timeMs;
+            unsigned bytes;
+        };
+
+        struct RateSample
+        {
+            uint64_t timeMs;
+            uint64_t rateBps;
+            bool     appLimited;
+        };
+
+        virtual uint64_t getMonotonicTimeMs() const;
+        uint64_t estimate(uint64_t nowMs);
+
+        std::mutex             m_lock;
+        const unsigned         m_sharePercent;
+        const uint64_t         m_windowMs;
+        std::deque<Delivery>   m_deliveries;
+        std::deque<RateSample> m_samples;
+    };
+
+} MAT_NS_END
+
+#endif // BANDWIDTHCONTROLLER_DEFAULT_HPP
@@ -18,7 +18,12 @@ namespace MAT_NS_BEGIN
         {CFG_INT_RAM_QUEUE_SIZE, 524288},
         {CFG_BOOL_ENABLE_MULTITENANT, true},
         {CFG_BOOL_ENABLE_DB_DROP_IF_FULL, false},
+        {CFG_BOOL_ENABLE_DB_COMPRESS, false},
+        {CFG_BOOL_ENABLE_ASYNC_STORAGE_INIT, false},
+        {CFG_BOOL_ENABLE_CRC32, false},
+        {CFG_BOOL_ENABLE_HMAC, false},
         {CFG_INT_MAX_TEARDOWN_TIME, 1},
+        {CFG_BOOL_PERSIST_ON_TEARDOWN, false},
         {CFG_INT_MAX_PENDING_REQ, 4},
         {CFG_INT_RAM_QUEUE_BUFFERS, 3},
         {CFG_INT_TRACE_LEVEL_MASK, 0},
@@ -57,10 +62,14 @@ namespace MAT_NS_BEGIN
              ,
              {"contentEncoding", "deflate"},
              /* Optional parameter to require Microsoft Root CA */
-             {CFG_BOOL_HTTP_MS_ROOT_CHECK, false}}},
+             {CFG_BOOL_HTTP_MS_ROOT_CHECK, false},
+             {CFG_INT_HTTP_MAX_CONNECTIONS_PER_HOST, 4},
+             {CFG_INT_HTTP_IDLE_TIMEOUT, 60000},
+             {CFG_INT_HTTP_MAX_CONNECTION_FAILURES, 1}}},
         {CFG_MAP_TPM,
          {
              {CFG_INT_TPM_MAX_BLOB_BYTES, 2097152},
+             {CFG_INT_TPM_BANDWIDTH_SHARE, 80},
              {CFG_INT_TPM_MAX_RETRY, 5},
              {CFG_BOOL_TPM_CLOCK_SKEW_ENABLED, true},
              {CFG_STR_TPM_BACKOFF, "E,3000,300000,2,1"},
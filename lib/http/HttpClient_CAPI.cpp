@@ -4,6 +4,7 @@
 //
 #include "HttpClient_CAPI.hpp"
 
+#include <algorithm>
 #include <mutex>
 #include <sstream>
 
@@ -15,10 +16,13 @@ namespace MAT_NS_BEGIN {
     class HttpClient_Operation
     {
     public:
-        HttpClient_Operation(SimpleHttpRequest* request, IHttpResponseCallback* callback, http_cancel_fn_t cancelFn)
+        HttpClient_Operation(SimpleHttpRequest* request, IHttpResponseCallback* callback, http_cancel_fn_t cancelFn,
+                             HttpClient_CAPI* client = nullptr, std::string const& origin = std::string())
           : m_request(request),
             m_callback(callback),
-            m_cancelFn(cancelFn)
+            m_cancelFn(cancelFn),
+            m_client(client),
+            m_origin(origin)
         {
             if ((m_request == nullptr) || (callback == nullptr) || (cancelFn == nullptr))
             {
@@ -33,6 +37,11 @@ namespace MAT_NS_BEGIN {
 
         void OnResponse(IHttpResponse* response)
         {
+            // Free the connection slot first so a queued request can go out
+            if (m_client != nullptr)
+            {
+                m_client->OnRequestDone(m_origin, response->GetResult() != HttpResult_NetworkFailure);
+            }
             m_callback->OnHttpResponse(response);
         }
 
@@ -41,6 +50,8 @@ namespace MAT_NS_BEGIN {
 
         IHttpResponseCallback*              m_callback;
         http_cancel_fn_t                    m_cancelFn;
+        HttpClient_CAPI*                    m_client;
+        std::string                         m_origin;
     };
 
 
@@ -150,6 +161,44 @@ namespace MAT_NS_BEGIN {
     {
         // Note: 'request' is never owned by IHttpClient and gets deleted in EventsUploadContext.clear()
         auto simpleRequest = static_cast<SimpleHttpRequest*>(request);
+        std::string origin = HttpConnectionPool::GetOrigin(simpleRequest->m_url);
+        {
+            LOCKGUARD(m_requestsMutex);
+            HttpConnectionPool::Connection connection;
+            if (!m_connectionPool.Acquire(origin, connection))
+            {
+                LOG_TRACE("Queueing CAPI HTTP request '%s': all connections to %s are busy", simpleRequest->m_id.c_str(), origin.c_str());
+                m_queuedRequests[origin].push_back(QueuedRequest { simpleRequest, callback });
+                return;
+            }
+        }
+        Send(simpleRequest, callback, origin);
+    }
+
+    void HttpClient_CAPI::OnRequestDone(std::string const& origin, bool healthy)
+    {
+        QueuedRequest next { nullptr, nullptr };
+        {
+            LOCKGUARD(m_requestsMutex);
+            m_connectionPool.Release(origin, nullptr, healthy);
+            auto it = m_queuedRequests.find(origin);
+            if (it == m_queuedRequests.end() || it->second.empty())
+            {
+                return;
+            }
+            HttpConnectionPool::Connection connection;
+            if (!m_connectionPool.Acquire(origin, connection))
+            {
+                return;
+            }
+            next = it->second.front();
+            it->second.pop_front();
+        }
+        Send(next.request, next.callback, origin);
+    }
+
+    void HttpClient_CAPI::Send(SimpleHttpRequest* simpleRequest, IHttpResponseCallback* callback, std::string const& origin)
+    {
         auto requestId = simpleRequest->m_id;
 
         LOG_TRACE("Sending CAPI HTTP request '%s'", requestId.c_str());
@@ -177,15 +226,45 @@ namespace MAT_NS_BEGIN {
         capiRequest.headersCount = static_cast<int32_t>(capiHeaders.size());
         capiRequest.headers = capiHeaders.data();
 
-        auto operation = std::make_shared<HttpClient_Operation>(simpleRequest, callback, m_cancelFn);
+        auto operation = std::make_shared<HttpClient_Operation>(simpleRequest, callback, m_cancelFn, this, origin);
         AddPendingOperation(requestId, operation);
 
         m_sendFn(&capiRequest, &OnHttpResponse);
     }
 
+    // Completes a request that never left the queue
+    static void AbortQueuedRequest(SimpleHttpRequest* request, IHttpResponseCallback* callback)
+    {
+        std::unique_ptr<SimpleHttpResponse> response(new SimpleHttpResponse(request->m_id));
+        response->m_result = HttpResult_Aborted;
+        // 'response' is no longer owned by IHttpClient and gets deleted in EventsUploadContext.clear()
+        callback->OnHttpResponse(response.release());
+    }
+
     void HttpClient_CAPI::CancelRequestAsync(const std::string& id)
     {
         LOG_TRACE("Cancelling CAPI HTTP request '%s'", id.c_str());
+        QueuedRequest queued { nullptr, nullptr };
+        {
+            LOCKGUARD(m_requestsMutex);
+            for (auto& item : m_queuedRequests)
+            {
+                auto& requests = item.second;
+                auto it = std::find_if(requests.begin(), requests.end(), [&id](QueuedRequest const& r) { return r.request->m_id == id; });
+                if (it != requests.end())
+                {
+                    queued = *it;
+                    requests.erase(it);
+                    break;
+                }
+            }
+        }
+        if (queued.request != nullptr)
+        {
+            AbortQueuedRequest(queued.request, queued.callback);
+            return;
+        }
+
         std::shared_ptr<HttpClient_Operation> operation(nullptr);
         {
             // Only lock mutex while actually reading/writing pending operations collection to prevent potential recursive deadlock
@@ -206,6 +285,20 @@ namespace MAT_NS_BEGIN {
     void HttpClient_CAPI::CancelAllRequests()
     {
         LOG_TRACE("Cancelling all CAPI HTTP requests");
+        std::vector<QueuedRequest> queued;
+        {
+            LOCKGUARD(m_requestsMutex);
+            for (auto& item : m_queuedRequests)
+            {
+                queued.insert(queued.end(), item.second.begin(), item.second.end());
+            }
+            m_queuedRequests.clear();
+        }
+        for (auto const& request : queued)
+        {
+            AbortQueuedRequest(request.request, request.callback);
+        }
+
         std::vector<std::shared_ptr<HttpClient_Operation>> operations;
         {
             // Only lock mutex while actually reading/writing pending operations collection to prevent potential recursive deadlock
@@ -222,4 +315,9 @@ namespace MAT_NS_BEGIN {
         }
     }
 
+    void HttpClient_CAPI::SetConnectionPoolOptions(HttpConnectionPoolOptions const& options)
+    {
+        m_connectionPool.SetOptions(options);
+    }
+
 } MAT_NS_END
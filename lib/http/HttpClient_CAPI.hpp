@@ -6,9 +6,12 @@
 #define HTTPCLIENT_CAPI_HPP
 
 #include "IHttpClient.hpp"
+#include "HttpConnectionPool.hpp"
 #include "pal/PAL.hpp"
 #include "mat.h"
 
+#include <deque>
+#include <map>
 #include <string>
 
 namespace MAT_NS_BEGIN {
@@ -21,11 +24,29 @@ namespace MAT_NS_BEGIN {
         virtual void SendRequestAsync(IHttpRequest* request, IHttpResponseCallback* callback) override;
         virtual void CancelRequestAsync(std::string const& id) override;
         virtual void CancelAllRequests() override;
+        virtual void SetConnectionPoolOptions(HttpConnectionPoolOptions const& options) override;
+
+        // Called when the host stack completed a request sent to the origin
+        void OnRequestDone(std::string const& origin, bool healthy);
 
     private:
+        struct QueuedRequest
+        {
+            SimpleHttpRequest*     request;
+            IHttpResponseCallback* callback;
+        };
+
+        void Send(SimpleHttpRequest* request, IHttpResponseCallback* callback, std::string const& origin);
+
         http_send_fn_t    m_sendFn;
         http_cancel_fn_t  m_cancelFn;
         std::mutex        m_requestsMutex;
+
+        // The host application owns the connections, so the pool only
+        // tracks connection slots: requests over the per-host limit wait
+        // here until a request to the same host completes.
+        HttpConnectionPool                                m_connectionPool;
+        std::map<std::string, std::deque<QueuedRequest>>  m_queuedRequests;
     };
 
 } MAT_NS_END
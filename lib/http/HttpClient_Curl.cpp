@@ -43,7 +43,8 @@ namespace MAT_NS_BEGIN {
         std::shared_ptr<CurlHttpOperation> m_curlOperation;
     };
 
-    HttpClient_Curl::HttpClient_Curl()
+    HttpClient_Curl::HttpClient_Curl() :
+        m_connectionPool([](HttpConnectionPool::Connection connection) { curl_easy_cleanup(static_cast<CURL*>(connection)); })
     {
         /* In windows, this will init the winsock stuff */
         TRACE("Initializing HttpClient_Curl...\n");
@@ -53,6 +54,7 @@ namespace MAT_NS_BEGIN {
 
     HttpClient_Curl::~HttpClient_Curl()
     {
+        m_connectionPool.CloseIdle(false);
         curl_global_cleanup();
         TRACE("Destroyed HttpClient_Curl.\n");
     };
@@ -74,11 +76,18 @@ namespace MAT_NS_BEGIN {
             requestHeaders[header.first] = header.second;
         }
 
-        auto curlOperation = std::make_shared<CurlHttpOperation>(curlRequest->m_method, curlRequest->m_url, callback, requestHeaders, curlRequest->m_body);
+        // Take a connection slot for the host, reusing an idle handle when possible.
+        // Over the per-host limit the request still goes out on a one-off handle.
+        std::string origin = HttpConnectionPool::GetOrigin(curlRequest->m_url);
+        HttpConnectionPool::Connection handle = nullptr;
+        bool pooled = m_connectionPool.Acquire(origin, handle);
+
+        auto curlOperation = std::make_shared<CurlHttpOperation>(curlRequest->m_method, curlRequest->m_url, callback, requestHeaders, curlRequest->m_body,
+            false, HTTP_CONN_TIMEOUT, static_cast<CURL*>(handle));
         curlRequest->SetOperation(curlOperation);
         
         // The lifetime of curlOperation is guarnteed by the call to result.wait() in the d'tor.  
-        curlOperation->SendAsync([this, callback, requestId](CurlHttpOperation& operation) {
+        curlOperation->SendAsync([this, callback, requestId, origin, pooled](CurlHttpOperation& operation) {
             this->EraseRequest(requestId);
 
             auto response = std::unique_ptr<SimpleHttpResponse>(new SimpleHttpResponse(requestId));
@@ -101,6 +110,14 @@ namespace MAT_NS_BEGIN {
             auto responseHeaders = operation.GetResponseHeaders();
             response->m_headers.insert(responseHeaders.begin(), responseHeaders.end());
             response->m_body = operation.GetResponseBody();
+
+            // Hand the handle with its live connection back for the next request
+            CURL* curl = operation.DetachHandle();
+            if (pooled) {
+                m_connectionPool.Release(origin, curl, operation.IsConnectionReusable());
+            } else if (curl != nullptr) {
+                curl_easy_cleanup(curl);
+            }
             
             // 'response' is no longer owned by IHttpClient and gets deleted in EventsUploadContext.clear()
             callback->OnHttpResponse(response.release());
@@ -125,6 +142,16 @@ namespace MAT_NS_BEGIN {
         }
     }
 
+    void HttpClient_Curl::SetConnectionPoolOptions(HttpConnectionPoolOptions const& options)
+    {
+        m_connectionPool.SetOptions(options);
+    }
+
+    HttpConnectionPool::Stats HttpClient_Curl::GetConnectionPoolStats() const
+    {
+        return m_connectionPool.GetStats();
+    }
+
     void HttpClient_Curl::EraseRequest(std::string const& id)
     {
         std::lock_guard<std::mutex> lock(m_requestsMtx);
@@ -28,6 +28,7 @@
 #include <unistd.h>
 
 #include "IHttpClient.hpp"
+#include "HttpConnectionPool.hpp"
 #include "pal/PAL.hpp"
 
 #ifdef HAVE_ONEDS_BOUNDCHECK_METHODS
@@ -54,6 +55,9 @@ public:
     virtual IHttpRequest* CreateRequest() override;
     virtual void SendRequestAsync(IHttpRequest* request, IHttpResponseCallback* callback) override;
     virtual void CancelRequestAsync(std::string const& id) override;
+    virtual void SetConnectionPoolOptions(HttpConnectionPoolOptions const& options) override;
+
+    HttpConnectionPool::Stats GetConnectionPoolStats() const;
 
 private:
     void EraseRequest(std::string const& id);
@@ -61,6 +65,10 @@ private:
 
     std::mutex m_requestsMtx;
     std::map<std::string, IHttpRequest*> m_requests;
+
+    // Idle CURL easy handles keep their live connections and TLS session
+    // cache, so reusing a handle for the same host skips the handshake.
+    HttpConnectionPool m_connectionPool;
 };
 
 class CurlHttpOperation {
@@ -80,7 +88,7 @@ public:
      * @param url
      * @param body
      * @param httpConnTimeout   HTTP connection timeout in seconds
-     * @param httpReadTimeout   HTTP read timeout in seconds
+     * @param handle            Pooled CURL handle to reuse (optional)
      */
     CurlHttpOperation(
             std::string method,
@@ -91,7 +99,8 @@ public:
             const std::vector<uint8_t>& requestBody                  = std::vector<uint8_t>(),
             // Default connectivity and response size options
             bool rawResponse                                         = false,
-            size_t httpConnTimeout                                   = HTTP_CONN_TIMEOUT) :
+            size_t httpConnTimeout                                   = HTTP_CONN_TIMEOUT,
+            CURL* handle                                             = nullptr) :
 
             // Optional connection params
             rawResponse(rawResponse),
@@ -109,8 +118,16 @@ public:
         response.memory = nullptr;
         response.size = 0;
 
-        /* get a curl handle */
-        curl = curl_easy_init();
+        /* reuse a pooled curl handle along with its connection cache, or get a new one */
+        if (handle != nullptr)
+        {
+            curl = handle;
+            curl_easy_reset(curl);
+            reused = true;
+        } else
+        {
+            curl = curl_easy_init();
+        }
         if(!curl)
         {
             TRACE("libcurl failed to init!\n");
@@ -135,6 +152,12 @@ public:
         // HTTP/2 please, fallback to HTTP/1.1 if not supported
         curl_easy_setopt(curl, CURLOPT_HTTP_VERSION, CURL_HTTP_VERSION_2_0);
 
+        // Abort transfers from the progress callback, since a reused connection
+        // has no socket of ours to close
+        curl_easy_setopt(curl, CURLOPT_NOPROGRESS, 0L);
+        curl_easy_setopt(curl, CURLOPT_XFERINFOFUNCTION, &ProgressCallback);
+        curl_easy_setopt(curl, CURLOPT_XFERINFODATA, static_cast<void*>(this));
+
         // Specify our custom headers
         for(auto &kv : this->requestHeaders)
         {
@@ -166,7 +189,10 @@ public:
         }
         DispatchEvent(OnDestroy);
         res = CURLE_OK;
-        curl_easy_cleanup(curl);
+        if (curl != nullptr)
+        {
+            curl_easy_cleanup(curl);
+        }
         curl_slist_free_all(m_headersChunk);
         ReleaseResponse();
     }
@@ -193,6 +219,14 @@ public:
         // TODO: should we control what local source port we use?
         // curl_easy_setopt(curl, CURLOPT_LOCALPORT, dcf_port);
 
+        if (reused)
+        {
+            // The handle most likely holds a live connection to this host: let
+            // curl reuse it, or reconnect within the same timeout if it is gone.
+            curl_easy_setopt(curl, CURLOPT_CONNECTTIMEOUT, static_cast<long>(httpConnTimeout));
+            goto send;
+        }
+
         // Perform initial connect, handling the timeout if needed
         curl_easy_setopt(curl, CURLOPT_CONNECT_ONLY, 1L);
         DispatchEvent(OnConnecting);
@@ -235,6 +269,8 @@ public:
         // once connection is there - switch back to easy perform for HTTP post
         curl_easy_setopt(curl, CURLOPT_CONNECT_ONLY, 0);
 
+send:
+
         // send all data to our callback function
         if (rawResponse)
         {
@@ -306,7 +342,11 @@ cleanup:
         result = std::async(std::launch::async, [this, callback] {
             long result = Send();
             if (callback!=nullptr)
+            {
                 callback(*this);
+                // Delivering the response releases the listener, don't notify it on destroy
+                m_callback = nullptr;
+            }
             return result;
         });
         return result;
@@ -396,6 +436,7 @@ cleanup:
     void Abort()
     {
         isAborted = true;
+        std::lock_guard<std::mutex> lock(handleMtx);
         if (curl!=nullptr)
         {
             // Simply close the socket - connection reset by peer.. Ha-ha-ha-ha-ha!
@@ -411,12 +452,35 @@ cleanup:
         return curl;
     }
 
+    /**
+     * Take ownership of the CURL handle, e.g. to return it to a connection pool.
+     */
+    CURL *DetachHandle()
+    {
+        std::lock_guard<std::mutex> lock(handleMtx);
+        CURL *handle = curl;
+        curl = nullptr;
+        sockfd = 0;
+        return handle;
+    }
+
+    /**
+     * Whether the connection held by the CURL handle can be reused:
+     * the server responded and the request was not aborted.
+     */
+    bool IsConnectionReusable()
+    {
+        return !isAborted.load() && (res > CURL_LAST);
+    }
+
 protected:
     const bool   rawResponse;       // Do not split response headers from response body
     const size_t httpConnTimeout;   // Timeout for connect.  Default: 5s
 
     CURL *curl;                     // Local curl instance
     CURLcode res = CURLE_OK;        // Curl result OR HTTP status code if successful
+    bool reused = false;            // Curl instance came from the connection pool
+    std::mutex handleMtx;           // Guards curl and sockfd against Abort()
     
     IHttpResponseCallback* m_callback = nullptr;
 
@@ -476,6 +540,15 @@ protected:
         return res;
     }
 
+    /**
+     * Progress callback: a non-zero return aborts the transfer
+     */
+    static int ProgressCallback(void *clientp, curl_off_t, curl_off_t, curl_off_t, curl_off_t)
+    {
+        CurlHttpOperation *operation = static_cast<CurlHttpOperation *>(clientp);
+        return (operation != nullptr && operation->isAborted.load()) ? 1 : 0;
+    }
+
     // Raw response buffer
     struct MemoryStruct {
       char *memory;
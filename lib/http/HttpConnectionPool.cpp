@@ -0,0 +1,256 @@
+//
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// SPDX-License-Identifier: Apache-2.0
+//
+#include "HttpConnectionPool.hpp"
+#include "utils/StringUtils.hpp"
+
+namespace MAT_NS_BEGIN {
+
+    HttpConnectionPool::HttpConnectionPool(CloseFunction closeConnection) :
+        m_closeConnection(closeConnection)
+    {
+    }
+
+    HttpConnectionPool::~HttpConnectionPool()
+    {
+        CloseIdle(false);
+    }
+
+    void HttpConnectionPool::SetOptions(HttpConnectionPoolOptions const& options)
+    {
+        std::list<Connection> toClose;
+        {
+            LOCKGUARD(m_lock);
+            m_options = options;
+            // Trim the idle lists to the new limit
+            for (auto& item : m_hosts)
+            {
+                auto& idle = item.second.idle;
+                while (idle.size() > m_options.maxConnectionsPerHost)
+                {
+                    toClose.push_back(idle.back().connection);
+                    idle.pop_back();
+                }
+            }
+        }
+        close(toClose);
+    }
+
+    HttpConnectionPoolOptions HttpConnectionPool::GetOptions() const
+    {
+        LOCKGUARD(m_lock);
+        return m_options;
+    }
+
+    std::string HttpConnectionPool::GetOrigin(std::string const& url)
+    {
+        std::string scheme = "http";
+        size_t hostStart = 0;
+        size_t schemeEnd = url.find("://");
+        if (schemeEnd != std::string::npos)
+        {
+            scheme = toLower(url.substr(0, schemeEnd));
+            hostStart = schemeEnd + 3;
+        }
+
+        size_t hostEnd = url.find_first_of("/?#", hostStart);
+        std::string authority = toLower(url.substr(hostStart, (hostEnd == std::string::npos) ? std::string::npos : hostEnd - hostStart));
+        size_t userInfoEnd = authority.rfind('@');
+        if (userInfoEnd != std::string::npos)
+        {
+            authority.erase(0, userInfoEnd + 1);
+        }
+
+        // Append the default port so that equivalent URLs share connections
+        size_t portStart = authority.rfind(':');
+        size_t ipv6End = authority.rfind(']');
+        if ((portStart == std::string::npos) || ((ipv6End != std::string::npos) && (portStart < ipv6End)))
+        {
+            authority += (scheme == "https") ? ":443" : ":80";
+        }
+
+        return scheme + "://" + authority;
+    }
+
+    bool HttpConnectionPool::Acquire(std::string const& origin, Connection& connection)
+    {
+        connection = nullptr;
+        std::list<Connection> toClose;
+        bool result = true;
+        {
+            LOCKGUARD(m_lock);
+            if (m_options.maxConnectionsPerHost == 0)
+            {
+                m_stats.created++;
+                return true;
+            }
+
+            Host& host = m_hosts[origin];
+            closeExpired(host, PAL::getMonotonicTimeMs(), toClose);
+            if (host.active >= m_options.maxConnectionsPerHost)
+            {
+                m_stats.rejected++;
+                result = false;
+            }
+            else
+            {
+                host.active++;
+                if (!host.idle.empty())
+                {
+                    connection = host.idle.front().connection;
+                    host.idle.pop_front();
+                    m_stats.reused++;
+                }
+                else
+                {
+                    m_stats.created++;
+                }
+            }
+        }
+        close(toClose);
+        return result;
+    }
+
+    void HttpConnectionPool::Release(std::string const& origin, Connection connection, bool healthy)
+    {
+        std::list<Connection> toClose;
+        {
+            LOCKGUARD(m_lock);
+            if (!healthy)
+            {
+                m_stats.failures++;
+            }
+
+            if (m_options.maxConnectionsPerHost == 0)
+            {
+                if (connection != nullptr)
+                {
+                    toClose.push_back(connection);
+                }
+            }
+            else
+            {
+                Host& host = m_hosts[origin];
+                if (host.active > 0)
+                {
+                    host.active--;
+                }
+
+                if (healthy)
+                {
+                    host.consecutiveFailures = 0;
+                    if (connection != nullptr)
+                    {
+                        host.idle.push_front(IdleConnection { connection, PAL::getMonotonicTimeMs() });
+                        while (host.idle.size() > m_options.maxConnectionsPerHost)
+                        {
+                            toClose.push_back(host.idle.back().connection);
+                            host.idle.pop_back();
+                        }
+                    }
+                }
+                else
+                {
+                    if (connection != nullptr)
+                    {
+                        toClose.push_back(connection);
+                    }
+                    host.consecutiveFailures++;
+                    if ((m_options.maxConsecutiveFailures > 0) && (host.consecutiveFailures >= m_options.maxConsecutiveFailures))
+                    {
+                        LOG_INFO("Closing %u idle connection(s) to %s after %u failure(s)",
+                            static_cast<unsigned>(host.idle.size()), origin.c_str(), host.consecutiveFailures);
+                        for (auto const& idle : host.idle)
+                        {
+                            toClose.push_back(idle.connection);
+                        }
+                        host.idle.clear();
+                        host.consecutiveFailures = 0;
+                    }
+                }
+            }
+        }
+        close(toClose);
+    }
+
+    size_t HttpConnectionPool::CloseIdle(bool expiredOnly)
+    {
+        std::list<Connection> toClose;
+        {
+            LOCKGUARD(m_lock);
+            uint64_t nowMs = PAL::getMonotonicTimeMs();
+            for (auto& item : m_hosts)
+            {
+                if (expiredOnly)
+                {
+                    closeExpired(item.second, nowMs, toClose);
+                }
+                else
+                {
+                    for (auto const& idle : item.second.idle)
+                    {
+                        toClose.push_back(idle.connection);
+                    }
+                    item.second.idle.clear();
+                }
+            }
+        }
+        size_t count = toClose.size();
+        close(toClose);
+        return count;
+    }
+
+    size_t HttpConnectionPool::GetActiveCount(std::string const& origin) const
+    {
+        LOCKGUARD(m_lock);
+        auto it = m_hosts.find(origin);
+        return (it != m_hosts.end()) ? it->second.active : 0;
+    }
+
+    size_t HttpConnectionPool::GetIdleCount(std::string const& origin) const
+    {
+        LOCKGUARD(m_lock);
+        auto it = m_hosts.find(origin);
+        return (it != m_hosts.end()) ? it->second.idle.size() : 0;
+    }
+
+    HttpConnectionPool::Stats HttpConnectionPool::GetStats() const
+    {
+        LOCKGUARD(m_lock);
+        return m_stats;
+    }
+
+    void HttpConnectionPool::closeExpired(Host& host, uint64_t nowMs, std::list<Connection>& toClose)
+    {
+        // Idle list is ordered by release time, so expired connections are at the back
+        while (!host.idle.empty() && (nowMs - host.idle.back().releasedAtMs >= m_options.idleTimeoutMs))
+        {
+            toClose.push_back(host.idle.back().connection);
+            host.idle.pop_back();
+        }
+    }
+
+    void HttpConnectionPool::close(std::list<Connection>& toClose)
+    {
+        if (toClose.empty())
+        {
+            return;
+        }
+
+        {
+            LOCKGUARD(m_lock);
+            m_stats.closed += toClose.size();
+        }
+
+        if (m_closeConnection)
+        {
+            for (Connection connection : toClose)
+            {
+                m_closeConnection(connection);
+            }
+        }
+        toClose.clear();
+    }
+
+} MAT_NS_END
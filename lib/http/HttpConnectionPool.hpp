@@ -0,0 +1,102 @@
+//
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// SPDX-License-Identifier: Apache-2.0
+//
+#ifndef HTTPCONNECTIONPOOL_HPP
+#define HTTPCONNECTIONPOOL_HPP
+
+#include "IHttpClient.hpp"
+#include "pal/PAL.hpp"
+
+#include <functional>
+#include <list>
+#include <map>
+#include <mutex>
+#include <string>
+
+namespace MAT_NS_BEGIN {
+
+    /// <summary>
+    /// Keeps idle HTTP connections per host (scheme, host and port) for reuse
+    /// by subsequent requests, and limits how many connections are used for
+    /// one host at a time. Connections are opaque to the pool: the HTTP client
+    /// owns them and supplies a function to close the ones the pool discards.
+    /// </summary>
+    class HttpConnectionPool
+    {
+    public:
+        typedef void* Connection;
+        typedef std::function<void(Connection)> CloseFunction;
+
+        struct Stats
+        {
+            size_t created  = 0;   // Acquired slots without an idle connection to reuse
+            size_t reused   = 0;   // Acquired slots that reused an idle connection
+            size_t closed   = 0;   // Connections closed by the pool
+            size_t failures = 0;   // Connections released as unhealthy
+            size_t rejected = 0;   // Acquire attempts over the per-host limit
+        };
+
+        HttpConnectionPool(CloseFunction closeConnection = nullptr);
+        virtual ~HttpConnectionPool();
+
+        void SetOptions(HttpConnectionPoolOptions const& options);
+        HttpConnectionPoolOptions GetOptions() const;
+
+        /// <summary>
+        /// Returns the pool key for a URL, i.e. "scheme://host:port" in lowercase.
+        /// </summary>
+        static std::string GetOrigin(std::string const& url);
+
+        /// <summary>
+        /// Reserves a connection slot for the host. If an idle connection is
+        /// available it is handed over in <paramref name="connection"/>, otherwise
+        /// <paramref name="connection"/> is set to nullptr and the caller opens a new one.
+        /// </summary>
+        /// <returns>false if all connection slots for the host are in use.</returns>
+        bool Acquire(std::string const& origin, Connection& connection);
+
+        /// <summary>
+        /// Releases a slot reserved by Acquire. A healthy connection is kept for
+        /// reuse, an unhealthy one is closed. Consecutive failures mark every idle
+        /// connection of the host as stale.
+        /// </summary>
+        void Release(std::string const& origin, Connection connection, bool healthy);
+
+        /// <summary>
+        /// Closes idle connections: only the expired ones, or all of them.
+        /// </summary>
+        /// <returns>Number of connections closed.</returns>
+        size_t CloseIdle(bool expiredOnly = true);
+
+        size_t GetActiveCount(std::string const& origin) const;
+        size_t GetIdleCount(std::string const& origin) const;
+        Stats GetStats() const;
+
+    protected:
+        struct IdleConnection
+        {
+            Connection connection;
+            uint64_t   releasedAtMs;
+        };
+
+        struct Host
+        {
+            size_t                    active = 0;
+            unsigned                  consecutiveFailures = 0;
+            std::list<IdleConnection> idle;    // Most recently released first
+        };
+
+        void closeExpired(Host& host, uint64_t nowMs, std::list<Connection>& toClose);
+        void close(std::list<Connection>& toClose);
+
+        mutable std::mutex          m_lock;
+        CloseFunction               m_closeConnection;
+        HttpConnectionPoolOptions   m_options;
+        std::map<std::string, Host> m_hosts;
+        Stats                       m_stats;
+    };
+
+} MAT_NS_END
+
+#endif // HTTPCONNECTIONPOOL_HPP
@@ -67,6 +67,9 @@ namespace MAT_NS_BEGIN
             void PushMetric(double value);
 
         private:
+            AggregatedMetric(AggregatedMetric const&) = delete;
+            AggregatedMetric& operator=(AggregatedMetric const&) = delete;
+
             /// <summary>
             /// Actual implementation of AggregatedMetric.
             /// </summary>
@@ -59,6 +59,16 @@ namespace MAT_NS_BEGIN
             return evt_log(handle, evt);
         }
 
+        evt_handle_t getLogger(const char* token, const char* source = nullptr)
+        {
+            return evt_get_logger(handle, token, source);
+        }
+
+        evt_status_t log(evt_handle_t logger, evt_prop* evt)
+        {
+            return evt_log_with_logger(logger, evt);
+        }
+
         evt_status_t pause()
         {
             return evt_pause(handle);
@@ -25,6 +25,16 @@ namespace MAT_NS_BEGIN
         /// </summary>
         /// <returns>Proposed bandwidth in bytes per second</returns>
         virtual unsigned GetProposedBandwidthBps() = 0;
+
+        /// <summary>
+        /// Reports a completed upload, so that the controller can estimate the
+        /// bandwidth available to the SDK. The default implementation ignores it.
+        /// </summary>
+        /// <param name="bytes">Size of the HTTP request in bytes</param>
+        /// <param name="durationMs">Time from sending the request until the response arrived</param>
+        /// <param name="appLimited">true if the upload was smaller than allowed because
+        /// there was nothing more to send</param>
+        virtual void OnUploadCompleted(unsigned /*bytes*/, unsigned /*durationMs*/, bool /*appLimited*/) {}
     };
 } MAT_NS_END
 
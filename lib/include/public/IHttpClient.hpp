@@ -460,6 +460,29 @@ namespace MAT_NS_BEGIN
         OnDestroy
     } HttpStateEvent;
 
+    /// <summary>
+    /// The HttpConnectionPoolOptions struct describes how an HTTP client
+    /// should keep and reuse connections to the collector.
+    /// </summary>
+    struct HttpConnectionPoolOptions
+    {
+        /// <summary>
+        /// Maximum number of connections kept per host. 0 disables connection reuse.
+        /// </summary>
+        size_t   maxConnectionsPerHost = 4;
+
+        /// <summary>
+        /// Idle connections older than this are closed instead of reused.
+        /// </summary>
+        uint64_t idleTimeoutMs = 60000;
+
+        /// <summary>
+        /// Number of consecutive failed requests to a host after which all of
+        /// its idle connections are considered stale and closed.
+        /// </summary>
+        unsigned maxConsecutiveFailures = 1;
+    };
+
     /// <summary>
     /// The IHttpResponseCallback class receives HTTP client responses.
     /// </summary>
@@ -543,6 +566,13 @@ namespace MAT_NS_BEGIN
         virtual void CancelRequestAsync(std::string const& id) = 0;
 
         virtual void CancelAllRequests() {};
+
+        /// <summary>
+        /// Sets the connection reuse policy. Clients that do not manage
+        /// their own connections may ignore it.
+        /// </summary>
+        /// <param name="options">Connection pool options.</param>
+        virtual void SetConnectionPoolOptions(HttpConnectionPoolOptions const& /*options*/) {};
     };
 
     /// @endcond
@@ -84,6 +84,11 @@ namespace MAT_NS_BEGIN
     /// </summary>
     static constexpr const char* const CFG_BOOL_ENABLE_HMAC = "enableHMAC";
 
+    /// <summary>
+    /// Secret key for the HMAC of stored events, required by CFG_BOOL_ENABLE_HMAC.
+    /// </summary>
+    static constexpr const char* const CFG_STR_HMAC_KEY = "hmacKey";
+
     /// <summary>
     /// Enable dropping events if DB file size exceeds its limit.
     /// </summary>
@@ -94,6 +99,12 @@ namespace MAT_NS_BEGIN
     /// </summary>
     static constexpr const char* const CFG_BOOL_ENABLE_DB_COMPRESS = "enableDBCompression";
 
+    /// <summary>
+    /// Open the offline storage file on a background thread. Events are kept in the
+    /// in-memory queue until the file is ready.
+    /// </summary>
+    static constexpr const char* const CFG_BOOL_ENABLE_ASYNC_STORAGE_INIT = "enableAsyncStorageInit";
+
     /// <summary>
     /// Enable WAL journal.
     /// </summary>
@@ -169,6 +180,18 @@ namespace MAT_NS_BEGIN
     /// </summary>
     static constexpr const char* const CFG_STR_TRACE_FOLDER_PATH = "traceFolderPath";
 
+    /// <summary>
+    /// Size in bytes at which the trace file is rotated, 0 (default) for no rotation.
+    /// The previous file is kept with a ".1" suffix.
+    /// </summary>
+    static constexpr const char* const CFG_INT_TRACE_FILE_SIZE = "traceFileSize";
+
+    /// <summary>
+    /// Map of trace component names, such as "EventsSDK.Storage", to the minimum trace level
+    /// of that component. Other components use CFG_INT_TRACE_LEVEL_MIN.
+    /// </summary>
+    static constexpr const char* const CFG_MAP_TRACE_COMPONENT_LEVELS = "traceComponentLevels";
+
     /// <summary>
     /// The SDK mode.
     /// </summary>
@@ -199,6 +222,12 @@ namespace MAT_NS_BEGIN
     /// </summary>
     static constexpr const char* const CFG_INT_MAX_TEARDOWN_TIME = "maxTeardownUploadTimeInSec";
 
+    /// <summary>
+    /// Skip the upload on teardown and save the events left in the in-memory
+    /// queue to the offline storage in one batch instead.
+    /// </summary>
+    static constexpr const char* const CFG_BOOL_PERSIST_ON_TEARDOWN = "persistOnTeardown";
+
     /// <summary>
     /// Disable zombie logger logic.
     /// </summary>
@@ -276,6 +305,12 @@ namespace MAT_NS_BEGIN
     /// </summary>
     static constexpr const char* const CFG_MODULE_PRIVACY_GUARD = "privacy_guard";
 
+    /// <summary>
+    /// Number of threads helping to inspect events logged in groups with registered data
+    /// inspectors. Default: 0, events are inspected on the logging thread only.
+    /// </summary>
+    static constexpr const char* const CFG_INT_DATA_INSPECTOR_THREADS = "dataInspectorThreads";
+
     /// <summary>
     /// IDecorator override module
     /// </summary>
@@ -311,6 +346,18 @@ namespace MAT_NS_BEGIN
     /// </summary>
     static constexpr const char* const CFG_STR_CONTEXT_SCOPE = "scope";
 
+    /// <summary>
+    /// sub-component in CFG_MAP_FACTORY_CONFIG: run the instance on the worker pool, timers and HTTP client
+    /// shared by all instances created with this option, instead of its own HTTP client and the default dispatcher
+    /// </summary>
+    static constexpr const char* const CFG_BOOL_FACTORY_SHARED_RUNTIME = "sharedRuntime";
+
+    /// <summary>
+    /// sub-component in CFG_MAP_FACTORY_CONFIG: number of threads of the shared worker pool, set by the
+    /// instance which creates it. Default: 2
+    /// </summary>
+    static constexpr const char* const CFG_INT_FACTORY_WORKER_THREADS = "workerThreads";
+
     /// <summary>
     /// MetaStats configuration
     /// </summary>
@@ -361,6 +408,21 @@ namespace MAT_NS_BEGIN
     /// </summary>
     static constexpr const char* const CFG_BOOL_HTTP_COMPRESSION = "compress";
 
+    /// <summary>
+    /// HTTP configuration: maximum number of connections per host, 0 disables connection pooling
+    /// </summary>
+    static constexpr const char* const CFG_INT_HTTP_MAX_CONNECTIONS_PER_HOST = "maxConnectionsPerHost";
+
+    /// <summary>
+    /// HTTP configuration: time in milliseconds after which an idle pooled connection is closed
+    /// </summary>
+    static constexpr const char* const CFG_INT_HTTP_IDLE_TIMEOUT = "idleConnectionTimeoutMs";
+
+    /// <summary>
+    /// HTTP configuration: consecutive failures after which the idle connections of a host are closed
+    /// </summary>
+    static constexpr const char* const CFG_INT_HTTP_MAX_CONNECTION_FAILURES = "maxConnectionFailures";
+
     /// <summary>
     /// TPM configuration map
     /// </summary>
@@ -381,6 +443,12 @@ namespace MAT_NS_BEGIN
     /// </summary>
     static constexpr const char* const CFG_INT_TPM_MAX_BLOB_BYTES = "maxBlobSize";
 
+    /// <summary>
+    /// TPM configuration: share of the estimated link bandwidth, in percent, that
+    /// uploads may use when no external bandwidth controller is set. 0 disables pacing.
+    /// </summary>
+    static constexpr const char* const CFG_INT_TPM_BANDWIDTH_SHARE = "bandwidthSharePercent";
+
     /// <summary>
     /// TPM configuration map
     /// </summary>
@@ -434,6 +434,14 @@ Refer to https://osgwiki.com/wiki/Common_Schema_Event_Overrides for details on t
         /// <param name="properties">Properties of this custom event, specified using an EventProperties object.</param>
         virtual void LogEvent(EventProperties const& properties) = 0;
 
+        /// <summary>
+        /// Logs a batch of custom events. All events in the batch are decorated,
+        /// serialized and stored in one pass, which is cheaper than calling
+        /// LogEvent once per event.
+        /// </summary>
+        /// <param name="events">Properties of the custom events, one EventProperties object per event.</param>
+        virtual void LogEvents(std::vector<EventProperties> const& events) = 0;
+
         /// <summary>
         /// Logs a failure event - such as an application exception.
         /// </summary>
@@ -20,12 +20,16 @@ namespace MAT_NS_BEGIN {
     constexpr unsigned int DB_FULL_NOTIFICATION_DEFAULT_PERCENTAGE = 75;
     constexpr uint64_t     DB_FULL_CHECK_INTERVAL_DEFAULT_MS = 5000;
 
-    using StorageRecordId = std::string;
+    /// <summary>
+    /// Identifier of a stored record, unique among the records of a storage.
+    /// Assigned by PAL::generateRecordId(), 0 is not a valid identifier.
+    /// </summary>
+    using StorageRecordId = uint64_t;
 
     using StorageBlob = std::vector<uint8_t>;
 
     struct StorageRecord {
-        StorageRecordId id;
+        StorageRecordId id = 0;
         std::string     tenantToken;
         EventLatency    latency = EventLatency_Unspecified;
         EventPersistence persistence = EventPersistence_Normal;
@@ -33,6 +37,8 @@ namespace MAT_NS_BEGIN {
         StorageBlob     blob;
         int             retryCount = 0;
         int64_t         reservedUntil = 0;
+        /// CRC-32C or HMAC-SHA256 of the blob, empty if it is not checked
+        StorageBlob     digest;
 #ifdef HAVE_MAT_EVT_TRACEID 
         std::string     traceId;
 #endif // HAVE_MAT_EVT_TRACEID
@@ -41,16 +47,16 @@ namespace MAT_NS_BEGIN {
         {}
 
 #ifdef HAVE_MAT_EVT_TRACEID
-        StorageRecord(std::string const& id, std::string const& tenantToken, EventLatency latency, EventPersistence persistence, std::string traceId)
+        StorageRecord(StorageRecordId id, std::string const& tenantToken, EventLatency latency, EventPersistence persistence, std::string traceId)
             : id(id), tenantToken(tenantToken), latency(latency), persistence(persistence), traceId(traceId)
         {}
 #else
-        StorageRecord(std::string const& id, std::string const& tenantToken, EventLatency latency, EventPersistence persistence)
+        StorageRecord(StorageRecordId id, std::string const& tenantToken, EventLatency latency, EventPersistence persistence)
             : id(id), tenantToken(tenantToken), latency(latency), persistence(persistence)
         {}
 #endif // HAVE_MAT_EVT_TRACEID
 
-        StorageRecord(std::string const& id, std::string const& tenantToken, EventLatency latency, EventPersistence persistence,
+        StorageRecord(StorageRecordId id, std::string const& tenantToken, EventLatency latency, EventPersistence persistence,
             int64_t timestamp, std::vector<uint8_t>&& blob, int retryCount = 0, int64_t reservedUntil = 0)
             : id(id), tenantToken(tenantToken), latency(latency), persistence(persistence), timestamp(timestamp), blob(blob), retryCount(retryCount), reservedUntil(reservedUntil)
         {}
@@ -171,6 +177,16 @@ namespace MAT_NS_BEGIN {
         /// </summary>
         virtual void Flush() = 0;
 
+        /// <summary>
+        /// Save pending records to persistent storage during shutdown
+        /// </summary>
+        /// <remarks>
+        /// Unlike Flush(), this runs while the log manager activity is paused
+        /// for teardown, concurrently with the last upload callbacks, so that
+        /// Shutdown() has little left to save. The default does nothing.
+        /// </remarks>
+        virtual void FlushForShutdown() {}
+
         /// <summary>
         /// Store one telemetry event record
         /// </summary>
@@ -189,7 +205,8 @@ namespace MAT_NS_BEGIN {
         /// <remarks>
         /// The offline storage might need to trim the oldest events before
         /// inserting the new one in order to maintain its configured size limit.
-        /// Called from the internal worker thread.
+        /// Records that were stored are moved to the front of the vector,
+        /// keeping their original order. Called from the internal worker thread.
         /// </remarks>
         /// <param name="record">Record data to store</param>
         /// <returns>Number of records stored</returns>
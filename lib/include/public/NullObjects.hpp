@@ -88,6 +88,8 @@ namespace MAT_NS_BEGIN
 
         virtual void LogEvent(EventProperties const & /*properties*/) override {};
 
+        virtual void LogEvents(std::vector<EventProperties> const & /*events*/) override {};
+
         virtual void LogFailure(std::string const & /*signature*/, std::string const & /*detail*/, EventProperties const & /*properties*/) override {};
 
         virtual void LogFailure(std::string const & /*signature*/, std::string const & /*detail*/, std::string const & /*category*/, std::string const & /*id*/, EventProperties const & /*properties*/) override {};
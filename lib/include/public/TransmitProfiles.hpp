@@ -158,8 +158,9 @@ namespace MAT_NS_BEGIN
 
         /// <summary>
         /// A boolean value that indicates whether the timer was updated.
+        /// Read without the profiles lock on every incoming event.
         /// </summary>
-        static bool isTimerUpdated;
+        static std::atomic<bool> isTimerUpdated;
 
         static void UpdateProfiles(const std::vector<TransmitProfileRules>& newProfiles) noexcept;
 
@@ -60,7 +60,10 @@ extern "C" {
         EVT_OP_VERSION = 0x0000000B,
         EVT_OP_OPEN_WITH_PARAMS = 0x0000000C,
         EVT_OP_FLUSHANDTEARDOWN = 0x0000000D,
-        EVT_OP_MAX = EVT_OP_FLUSHANDTEARDOWN + 1,
+        EVT_OP_LOG_BATCH = 0x0000000E,
+        EVT_OP_GET_LOGGER = 0x0000000F,
+        EVT_OP_LOG_WITH_LOGGER = 0x00000010,
+        EVT_OP_MAX = EVT_OP_LOG_WITH_LOGGER + 1,
     } evt_call_t;
 
     typedef enum evt_prop_t
@@ -165,6 +168,17 @@ extern "C" {
         int32_t                 paramsCount;
     } evt_open_with_params_data_t;
 
+    /**
+     * <summary>
+     * Tenant token and optional event source of the logger returned by 'evt_get_logger'
+     * </summary>
+     */
+    typedef struct evt_get_logger_data_t
+    {
+        const char*             token;
+        const char*             source;
+    } evt_get_logger_data_t;
+
     typedef union evt_prop_v
     {
         /* Basic types */
@@ -521,6 +535,68 @@ extern "C" {
         return evt_api_call(&ctx);
     }
 
+    /**
+     * <summary>
+     * Logs a batch of telemetry events.
+     * Each evt_prop array in the batch must end with { .name = NULL, .type = TYPE_NULL }
+     * </summary>
+     * <param name="handle">SDK handle.</param>
+     * <param name="count">Number of events in the batch.</param>
+     * <param name="evts">Array of event properties arrays.</param>
+     * <returns>Status code.</returns>
+     */
+    static inline evt_status_t evt_log_batch(evt_handle_t handle, uint32_t count, evt_prop** evts)
+    {
+        evt_context_t ctx;
+        ctx.call = EVT_OP_LOG_BATCH;
+        ctx.handle = handle;
+        ctx.data = (void *)evts;
+        ctx.size = count;
+        return evt_api_call(&ctx);
+    }
+
+    /**
+     * <summary>
+     * Resolves the logger of a tenant token and event source once. Events logged with
+     * 'evt_log_with_logger' skip the per-event iKey and source lookup of 'evt_log'.
+     * The logger handle stays valid until the SDK handle is closed.
+     * </summary>
+     * <param name="handle">SDK handle.</param>
+     * <param name="token">Tenant token of the events.</param>
+     * <param name="source">Event source, may be NULL.</param>
+     * <returns>Logger handle, 0 on failure.</returns>
+     */
+    static inline evt_handle_t evt_get_logger(evt_handle_t handle, const char* token, const char* source)
+    {
+        evt_get_logger_data_t data;
+        data.token = token;
+        data.source = source;
+        evt_context_t ctx;
+        ctx.call = EVT_OP_GET_LOGGER;
+        ctx.handle = handle;
+        ctx.data = (void *)&data;
+        return (evt_api_call(&ctx) == 0) ? ctx.handle : 0;
+    }
+
+    /**
+     * <summary>
+     * Logs a telemetry event through a logger handle returned by 'evt_get_logger'.
+     * Last item in evt_prop array must be { .name = NULL, .type = TYPE_NULL }
+     * </summary>
+     * <param name="logger">Logger handle.</param>
+     * <param name="evt">Event properties array.</param>
+     * <returns>Status code.</returns>
+     */
+    static inline evt_status_t evt_log_with_logger(evt_handle_t logger, evt_prop* evt)
+    {
+        evt_context_t ctx;
+        ctx.call = EVT_OP_LOG_WITH_LOGGER;
+        ctx.handle = logger;
+        ctx.data = (void *)evt;
+        ctx.size = 0;
+        return evt_api_call(&ctx);
+    }
+
     /* This macro automagically calculates the array size and passes it down to evt_log_s.
      * Developers don't have to calculate the number of event properties passed down to
      *'Log Event' API call utilizing the concept of Secure Template Overloads:
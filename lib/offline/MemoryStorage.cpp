@@ -111,10 +111,19 @@ namespace MAT_NS_BEGIN {
     size_t MemoryStorage::StoreRecords(std::vector<StorageRecord> & records)
     {
         size_t stored = 0;
-        for (auto  & i : records) {
-            if (StoreRecord(i)) {
-                ++stored;
+        LOCKGUARD(m_records_lock);
+        for (size_t i = 0; i < records.size(); i++) {
+            StorageRecord const& record = records[i];
+            // Don't store events with latency set to off. Logger API already does a similar check.
+            if (record.latency == EventLatency_Off) {
+                continue;
+            }
+            m_size += record.blob.size() + sizeof(record); // approximate contents size
+            m_records[record.latency].push_back(record);
+            if (i != stored) {
+                std::swap(records[stored], records[i]);
             }
+            ++stored;
         }
         return stored;
     }
@@ -230,7 +239,7 @@ namespace MAT_NS_BEGIN {
             for (const auto &kv : whereFilter)
             {
                 matched &=
-                    (kv.first == "record_id") ? (r.id == kv.second) :
+                    (kv.first == "record_id") ? (std::to_string(r.id) == kv.second) :
                     (kv.first == "tenant_token") ? (r.tenantToken == kv.second) :
                     (kv.first == "latency") ? (std::to_string(r.latency) == kv.second) :
                     (kv.first == "persistence") ? (std::to_string(r.persistence) == kv.second) :
@@ -298,19 +307,12 @@ namespace MAT_NS_BEGIN {
             LOCKGUARD(m_reserved_lock);
             if (m_reserved_records.size())
             {
-                std::unordered_set<StorageRecordId> idSet(ids.begin(), ids.end());
-                auto it = m_reserved_records.begin();
-                while (it != m_reserved_records.end()) {
-                    auto &kv = *it;
-                    if (idSet.count(kv.first))
-                    {
-                        idSet.erase(kv.first);
-                        it = m_reserved_records.erase(it);
-                        continue;
-                    }
-                    ++it;
+                size_t erased = 0;
+                for (StorageRecordId id : ids)
+                {
+                    erased += m_reserved_records.erase(id);
                 }
-                if (idSet.size() == 0) // done
+                if (erased == ids.size()) // done
                     return;
             }
         }
@@ -366,20 +368,15 @@ namespace MAT_NS_BEGIN {
         LOCKGUARD(m_reserved_lock);
         if (m_reserved_records.size())
         {
-            std::unordered_set<StorageRecordId> idSet(ids.begin(), ids.end());
-            auto it = m_reserved_records.begin();
-            while (it != m_reserved_records.end()) {
-                auto &kv = *it;
-                if (idSet.count(kv.first))
-                {
-                    if (incrementRetryCount)
-                        kv.second.retryCount++;
-                    StoreRecord(kv.second);
-                    idSet.erase(kv.first);
-                    it = m_reserved_records.erase(it);
+            for (StorageRecordId id : ids)
+            {
+                auto it = m_reserved_records.find(id);
+                if (it == m_reserved_records.end())
                     continue;
-                }
-                ++it;
+                if (incrementRetryCount)
+                    it->second.retryCount++;
+                StoreRecord(it->second);
+                m_reserved_records.erase(it);
             }
         }
     }
@@ -20,6 +20,7 @@
 #include <mutex>
 #include <map>
 #include <string>
+#include <unordered_map>
 #include <unordered_set>
 
 namespace MAT_NS_BEGIN {
@@ -89,7 +90,7 @@ namespace MAT_NS_BEGIN {
         /// Current storage interface API requires deletion and release by StorageRecordId.
         /// </summary>
         std::mutex                  m_reserved_lock;
-        std::map<StorageRecordId, StorageRecord> m_reserved_records;
+        std::unordered_map<StorageRecordId, StorageRecord> m_reserved_records;
 
         size_t                      m_size;
 
@@ -10,6 +10,7 @@
 
 #include "ILogManager.hpp"
 #include <algorithm>
+#include <iterator>
 #include <numeric>
 #include <set>
 
@@ -25,9 +26,11 @@ namespace MAT_NS_BEGIN {
         m_taskDispatcher(taskDispatcher),
         m_killSwitchManager(),
         m_clockSkewManager(),
+        m_integrity(runtimeConfig),
         m_flushPending(false),
         m_offlineStorageMemory(nullptr),
         m_offlineStorageDisk(nullptr),
+        m_diskStorageReady(false),
         m_readFromMemory(false),
         m_lastReadCount(0),
         m_shutdownStarted(false),
@@ -47,6 +50,9 @@ namespace MAT_NS_BEGIN {
             // In case if user has specified bad percentage, we stick to 75%
             m_memoryDbSizeNotificationLimit = (DB_FULL_NOTIFICATION_DEFAULT_PERCENTAGE * cacheMemorySizeLimitInBytes) / 100;
         }
+
+        // Nothing to wait for until Initialize() opens the disk storage in the background
+        m_diskStorageInitialized.post();
     }
 
     bool OfflineStorageHandler::isKilled(StorageRecord const& record)
@@ -69,6 +75,10 @@ namespace MAT_NS_BEGIN {
 
     OfflineStorageHandler::~OfflineStorageHandler()
     {
+        if (m_diskStorageInitThread.joinable())
+        {
+            m_diskStorageInitThread.join();
+        }
         WaitForFlush();
         if (nullptr != m_offlineStorageMemory)
         {
@@ -85,10 +95,25 @@ namespace MAT_NS_BEGIN {
         m_observer = &observer;
         uint32_t cacheMemorySizeLimitInBytes = m_config[CFG_INT_RAM_QUEUE_SIZE];
 
+        if (m_diskStorageInitThread.joinable())
+        {
+            m_diskStorageInitThread.join();
+        }
+        m_diskStorageReady = false;
+
+        // Opening the disk storage (file, schema checks, prepared statements) is the
+        // slowest part of the SDK start. It can be left to a background thread as long
+        // as there is a memory storage to hold the events in the meantime.
         m_offlineStorageDisk = OfflineStorageFactory::Create(m_logManager, m_config);
-        if (m_offlineStorageDisk)
+        bool initializeInBackground = (m_offlineStorageDisk != nullptr) && (cacheMemorySizeLimitInBytes > 0) &&
+                                      static_cast<bool>(m_config[CFG_BOOL_ENABLE_ASYNC_STORAGE_INIT]);
+        if (initializeInBackground)
         {
-            m_offlineStorageDisk->Initialize(*this);
+            m_diskStorageInitialized.Reset();
+        }
+        else
+        {
+            initializeDiskStorage();
         }
 
         // TODO: [MG] - consider passing m_offlineStorageDisk to m_offlineStorageMemory,
@@ -101,21 +126,56 @@ namespace MAT_NS_BEGIN {
         }
 
         m_shutdownStarted = false;
-        LOG_TRACE("Initializing offline storage handler");
+        if (initializeInBackground)
+        {
+            LOG_TRACE("Initializing offline storage handler, disk storage in the background");
+            m_diskStorageInitThread = std::thread(&OfflineStorageHandler::initializeDiskStorage, this);
+        }
+        else
+        {
+            LOG_TRACE("Initializing offline storage handler");
+        }
+    }
+
+    void OfflineStorageHandler::initializeDiskStorage()
+    {
+        if (m_offlineStorageDisk)
+        {
+            m_offlineStorageDisk->Initialize(*this);
+            m_diskStorageReady = true;
+        }
+        m_diskStorageInitialized.post();
+    }
+
+    IOfflineStorage* OfflineStorageHandler::diskStorage() const
+    {
+        return m_diskStorageReady ? m_offlineStorageDisk.get() : nullptr;
+    }
+
+    IOfflineStorage* OfflineStorageHandler::waitForDiskStorage() const
+    {
+        m_diskStorageInitialized.wait();
+        return diskStorage();
     }
 
     void OfflineStorageHandler::Shutdown()
     {
         LOG_TRACE("Shutting down offline storage handler");
+        // Records still in memory are saved to disk below
+        if (m_diskStorageInitThread.joinable())
+        {
+            m_diskStorageInitThread.join();
+        }
         m_shutdownStarted = true;
         WaitForFlush();
         if (nullptr != m_offlineStorageMemory)
         {
             m_offlineStorageMemory->ReleaseAllRecords();
-            Flush();
+            // Activity is paused for teardown, Flush() would skip the records
+            flushToDisk();
             m_offlineStorageMemory->Shutdown();
         }
-        if (nullptr != m_offlineStorageDisk)
+        if (nullptr != diskStorage())
         {
             m_offlineStorageDisk->Shutdown();
         }
@@ -135,7 +195,7 @@ namespace MAT_NS_BEGIN {
         size_t size = 0;
         if (m_offlineStorageMemory != nullptr)
             size += m_offlineStorageMemory->GetSize();
-        if (m_offlineStorageDisk != nullptr)
+        if (diskStorage() != nullptr)
             size += m_offlineStorageDisk->GetSize();
         return size;
     }
@@ -145,7 +205,7 @@ namespace MAT_NS_BEGIN {
         size_t count = 0;
         if (m_offlineStorageMemory != nullptr)
             count += m_offlineStorageMemory->GetRecordCount(latency);
-        if (m_offlineStorageDisk != nullptr)
+        if (diskStorage() != nullptr)
             count += m_offlineStorageDisk->GetRecordCount(latency);
         return count;
     }
@@ -153,8 +213,24 @@ namespace MAT_NS_BEGIN {
     void OfflineStorageHandler::Flush()
     {
         if (!m_logManager.StartActivity()) {
+            // Paused for teardown: a flush requested before the pause never
+            // runs, so release the waiters instead of letting Shutdown() hang
+            LOCKGUARD(m_flushLock);
+            m_flushComplete.post();
+            m_flushPending = false;
             return;
         }
+        flushToDisk();
+        m_logManager.EndActivity();
+    }
+
+    void OfflineStorageHandler::FlushForShutdown()
+    {
+        flushToDisk();
+    }
+
+    void OfflineStorageHandler::flushToDisk()
+    {
         // Flush could be executed from context of worker thread, as well as from TPM and
         // after HTTP callback. Make sure it is atomic / thread-safe.
         LOCKGUARD(m_flushLock);
@@ -164,23 +240,19 @@ namespace MAT_NS_BEGIN {
         // than the handle gets replaced by nullptr in this DeferredCallbackHandle obj.
         m_flushHandle.Cancel();
 
-        size_t dbSizeBeforeFlush = m_offlineStorageMemory->GetSize();
-        if ((m_offlineStorageMemory) && (dbSizeBeforeFlush > 0) && (m_offlineStorageDisk))
+        // Waits for a background initialization: the flush runs on the worker
+        // thread or on behalf of LogManager::Flush(), not on the LogEvent path
+        IOfflineStorage* offlineStorageDisk = waitForDiskStorage();
+        size_t dbSizeBeforeFlush = (m_offlineStorageMemory) ? m_offlineStorageMemory->GetSize() : 0;
+        if ((m_offlineStorageMemory) && (dbSizeBeforeFlush > 0) && (offlineStorageDisk))
         {
             // This will block on and then take a lock for the duration of this move, and
             // StoreRecord() will then block until the move completes.
             auto records = m_offlineStorageMemory->GetRecords(false, EventLatency_Unspecified);
             std::vector<StorageRecordId> ids;
 
-            // TODO: [MG] - consider running the batch in transaction
-            //            if (sqlite)
-            //                sqlite->Execute("BEGIN");
-
-            size_t totalSaved = m_offlineStorageDisk->StoreRecords(records);
-
-            // TODO: [MG] - consider running the batch in transaction
-            //            if (sqlite)
-            //                sqlite->Execute("END");
+            // The disk storage writes the whole batch in one transaction
+            size_t totalSaved = offlineStorageDisk->StoreRecords(records);
 
             // Delete records from reserved on flush
             HttpHeaders dummy;
@@ -200,9 +272,9 @@ namespace MAT_NS_BEGIN {
         }
 
         // Checkpoint DB
-        if (m_config.HasConfig(CFG_BOOL_CHECKPOINT_DB_ON_FLUSH) && m_config[CFG_BOOL_CHECKPOINT_DB_ON_FLUSH]) 
+        if ((offlineStorageDisk) && m_config.HasConfig(CFG_BOOL_CHECKPOINT_DB_ON_FLUSH) && m_config[CFG_BOOL_CHECKPOINT_DB_ON_FLUSH])
         {
-            m_offlineStorageDisk->Flush();
+            offlineStorageDisk->Flush();
         }
 
         m_isStorageFullNotificationSend = false;
@@ -210,7 +282,6 @@ namespace MAT_NS_BEGIN {
         // Flush is done, notify the waiters
         m_flushComplete.post();
         m_flushPending = false;
-        m_logManager.EndActivity();
     }
 
     bool OfflineStorageHandler::StoreRecord(StorageRecord const& record)
@@ -255,7 +326,7 @@ namespace MAT_NS_BEGIN {
         }
         else
         {
-            if (m_offlineStorageDisk != nullptr)
+            if (diskStorage() != nullptr)
             {
                 if (record.persistence != EventPersistence::EventPersistence_DoNotStoreOnDisk)
                 {
@@ -269,14 +340,68 @@ namespace MAT_NS_BEGIN {
 
     size_t OfflineStorageHandler::StoreRecords(std::vector<StorageRecord>& records)
     {
-        size_t stored = 0;
-        for (auto& i : records)
+        if (nullptr == m_offlineStorageMemory || m_shutdownStarted)
         {
-            if (StoreRecord(i))
+            size_t stored = 0;
+            for (size_t i = 0; i < records.size(); i++)
             {
-                ++stored;
+                if (StoreRecord(records[i]))
+                {
+                    if (i != stored)
+                    {
+                        std::swap(records[stored], records[i]);
+                    }
+                    ++stored;
+                }
             }
+            return stored;
         }
+
+        // Discard unwanted records associated with killed tenants: these stay
+        // at the back of the vector, after the records that are stored.
+        size_t accepted = 0;
+        for (size_t i = 0; i < records.size(); i++)
+        {
+            if (!isKilled(records[i]))
+            {
+                if (i != accepted)
+                {
+                    std::swap(records[accepted], records[i]);
+                }
+                ++accepted;
+            }
+        }
+
+        std::vector<StorageRecord> killed;
+        if (accepted != records.size())
+        {
+            killed.assign(std::make_move_iterator(records.begin() + accepted), std::make_move_iterator(records.end()));
+            records.resize(accepted);
+        }
+
+        // Check cache size only once at start
+        static uint32_t cacheMemorySizeLimitInBytes = m_config[CFG_INT_RAM_QUEUE_SIZE];
+
+        auto memDbSize = m_offlineStorageMemory->GetSize();
+        size_t stored = m_offlineStorageMemory->StoreRecords(records);
+
+        // Perform periodic flush to disk once for the whole batch
+        if (memDbSize > cacheMemorySizeLimitInBytes)
+        {
+            if (m_flushLock.try_lock())
+            {
+                if (!m_flushPending)
+                {
+                    m_flushPending = true;
+                    m_flushComplete.Reset();
+                    m_flushHandle = PAL::scheduleTask(&m_taskDispatcher, 0, this, &OfflineStorageHandler::Flush);
+                    LOG_INFO("Requested Flush (%p)", m_flushHandle.m_task);
+                }
+                m_flushLock.unlock();
+            }
+        }
+
+        records.insert(records.end(), std::make_move_iterator(killed.begin()), std::make_move_iterator(killed.end()));
         return stored;
     }
 
@@ -287,7 +412,7 @@ namespace MAT_NS_BEGIN {
             m_offlineStorageMemory->ResizeDb();
         }
 
-        if (nullptr != m_offlineStorageDisk)
+        if (nullptr != diskStorage())
         {
             m_offlineStorageDisk->ResizeDb();
         }
@@ -314,7 +439,7 @@ namespace MAT_NS_BEGIN {
 
         if (m_offlineStorageMemory)
         {
-            returnValue |= m_offlineStorageMemory->GetAndReserveRecords(consumer, leaseTimeMs, minLatency, maxCount);
+            returnValue |= getAndReserveVerifiedRecords(*m_offlineStorageMemory, true, consumer, leaseTimeMs, minLatency, maxCount);
             m_lastReadCount += m_offlineStorageMemory->LastReadRecordCount();
             if (m_lastReadCount <= maxCount)
                 maxCount -= m_lastReadCount;
@@ -326,9 +451,9 @@ namespace MAT_NS_BEGIN {
                 return returnValue;
         }
 
-        if (m_offlineStorageDisk)
+        if (diskStorage())
         {
-            returnValue |= m_offlineStorageDisk->GetAndReserveRecords(consumer, leaseTimeMs, minLatency, maxCount);
+            returnValue |= getAndReserveVerifiedRecords(*m_offlineStorageDisk, false, consumer, leaseTimeMs, minLatency, maxCount);
             auto lastOfflineReadCount = m_offlineStorageDisk->LastReadRecordCount();
             if (lastOfflineReadCount)
             {
@@ -347,6 +472,30 @@ namespace MAT_NS_BEGIN {
         return returnValue;
     }
 
+    bool OfflineStorageHandler::getAndReserveVerifiedRecords(IOfflineStorage& storage, bool fromMemory, std::function<bool(StorageRecord&&)> const& consumer, unsigned leaseTimeMs, EventLatency minLatency, unsigned maxCount)
+    {
+        std::vector<StorageRecordId> corruptIds;
+        std::map<std::string, size_t> corruptCounts;
+        bool result = storage.GetAndReserveRecords([&](StorageRecord&& record) -> bool {
+            if (!m_integrity.Verify(record))
+            {
+                // Taken as consumed, so that it is reserved and then deleted below
+                LOG_ERROR("Event %llu failed its integrity check, dropping it", static_cast<unsigned long long>(record.id));
+                corruptIds.push_back(record.id);
+                corruptCounts[record.tenantToken]++;
+                return true;
+            }
+            return consumer(std::move(record));
+        }, leaseTimeMs, minLatency, maxCount);
+
+        if (!corruptIds.empty())
+        {
+            storage.DeleteRecords(corruptIds, HttpHeaders(), fromMemory);
+            OnStorageRecordsDropped(corruptCounts);
+        }
+        return result;
+    }
+
     std::vector<StorageRecord> OfflineStorageHandler::GetRecords(bool shutdown, EventLatency minLatency, unsigned maxCount)
     {
         // This method should not be called directly because it's a no-op
@@ -379,7 +528,7 @@ namespace MAT_NS_BEGIN {
 
     void OfflineStorageHandler::DeleteAllRecords()
     {
-        for (const auto storagePtr : { m_offlineStorageMemory.get() , m_offlineStorageDisk.get() })
+        for (const auto storagePtr : { m_offlineStorageMemory.get() , waitForDiskStorage() })
         {
             if (storagePtr != nullptr)
             {
@@ -402,7 +551,7 @@ namespace MAT_NS_BEGIN {
     /// </remarks>
     void OfflineStorageHandler::DeleteRecords(const std::map<std::string, std::string>& whereFilter)
     {
-        for (const auto storagePtr : {m_offlineStorageMemory.get(), m_offlineStorageDisk.get()})
+        for (const auto storagePtr : {m_offlineStorageMemory.get(), waitForDiskStorage()})
         {
             if (storagePtr != nullptr)
             {
@@ -437,15 +586,15 @@ namespace MAT_NS_BEGIN {
             DeleteRecordsByKeys(m_killSwitchManager.getTokensList());
         }
 
-        LOG_TRACE(" OfflineStorageHandler Deleting %u sent event(s) {%s%s}...",
-                  static_cast<unsigned>(ids.size()), ids.front().c_str(), (ids.size() > 1) ? ", ..." : "");
+        LOG_TRACE(" OfflineStorageHandler Deleting %u sent event(s) {%llu%s}...",
+                  static_cast<unsigned>(ids.size()), static_cast<unsigned long long>(ids.front()), (ids.size() > 1) ? ", ..." : "");
         if (fromMemory && nullptr != m_offlineStorageMemory)
         {
             m_offlineStorageMemory->DeleteRecords(ids, headers, fromMemory);
         }
         else
         {
-            if (nullptr != m_offlineStorageDisk)
+            if (nullptr != diskStorage())
             {
                 m_offlineStorageDisk->DeleteRecords(ids, headers, fromMemory);
             }
@@ -473,7 +622,7 @@ namespace MAT_NS_BEGIN {
         }
         else
         {
-            if (nullptr != m_offlineStorageDisk)
+            if (nullptr != diskStorage())
             {
                 m_offlineStorageDisk->ReleaseRecords(ids, incrementRetryCount, headers, fromMemory);
             }
@@ -482,7 +631,7 @@ namespace MAT_NS_BEGIN {
 
     bool OfflineStorageHandler::StoreSetting(std::string const& name, std::string const& value)
     {
-        if (nullptr != m_offlineStorageDisk)
+        if (nullptr != waitForDiskStorage())
         {
             m_offlineStorageDisk->StoreSetting(name, value);
             return true;
@@ -492,7 +641,7 @@ namespace MAT_NS_BEGIN {
 
     std::string OfflineStorageHandler::GetSetting(std::string const& name)
     {
-        if (nullptr != m_offlineStorageDisk)
+        if (nullptr != waitForDiskStorage())
         {
             return m_offlineStorageDisk->GetSetting(name);
         }
@@ -501,7 +650,7 @@ namespace MAT_NS_BEGIN {
 
     bool OfflineStorageHandler::DeleteSetting(std::string const& name)
     {
-        if (nullptr != m_offlineStorageDisk)
+        if (nullptr != waitForDiskStorage())
         {
             return m_offlineStorageDisk->DeleteSetting(name);
         }
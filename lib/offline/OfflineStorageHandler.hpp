@@ -17,9 +17,11 @@
 #include <atomic>
 #include <list>
 #include <string>
+#include <thread>
 
 #include "KillSwitchManager.hpp"
 #include "ClockSkewManager.hpp"
+#include "RecordIntegrity.hpp"
 
 namespace MAT_NS_BEGIN {
 
@@ -31,6 +33,7 @@ namespace MAT_NS_BEGIN {
         virtual void Initialize(IOfflineStorageObserver& observer) override;
         virtual void Shutdown() override;
         virtual void Flush() override;
+        virtual void FlushForShutdown() override;
         virtual bool StoreRecord(StorageRecord const& record) override;
         virtual size_t StoreRecords(std::vector<StorageRecord> & records) override;
         virtual bool GetAndReserveRecords(std::function<bool(StorageRecord&&)> const& consumer, unsigned leaseTimeMs, EventLatency minLatency = EventLatency_Unspecified, unsigned maxCount = 0) override;
@@ -75,6 +78,30 @@ namespace MAT_NS_BEGIN {
 
         virtual bool isKilled(StorageRecord const& record);
 
+        /// <summary>
+        /// Returns the disk storage once it is initialized, nullptr before that.
+        /// </summary>
+        IOfflineStorage* diskStorage() const;
+
+        /// <summary>
+        /// Returns the disk storage, waiting for a background initialization to finish.
+        /// </summary>
+        IOfflineStorage* waitForDiskStorage() const;
+
+        void initializeDiskStorage();
+
+        /// <summary>
+        /// Moves the records kept in memory to the disk storage, whether activity is paused or not.
+        /// </summary>
+        void flushToDisk();
+
+        /// <summary>
+        /// Reads records from one of the storages, dropping those that fail their integrity check.
+        /// </summary>
+        bool getAndReserveVerifiedRecords(IOfflineStorage& storage, bool fromMemory, std::function<bool(StorageRecord&&)> const& consumer, unsigned leaseTimeMs, EventLatency minLatency, unsigned maxCount);
+
+        RecordIntegrity             m_integrity;
+
         std::mutex                             m_flushLock;
         bool                                   m_flushPending;
         PAL::DeferredCallbackHandle            m_flushHandle;
@@ -82,6 +109,9 @@ namespace MAT_NS_BEGIN {
 
         std::unique_ptr<IOfflineStorage>       m_offlineStorageMemory;
         std::shared_ptr<IOfflineStorage>       m_offlineStorageDisk;
+        std::atomic<bool>                      m_diskStorageReady;
+        PAL::Event                             m_diskStorageInitialized;
+        std::thread                            m_diskStorageInitThread;
 
         bool                                   m_readFromMemory;
         unsigned                               m_lastReadCount;
@@ -240,7 +240,7 @@ namespace MAT_NS_BEGIN
     /**
              * Delete records by identifier.
              *
-             * @param[in] ids A vector of std::string record ids.
+             * @param[in] ids A vector of record ids.
              * @param[out] fromMemory Always false (even when the database
              * is held in memory, which can happen in tests).
              */
@@ -266,30 +266,20 @@ namespace MAT_NS_BEGIN
             ThrowLogic(env, "Unable to get deleteById method");
             size_t index = 0;
 
-            /* Convert string identifiers to int64_t */
-
             env.pushLocalFrame(32);
             std::vector<jlong> roomIds;
             roomIds.reserve(ids.size());
-            for (auto& id : ids)
+            for (auto id : ids)
             {
-                long long n = 0;
-                try
+                auto n = static_cast<jlong>(id);
+                if (n > 0)
                 {
-                    n = std::stoll(id);
-                    if (n > 0)
-                    {
-                        roomIds.push_back(n);
-                    }
+                    roomIds.push_back(n);
                 }
-                catch (std::out_of_range e)
+                else
                 {
                     m_observer->OnStorageFailed("ID out of range");
                 }
-                catch (std::invalid_argument e)
-                {
-                    m_observer->OnStorageFailed("Empty ID");
-                }
             }
             if (roomIds.empty())
             {
@@ -471,7 +461,7 @@ namespace MAT_NS_BEGIN
                     ThrowLogic(env, "get blob storage");
                     uint8_t* end = start + env->GetArrayLength(blob_java);
                     StorageRecord dest(
-                        std::to_string(id_java),
+                        static_cast<StorageRecordId>(id_java),
                         token_utf,
                         latency,
                         persistence,
@@ -620,24 +610,17 @@ namespace MAT_NS_BEGIN
             }
             std::vector<jlong> roomIds;
             roomIds.reserve(ids.size());
-            for (auto const& id : ids)
+            for (auto id : ids)
             {
-                try
+                auto roomId = static_cast<jlong>(id);
+                if (roomId > 0)
                 {
-                    long long roomId = std::stoll(id);
-                    if (roomId > 0)
-                    {
-                        roomIds.push_back(roomId);
-                    }
+                    roomIds.push_back(roomId);
                 }
-                catch (std::out_of_range e)
+                else
                 {
                     m_observer->OnStorageFailed("id out of range");
                 }
-                catch (std::invalid_argument e)
-                {
-                    m_observer->OnStorageFailed("id empty");
-                }
             }
             if (roomIds.empty())
             {
@@ -1223,7 +1206,7 @@ namespace MAT_NS_BEGIN
                 size_t blob_length = env->GetArrayLength(blob_j);
                 auto blob_end = blob_store + blob_length;
                 records.emplace_back(
-                    std::to_string(id_j),
+                    static_cast<StorageRecordId>(id_j),
                     tenant_utf,
                     latency,
                     persistence,
@@ -9,8 +9,9 @@
 #include "ILogManager.hpp"
 #include "SQLiteWrapper.hpp"
 #include "utils/StringUtils.hpp"
+#include "utils/ZlibUtils.hpp"
 #include <algorithm>
-#include <numeric>
+#include <cstdio>
 #include <set>
 
 namespace MAT_NS_BEGIN {
@@ -44,11 +45,49 @@ namespace MAT_NS_BEGIN {
 
     MATSDK_LOG_INST_COMPONENT_CLASS(OfflineStorage_SQLite, "EventsSDK.Storage", "Events telemetry client - OfflineStorage_SQLite class");
 
-    static int const CURRENT_SCHEMA_VERSION = 1;
+    // Version 2 added the "compressed" column, version 3 the "digest" column,
+    // version 4 made "record_id" an integer key (it was a TEXT UUID)
+    static int const CURRENT_SCHEMA_VERSION = 4;
+
+    // Payloads are compressed as they are stored, favor speed over ratio
+    static int const PAYLOAD_COMPRESSION_LEVEL = 1;
 #define TABLE_NAME_EVENTS   "events"
 #define TABLE_NAME_SETTINGS "settings"
 #define TABLE_NAME_PACKAGES "packages"
 
+    // record_id aliases the rowid, looking events up by ID needs no extra index
+#define EVENTS_TABLE_COLUMNS     \
+    "record_id"      " INTEGER PRIMARY KEY," \
+    "tenant_token"   " TEXT NOT NULL,"      \
+    "latency"        " INTEGER,"            \
+    "persistence"    " INTEGER,"            \
+    "timestamp"      " INTEGER,"            \
+    "retry_count"    " INTEGER DEFAULT 0,"  \
+    "reserved_until" " INTEGER DEFAULT 0,"  \
+    "payload"        " BLOB,"               \
+    "compressed"     " INTEGER DEFAULT 0,"  \
+    "digest"         " BLOB"
+
+    /// <summary>
+    /// Compresses a payload for storage. Fails when it would not get smaller,
+    /// the payload is then stored as it is.
+    /// </summary>
+    static bool compressPayload(StorageBlob const& blob, StorageBlob& compressed)
+    {
+        return ZlibUtils::DeflateVector(blob, compressed, false, PAYLOAD_COMPRESSION_LEVEL) && (compressed.size() < blob.size());
+    }
+
+    static bool decompressPayload(StorageBlob& blob)
+    {
+        StorageBlob inflated;
+        if (!ZlibUtils::InflateVector(blob, inflated, false))
+        {
+            return false;
+        }
+        blob.swap(inflated);
+        return true;
+    }
+
     bool OfflineStorage_SQLite::isOpen()
     {
         if ((!m_db) || (!m_isOpened))
@@ -79,6 +118,10 @@ namespace MAT_NS_BEGIN {
         uint32_t ramSizeLimit = m_config[CFG_INT_RAM_QUEUE_SIZE];
         m_DbSizeHeapLimit = ramSizeLimit;
 
+#ifdef HAVE_MAT_ZLIB
+        m_compressPayloads = m_config[CFG_BOOL_ENABLE_DB_COMPRESS];
+#endif
+
         const char* skipSqliteInit = m_config["skipSqliteInitAndShutdown"];
         if (skipSqliteInit != nullptr)
         {
@@ -151,35 +194,95 @@ namespace MAT_NS_BEGIN {
         // TODO: [MG] - this works, but may not play nicely with several LogManager instances
         // static SqliteStatement sql_insert(*m_db, m_stmtInsertEvent_id_tenant_prio_ts_data);
 
-        if (record.id.empty() || record.tenantToken.empty() || static_cast<int>(record.latency) < 0 || record.timestamp <= 0) {
-            LOG_ERROR("Failed to store event %s:%s: Invalid parameters",
-                tenantTokenToId(record.tenantToken).c_str(), record.id.c_str());
-            m_observer->OnStorageFailed("Invalid parameters");
+        if (!IsRecordStorable(record)) {
             return false;
         }
 
-        if (!m_db) {
-            LOG_ERROR("Failed to store event %s:%s: Database is not open",
-                tenantTokenToId(record.tenantToken).c_str(), record.id.c_str());
-            m_observer->OnStorageOpenFailed("Database is not open");
-            return false;
+        {
+#ifdef ENABLE_LOCKING
+            LOCKGUARD(m_lock);
+            DbTransaction transaction(m_db.get());
+            if (!transaction.locked)
+            {
+                LOG_ERROR("Failed to store event %.*s:%llu: Database error", MATSDK_TENANT_ID_ARGS(record.tenantToken), static_cast<unsigned long long>(record.id));
+                m_observer->OnStorageFailed("Database error");
+                return false;
+            }
+#endif
+            InsertRecordUnsafe(record);
+        }
+
+        CheckDbSize();
+        return true;
+
+    }
+
+    size_t OfflineStorage_SQLite::StoreRecords(std::vector<StorageRecord> & records)
+    {
+        size_t stored = 0;
+        for (size_t i = 0; i < records.size(); i++) {
+            if (IsRecordStorable(records[i])) {
+                if (i != stored) {
+                    std::swap(records[stored], records[i]);
+                }
+                ++stored;
+            }
+        }
+        if (stored == 0) {
+            return 0;
         }
 
+        // The whole batch is written in one transaction, so that flushing the
+        // RAM queue costs a single commit instead of one per record
         {
 #ifdef ENABLE_LOCKING
             LOCKGUARD(m_lock);
             DbTransaction transaction(m_db.get());
             if (!transaction.locked)
             {
-                LOG_ERROR("Failed to store event %s:%s: Database error", tenantTokenToId(record.tenantToken).c_str(), record.id.c_str());
+                LOG_ERROR("Failed to store %zu events: Database error", stored);
                 m_observer->OnStorageFailed("Database error");
-                return false;
+                return 0;
             }
 #endif
-            SqliteStatement(*m_db, m_stmtInsertEvent_id_tenant_prio_ts_data).execute(record.id, record.tenantToken, static_cast<int>(record.latency), static_cast<int>(record.persistence), record.timestamp, record.blob);
-            m_DbSizeEstimate += record.id.size() + record.tenantToken.size() + record.blob.size();
+            for (size_t i = 0; i < stored; i++) {
+                InsertRecordUnsafe(records[i]);
+            }
         }
 
+        CheckDbSize();
+        return stored;
+    }
+
+    bool OfflineStorage_SQLite::IsRecordStorable(StorageRecord const& record)
+    {
+        if (record.id == 0 || record.tenantToken.empty() || static_cast<int>(record.latency) < 0 || record.timestamp <= 0) {
+            LOG_ERROR("Failed to store event %s:%llu: Invalid parameters",
+                tenantTokenToId(record.tenantToken).c_str(), static_cast<unsigned long long>(record.id));
+            m_observer->OnStorageFailed("Invalid parameters");
+            return false;
+        }
+
+        if (!m_db) {
+            LOG_ERROR("Failed to store event %s:%llu: Database is not open",
+                tenantTokenToId(record.tenantToken).c_str(), static_cast<unsigned long long>(record.id));
+            m_observer->OnStorageOpenFailed("Database is not open");
+            return false;
+        }
+        return true;
+    }
+
+    void OfflineStorage_SQLite::InsertRecordUnsafe(StorageRecord const& record)
+    {
+        StorageBlob compressed;
+        bool isCompressed = m_compressPayloads && compressPayload(record.blob, compressed);
+        StorageBlob const& payload = isCompressed ? compressed : record.blob;
+        SqliteStatement(*m_db, m_stmtInsertEvent_id_tenant_prio_ts_data).execute(record.id, record.tenantToken, static_cast<int>(record.latency), static_cast<int>(record.persistence), record.timestamp, payload, isCompressed ? 1 : 0, record.digest);
+        m_DbSizeEstimate += sizeof(record.id) + record.tenantToken.size() + payload.size();
+    }
+
+    void OfflineStorage_SQLite::CheckDbSize()
+    {
         if ((m_DbSizeNotificationLimit != 0) && (m_DbSizeEstimate>m_DbSizeNotificationLimit))
         {
             auto now = PAL::getMonotonicTimeMs();
@@ -209,20 +312,6 @@ namespace MAT_NS_BEGIN {
                 m_resizing = false;
             }
         }
-
-        return true;
-
-    }
-
-    size_t OfflineStorage_SQLite::StoreRecords(std::vector<StorageRecord> & records)
-    {
-        size_t stored = 0;
-        for (auto & i : records) {
-            if (StoreRecord(i)) {
-                ++stored;
-            }
-        }
-        return stored;
     }
 
     // Debug routine to print record count in the DB
@@ -287,13 +376,21 @@ namespace MAT_NS_BEGIN {
             }
 
             std::vector<StorageRecordId> consumedIds;
+            std::vector<StorageRecordId> corruptIds;
             std::map<std::string, size_t> deletedData;
 
             StorageRecord record;
             int latency;
+            int compressed;
 
-            while (selectStmt.getRow(record.id, record.tenantToken, latency, record.timestamp, record.retryCount, record.reservedUntil, record.blob))
+            while (selectStmt.getRow(record.id, record.tenantToken, latency, record.timestamp, record.retryCount, record.reservedUntil, record.blob, compressed, record.digest))
             {
+                if (compressed && !decompressPayload(record.blob))
+                {
+                    LOG_ERROR("Failed to decompress event %llu, dropping it", static_cast<unsigned long long>(record.id));
+                    corruptIds.push_back(record.id);
+                    continue;
+                }
                 if (latency < EventLatency_Off || latency > EventLatency_Max) {
                     record.latency = EventLatency_Normal;
                 }
@@ -316,12 +413,17 @@ namespace MAT_NS_BEGIN {
                 return false;
             }
 
+            if (!corruptIds.empty()) {
+                std::vector<uint8_t> idList = packageIdList(corruptIds.begin(), corruptIds.end());
+                SqliteStatement(*m_db, m_stmtDeleteEvents_ids).execute(idList);
+            }
+
             if (consumedIds.empty()) {
                 return false;
             }
 
-            LOG_TRACE("Reserving %u event(s) {%s%s} for %u milliseconds",
-                static_cast<unsigned>(consumedIds.size()), consumedIds.front().c_str(), (consumedIds.size() > 1) ? ", ..." : "", leaseTimeMs);
+            LOG_TRACE("Reserving %u event(s) {%llu%s} for %u milliseconds",
+                static_cast<unsigned>(consumedIds.size()), static_cast<unsigned long long>(consumedIds.front()), (consumedIds.size() > 1) ? ", ..." : "", leaseTimeMs);
 
             for (size_t i = 0; i < consumedIds.size(); i += kBlockSize)
             {
@@ -364,8 +466,14 @@ namespace MAT_NS_BEGIN {
             if (selectStmt.select(static_cast<int>(minLatency), maxCount > 0 ? maxCount : -1))
             {
                 int latency;
-                while (selectStmt.getRow(record.id, record.tenantToken, latency, record.timestamp, record.retryCount, record.reservedUntil, record.blob))
+                int compressed;
+                while (selectStmt.getRow(record.id, record.tenantToken, latency, record.timestamp, record.retryCount, record.reservedUntil, record.blob, compressed, record.digest))
                 {
+                    if (compressed && !decompressPayload(record.blob))
+                    {
+                        LOG_ERROR("Failed to decompress event %llu, skipping it", static_cast<unsigned long long>(record.id));
+                        continue;
+                    }
                     record.latency = static_cast<EventLatency>(latency);
                     records.push_back(record);
                 }
@@ -378,8 +486,14 @@ namespace MAT_NS_BEGIN {
             if (selectStmt.select(static_cast<int>(minLatency), maxCount > 0 ? maxCount : -1))
             {
                 int latency;
-                while (selectStmt.getRow(record.id, record.tenantToken, latency, record.timestamp, record.retryCount, record.reservedUntil, record.blob))
+                int compressed;
+                while (selectStmt.getRow(record.id, record.tenantToken, latency, record.timestamp, record.retryCount, record.reservedUntil, record.blob, compressed, record.digest))
                 {
+                    if (compressed && !decompressPayload(record.blob))
+                    {
+                        LOG_ERROR("Failed to decompress event %llu, skipping it", static_cast<unsigned long long>(record.id));
+                        continue;
+                    }
                     record.latency = static_cast<EventLatency>(latency);
                     records.push_back(record);
                 }
@@ -419,14 +533,14 @@ namespace MAT_NS_BEGIN {
                 for (const auto &kv : whereFilter)
                 {
                     bool quotes = false;
-                    if ((kv.first == "record_id") ||
-                        (kv.first == "tenant_token"))
+                    if (kv.first == "tenant_token")
                     {
                         // string types
                         quotes = true;
                     } 
                     else if (
                         // integer types
+                        (kv.first == "record_id") ||
                         (kv.first == "latency") ||
                         (kv.first == "persistence") ||
                         (kv.first == "retry_count"))
@@ -460,8 +574,8 @@ namespace MAT_NS_BEGIN {
         }
 
         if (!m_db) {
-            LOG_ERROR("Failed to delete %u sent event(s) {%s%s}: Database is not open",
-                static_cast<unsigned>(ids.size()), ids.front().c_str(), (ids.size() > 1) ? ", ..." : "");
+            LOG_ERROR("Failed to delete %u sent event(s) {%llu%s}: Database is not open",
+                static_cast<unsigned>(ids.size()), static_cast<unsigned long long>(ids.front()), (ids.size() > 1) ? ", ..." : "");
             return;
         }
 
@@ -476,7 +590,7 @@ namespace MAT_NS_BEGIN {
                 return;
             }
 #endif
-            LOG_TRACE("Deleting %u sent event(s) {%s%s}...", static_cast<unsigned>(ids.size()), ids.front().c_str(), (ids.size() > 1) ? ", ..." : "");
+            LOG_TRACE("Deleting %u sent event(s) {%llu%s}...", static_cast<unsigned>(ids.size()), static_cast<unsigned long long>(ids.front()), (ids.size() > 1) ? ", ..." : "");
 
             for (size_t i = 0; i < ids.size(); i += kBlockSize) {
                 size_t count = std::min(kBlockSize, ids.size() - i);
@@ -484,8 +598,8 @@ namespace MAT_NS_BEGIN {
                                                             ids.begin() + i + count);
                 if (!SqliteStatement(*m_db, m_stmtDeleteEvents_ids).execute(idList)) {
                     LOG_ERROR(
-                            "Failed to delete %u sent event(s) {%s%s}: Database error occurred, recreating database",
-                            static_cast<unsigned>(ids.size()), ids.front().c_str(),
+                            "Failed to delete %u sent event(s) {%llu%s}: Database error occurred, recreating database",
+                            static_cast<unsigned>(ids.size()), static_cast<unsigned long long>(ids.front()),
                             (ids.size() > 1) ? ", ..." : "");
                     recreate(302);
                     return;
@@ -503,8 +617,8 @@ namespace MAT_NS_BEGIN {
             return;
         }
         if (!m_db) {
-            LOG_ERROR("Failed to release %u event(s) {%s%s}, retry count %s: Database is not open",
-                static_cast<unsigned>(ids.size()), ids.front().c_str(), (ids.size() > 1) ? ", ..." : "", incrementRetryCount ? "+1" : "not changed");
+            LOG_ERROR("Failed to release %u event(s) {%llu%s}, retry count %s: Database is not open",
+                static_cast<unsigned>(ids.size()), static_cast<unsigned long long>(ids.front()), (ids.size() > 1) ? ", ..." : "", incrementRetryCount ? "+1" : "not changed");
             return;
         }
 
@@ -518,8 +632,8 @@ namespace MAT_NS_BEGIN {
                 return;
             }
 #endif
-            LOG_TRACE("Releasing %u event(s) {%s%s}, retry count %s...",
-                static_cast<unsigned>(ids.size()), ids.front().c_str(), (ids.size() > 1) ? ", ..." : "", incrementRetryCount ? "+1" : "not changed");
+            LOG_TRACE("Releasing %u event(s) {%llu%s}, retry count %s...",
+                static_cast<unsigned>(ids.size()), static_cast<unsigned long long>(ids.front()), (ids.size() > 1) ? ", ..." : "", incrementRetryCount ? "+1" : "not changed");
 
             SqliteStatement releaseStmt(*m_db, m_stmtReleaseEvents_ids_retryCountDelta);
             for (size_t i = 0; i < ids.size(); i += kBlockSize) {
@@ -527,8 +641,8 @@ namespace MAT_NS_BEGIN {
                 std::vector<uint8_t> idList = packageIdList(ids.begin() + i, ids.begin() + i + count);
                 if (!releaseStmt.execute(idList, incrementRetryCount ? 1 : 0)) {
                     LOG_ERROR(
-                            "Failed to release %u event(s) {%s%s}, retry count %s: Database error occurred, recreating database",
-                            static_cast<unsigned>(ids.size()), ids.front().c_str(),
+                            "Failed to release %u event(s) {%llu%s}, retry count %s: Database error occurred, recreating database",
+                            static_cast<unsigned>(ids.size()), static_cast<unsigned long long>(ids.front()),
                             (ids.size() > 1) ? ", ..." : "",
                             incrementRetryCount ? "+1" : "not changed");
                     recreate(403);
@@ -730,20 +844,36 @@ namespace MAT_NS_BEGIN {
         }
 
         if (!SqliteStatement(*m_db,
-            "CREATE TABLE IF NOT EXISTS " TABLE_NAME_EVENTS " ("
-            "record_id"      " TEXT,"
-            "tenant_token"   " TEXT NOT NULL,"
-            "latency"        " INTEGER,"
-            "persistence"    " INTEGER,"
-            "timestamp"      " INTEGER,"
-            "retry_count"    " INTEGER DEFAULT 0,"
-            "reserved_until" " INTEGER DEFAULT 0,"
-            "payload"        " BLOB"
-            ")"
+            "CREATE TABLE IF NOT EXISTS " TABLE_NAME_EVENTS " (" EVENTS_TABLE_COLUMNS ")"
         ).execute()) {
             return false;
         }
 
+        if ((openedDbVersion == 1) && !SqliteStatement(*m_db,
+            "ALTER TABLE " TABLE_NAME_EVENTS " ADD COLUMN compressed INTEGER DEFAULT 0"
+        ).execute()) {
+            return false;
+        }
+
+        if ((openedDbVersion == 1 || openedDbVersion == 2) && !SqliteStatement(*m_db,
+            "ALTER TABLE " TABLE_NAME_EVENTS " ADD COLUMN digest BLOB"
+        ).execute()) {
+            return false;
+        }
+
+        // Older IDs were UUID strings: copy the events into the new table, which
+        // numbers them. Generated IDs are above 2^62, so they cannot collide.
+        if ((openedDbVersion >= 1 && openedDbVersion <= 3) && !(
+            SqliteStatement(*m_db, "ALTER TABLE " TABLE_NAME_EVENTS " RENAME TO " TABLE_NAME_EVENTS "_v3").execute() &&
+            SqliteStatement(*m_db, "CREATE TABLE " TABLE_NAME_EVENTS " (" EVENTS_TABLE_COLUMNS ")").execute() &&
+            SqliteStatement(*m_db,
+                "INSERT INTO " TABLE_NAME_EVENTS " (tenant_token,latency,persistence,timestamp,retry_count,reserved_until,payload,compressed,digest)"
+                " SELECT tenant_token,latency,persistence,timestamp,retry_count,reserved_until,payload,compressed,digest"
+                " FROM " TABLE_NAME_EVENTS "_v3").execute() &&
+            SqliteStatement(*m_db, "DROP TABLE " TABLE_NAME_EVENTS "_v3").execute())) {
+            return false;
+        }
+
         if (!SqliteStatement(*m_db,
             "CREATE INDEX IF NOT EXISTS k_latency_timestamp ON " TABLE_NAME_EVENTS
             " (latency DESC, persistence DESC, timestamp ASC)"
@@ -818,17 +948,17 @@ namespace MAT_NS_BEGIN {
             " SET reserved_until=0, retry_count=retry_count+1"
             " WHERE reserved_until<>0 AND reserved_until<=?");
         PREPARE_SQL(m_stmtSelectEvents,
-            "SELECT record_id,tenant_token,latency,timestamp,retry_count,reserved_until,payload"
+            "SELECT record_id,tenant_token,latency,timestamp,retry_count,reserved_until,payload,compressed,digest"
             " FROM " TABLE_NAME_EVENTS
             " WHERE latency>=? AND reserved_until=0"
             " ORDER BY latency DESC,persistence DESC, timestamp ASC LIMIT ?");
         PREPARE_SQL(m_stmtSelectEventAtShutdown,
-            "SELECT record_id,tenant_token,latency,timestamp,retry_count,reserved_until,payload"
+            "SELECT record_id,tenant_token,latency,timestamp,retry_count,reserved_until,payload,compressed,digest"
             " FROM " TABLE_NAME_EVENTS
             " WHERE latency>=?"
             " ORDER BY latency DESC,persistence DESC, timestamp ASC LIMIT ?");
         PREPARE_SQL(m_stmtSelectEventsMinlatency,
-            "SELECT record_id,tenant_token,latency,timestamp,retry_count,reserved_until,payload"
+            "SELECT record_id,tenant_token,latency,timestamp,retry_count,reserved_until,payload,compressed,digest"
             " FROM " TABLE_NAME_EVENTS
             " WHERE latency=(SELECT MIN(latency) FROM " TABLE_NAME_EVENTS " WHERE reserved_until=0 AND latency>=?) AND reserved_until=0"
             " ORDER BY timestamp ASC LIMIT ?");
@@ -850,7 +980,7 @@ namespace MAT_NS_BEGIN {
             "DELETE FROM " TABLE_NAME_EVENTS
             " WHERE retry_count>?");
         PREPARE_SQL(m_stmtInsertEvent_id_tenant_prio_ts_data,
-            "REPLACE INTO " TABLE_NAME_EVENTS " (record_id,tenant_token,latency,persistence,timestamp,payload) VALUES (?,?,?,?,?,?)");
+            "REPLACE INTO " TABLE_NAME_EVENTS " (record_id,tenant_token,latency,persistence,timestamp,payload,compressed,digest) VALUES (?,?,?,?,?,?,?,?)");
         PREPARE_SQL(m_stmtInsertSetting_name_value,
             "REPLACE INTO " TABLE_NAME_SETTINGS " (name,value) VALUES (?,?)");
         PREPARE_SQL(m_stmtDeleteSetting_name,
@@ -979,21 +1109,19 @@ namespace MAT_NS_BEGIN {
     }
 
     std::vector<uint8_t> OfflineStorage_SQLite::packageIdList(
-        std::vector<std::string>::const_iterator const & begin,
-        std::vector<std::string>::const_iterator const & end) const
+        std::vector<StorageRecordId>::const_iterator const & begin,
+        std::vector<StorageRecordId>::const_iterator const & end) const
     {
-        size_t size = std::accumulate(begin, end, size_t(0), [](size_t sum, std::string const& id) -> size_t {
-            return sum + id.length() + 1;
-        });
-
         std::vector<uint8_t> result;
-        result.reserve(size);
+        result.reserve(static_cast<size_t>(end - begin) * 20);
 
+        // Decimal text, as the tokenizer hands out strings. Signed, as IDs are
+        // bound as int64 and the ones from 2^63 up are stored negative.
+        char buffer[24];
         for (auto i = begin; i != end; ++i)
         {
-            std::string const & id(*i);
-            uint8_t const* ptr = reinterpret_cast<uint8_t const*>(id.c_str());
-            result.insert(result.end(), ptr, ptr + id.size() + 1);
+            int length = snprintf(buffer, sizeof(buffer), "%lld", static_cast<long long>(*i));
+            result.insert(result.end(), buffer, buffer + length + 1);
         }
 
         return result;
@@ -57,8 +57,8 @@ namespace MAT_NS_BEGIN {
         bool recreate(unsigned failureCode);
 
         std::vector<uint8_t> packageIdList(
-            std::vector<std::string>::const_iterator const & begin,
-            std::vector<std::string>::const_iterator const & end) const;
+            std::vector<StorageRecordId>::const_iterator const & begin,
+            std::vector<StorageRecordId>::const_iterator const & end) const;
 
         // Debug routine to print record count in the DB
         void printRecordCount();
@@ -76,6 +76,7 @@ namespace MAT_NS_BEGIN {
 
         bool                        m_skipInitAndShutdown {};
         bool                        m_isOpened {};
+        bool                        m_compressPayloads {};
 
         std::mutex                  m_resizeLock{};
         std::atomic<bool>           m_resizing{false};
@@ -122,6 +123,15 @@ namespace MAT_NS_BEGIN {
 
     private:
         size_t GetRecordCountUnsafe(EventLatency latency) const;
+
+        // Reports records which cannot be stored to the observer
+        bool IsRecordStorable(StorageRecord const& record);
+
+        // Must be called with m_lock held, inside a transaction
+        void InsertRecordUnsafe(StorageRecord const& record);
+
+        // Notifies when the DB is getting full and trims it when over the limit
+        void CheckDbSize();
     };
 
 
@@ -0,0 +1,89 @@
+//
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// SPDX-License-Identifier: Apache-2.0
+//
+#include "RecordIntegrity.hpp"
+#include "utils/Crc32c.hpp"
+#include "utils/Sha256.hpp"
+
+#include <cstring>
+
+namespace MAT_NS_BEGIN {
+
+    MATSDK_LOG_INST_COMPONENT_CLASS(RecordIntegrity, "EventsSDK.RecordIntegrity", "Events telemetry client - RecordIntegrity class");
+
+    // The digest size tells how a record was signed
+    static size_t const CRC32C_DIGEST_SIZE = 4;
+
+    RecordIntegrity::RecordIntegrity() :
+        m_mode(Mode::None)
+    {
+    }
+
+    RecordIntegrity::RecordIntegrity(IRuntimeConfig& config) :
+        m_mode(Mode::None)
+    {
+        char const* key = config[CFG_STR_HMAC_KEY];
+        if ((key != nullptr) && (*key != '\0'))
+        {
+            m_key.assign(key, key + strlen(key));
+        }
+
+        if (config[CFG_BOOL_ENABLE_HMAC])
+        {
+            if (!m_key.empty())
+            {
+                m_mode = Mode::HmacSha256;
+                return;
+            }
+            LOG_WARN("HMAC of stored events requires %s, using CRC-32C instead", CFG_STR_HMAC_KEY);
+            m_mode = Mode::Crc32c;
+        }
+        else if (config[CFG_BOOL_ENABLE_CRC32])
+        {
+            m_mode = Mode::Crc32c;
+        }
+    }
+
+    void RecordIntegrity::Sign(StorageRecord& record) const
+    {
+        switch (m_mode)
+        {
+        case Mode::Crc32c:
+        {
+            uint32_t crc = Crc32c::Compute(record.blob.data(), record.blob.size());
+            record.digest = {
+                static_cast<uint8_t>(crc >> 24), static_cast<uint8_t>(crc >> 16),
+                static_cast<uint8_t>(crc >> 8), static_cast<uint8_t>(crc) };
+            break;
+        }
+        case Mode::HmacSha256:
+            record.digest = Sha256::Hmac(m_key, record.blob.data(), record.blob.size());
+            break;
+        case Mode::None:
+            record.digest.clear();
+            break;
+        }
+    }
+
+    bool RecordIntegrity::Verify(StorageRecord const& record) const
+    {
+        if (record.digest.size() == CRC32C_DIGEST_SIZE)
+        {
+            uint32_t crc = Crc32c::Compute(record.blob.data(), record.blob.size());
+            return (record.digest[0] == static_cast<uint8_t>(crc >> 24)) && (record.digest[1] == static_cast<uint8_t>(crc >> 16)) &&
+                   (record.digest[2] == static_cast<uint8_t>(crc >> 8)) && (record.digest[3] == static_cast<uint8_t>(crc));
+        }
+        if (record.digest.size() == Sha256::DigestSize)
+        {
+            if (m_key.empty())
+            {
+                // Signed with a key that is no longer configured, nothing to check against
+                return true;
+            }
+            return Sha256::Hmac(m_key, record.blob.data(), record.blob.size()) == record.digest;
+        }
+        return record.digest.empty();
+    }
+
+} MAT_NS_END
@@ -0,0 +1,66 @@
+//
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// SPDX-License-Identifier: Apache-2.0
+//
+#ifndef RECORDINTEGRITY_HPP
+#define RECORDINTEGRITY_HPP
+
+#include "pal/PAL.hpp"
+#include "IOfflineStorage.hpp"
+#include "api/IRuntimeConfig.hpp"
+
+namespace MAT_NS_BEGIN {
+
+    /// <summary>
+    /// Signs serialized records with a digest of their blob and checks it when
+    /// they are read back from storage, so that records corrupted in the cache
+    /// are dropped instead of being uploaded.
+    ///
+    /// CFG_BOOL_ENABLE_CRC32 selects CRC-32C. CFG_BOOL_ENABLE_HMAC together with
+    /// CFG_STR_HMAC_KEY selects HMAC-SHA256, which also detects changes made
+    /// without the key. Records are checked whatever the current setting is,
+    /// as long as they carry a digest.
+    /// </summary>
+    class RecordIntegrity
+    {
+    public:
+        enum class Mode
+        {
+            None,
+            Crc32c,
+            HmacSha256
+        };
+
+        /// <summary>
+        /// Verifies existing digests but does not sign new records.
+        /// </summary>
+        RecordIntegrity();
+
+        explicit RecordIntegrity(IRuntimeConfig& config);
+
+        Mode GetMode() const
+        {
+            return m_mode;
+        }
+
+        /// <summary>
+        /// Sets the digest of a record from its current blob.
+        /// </summary>
+        void Sign(StorageRecord& record) const;
+
+        /// <summary>
+        /// Checks the digest of a record.
+        /// </summary>
+        /// <returns>false if the record has a digest which does not match its blob</returns>
+        bool Verify(StorageRecord const& record) const;
+
+    protected:
+        MATSDK_LOG_DECL_COMPONENT_CLASS();
+
+        Mode                 m_mode;
+        std::vector<uint8_t> m_key;
+    };
+
+} MAT_NS_END
+
+#endif
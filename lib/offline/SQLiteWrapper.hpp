@@ -639,6 +639,11 @@ namespace MAT_NS_BEGIN {
             return g_sqlite3Proxy->sqlite3_bind_int64(m_stmt, idx, arg);
         }
 
+        int bind(int idx, uint64_t arg)
+        {
+            return g_sqlite3Proxy->sqlite3_bind_int64(m_stmt, idx, static_cast<int64_t>(arg));
+        }
+
         int bind(int idx, std::string const& arg)
         {
             return g_sqlite3Proxy->sqlite3_bind_text(m_stmt, idx, arg.data(), static_cast<int>(arg.size()), SQLITE_STATIC);
@@ -682,6 +687,11 @@ namespace MAT_NS_BEGIN {
             output = g_sqlite3Proxy->sqlite3_column_int64(m_stmt, idx);
         }
 
+        void retrieve(int idx, uint64_t& output)
+        {
+            output = static_cast<uint64_t>(g_sqlite3Proxy->sqlite3_column_int64(m_stmt, idx));
+        }
+
         void retrieve(int idx, std::string& output)
         {
             int len = g_sqlite3Proxy->sqlite3_column_bytes(m_stmt, idx);
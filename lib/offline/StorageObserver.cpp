@@ -41,6 +41,43 @@ namespace MAT_NS_BEGIN {
         return true;
     }
 
+    bool StorageObserver::handleStoreRecords(std::vector<IncomingEventContextPtr>& events)
+    {
+        StorageRecordVector records;
+        records.reserve(events.size());
+        const auto timestamp = PAL::getUtcSystemTimeMs();
+        for (const auto& ctx : events)
+        {
+            ctx->record.timestamp = timestamp;
+            records.push_back(ctx->record);
+        }
+
+        const size_t stored = m_offlineStorage.StoreRecords(records);
+        if (stored != events.size())
+        {
+            // Stored records are at the front of the vector in their original order,
+            // everything else is reported as failed and removed from the batch.
+            std::vector<IncomingEventContextPtr> accepted;
+            accepted.reserve(stored);
+            size_t next = 0;
+            for (const auto& ctx : events)
+            {
+                if ((next < stored) && (records[next].id == ctx->record.id))
+                {
+                    accepted.push_back(ctx);
+                    ++next;
+                }
+                else
+                {
+                    // stats implementation must trigger a failure notification
+                    storeRecordFailed(ctx);
+                }
+            }
+            events.swap(accepted);
+        }
+        return !events.empty();
+    }
+
     void StorageObserver::handleRetrieveEvents(EventsUploadContextPtr const& ctx)
     {
         auto consumer = [&ctx, this](StorageRecord&& record) -> bool {
@@ -69,12 +106,7 @@ namespace MAT_NS_BEGIN {
         {
             headers = ctx->httpResponse->GetHeaders();
         }
-        std::vector<StorageRecordId> recordIds;
-        for (const auto& item : ctx->recordIdsAndTenantIds)
-        {
-            recordIds.push_back(item.first);
-        }
-        m_offlineStorage.DeleteRecords(recordIds, headers, ctx->fromMemory);
+        m_offlineStorage.DeleteRecords(ctx->recordIdsAndTenantIds.ids(), headers, ctx->fromMemory);
         return true;
     }
 
@@ -88,12 +120,7 @@ namespace MAT_NS_BEGIN {
         {
             headers = ctx->httpResponse->GetHeaders();
         }
-        std::vector<StorageRecordId> recordIds;
-        for (const auto& item : ctx->recordIdsAndTenantIds)
-        {
-            recordIds.push_back(item.first);
-        }
-        m_offlineStorage.ReleaseRecords(recordIds, false, headers, ctx->fromMemory);
+        m_offlineStorage.ReleaseRecords(ctx->recordIdsAndTenantIds.ids(), false, headers, ctx->fromMemory);
         return true;
     }
 
@@ -105,13 +132,7 @@ namespace MAT_NS_BEGIN {
         {
             headers = ctx->httpResponse->GetHeaders();
         }
-        std::vector<StorageRecordId> recordIds;
-        for (const auto& item : ctx->recordIdsAndTenantIds)
-        {
-            recordIds.push_back(item.first);
-        }
-
-        m_offlineStorage.ReleaseRecords(recordIds, true, headers, ctx->fromMemory);
+        m_offlineStorage.ReleaseRecords(ctx->recordIdsAndTenantIds.ids(), true, headers, ctx->fromMemory);
         return true;
     }
 
@@ -31,6 +31,7 @@ namespace MAT_NS_BEGIN {
         bool handleStop();
 
         bool handleStoreRecord(IncomingEventContextPtr const& ctx);
+        bool handleStoreRecords(std::vector<IncomingEventContextPtr>& events);
         void handleRetrieveEvents(EventsUploadContextPtr const& ctx);
 
         bool handleDeleteRecords(EventsUploadContextPtr const& ctx);
@@ -62,11 +63,17 @@ namespace MAT_NS_BEGIN {
             return m_offlineStorage.GetRecordCount();
         }
 
+        void FlushForShutdown()
+        {
+            m_offlineStorage.FlushForShutdown();
+        }
+
         RoutePassThrough<StorageObserver>                                        start{ this, &StorageObserver::handleStart };
         RoutePassThrough<StorageObserver>                                        stop{ this, &StorageObserver::handleStop };
 
         RouteSource<IncomingEventContextPtr const&>                              storeRecordFailed;
         RoutePassThrough<StorageObserver, IncomingEventContextPtr const&>        storeRecord{ this, &StorageObserver::handleStoreRecord };
+        RoutePassThrough<StorageObserver, std::vector<IncomingEventContextPtr>&> storeRecords{ this, &StorageObserver::handleStoreRecords };
 
         RouteSink<StorageObserver, EventsUploadContextPtr const&>                retrieveEvents{ this, &StorageObserver::handleRetrieveEvents };
         RouteSource<EventsUploadContextPtr const&, StorageRecord const&, bool&>  retrievedEvent;
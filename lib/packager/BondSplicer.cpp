@@ -37,17 +37,22 @@ size_t BondSplicer::getSizeEstimate() const
 std::vector<uint8_t> BondSplicer::splice() const
 {
     std::vector<uint8_t> output;
+    output.reserve(m_buffer.size());
     bond_lite::CompactBinaryProtocolWriter writer(output);
 
-    if (!m_packages.empty()) {
-        for (PackageInfo const& package : m_packages) {
-            if (!package.records.empty()) {
-                for (Span const& record : package.records) {
-                    writer.WriteBlob(m_buffer.data() + record.offset, record.length);
-                }
-            } 
+    // Records of a tenant mostly follow each other in the buffer, copy them in runs
+    for (PackageInfo const& package : m_packages) {
+        Span run{ 0, 0 };
+        for (Span const& record : package.records) {
+            if (run.offset + run.length != record.offset) {
+                writer.WriteBlob(m_buffer.data() + run.offset, run.length);
+                run = record;
+            } else {
+                run.length += record.length;
+            }
         }
-    } 
+        writer.WriteBlob(m_buffer.data() + run.offset, run.length);
+    }
 
     return output;
 }
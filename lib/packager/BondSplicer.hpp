@@ -9,7 +9,6 @@
 #include "DataPackage.hpp"
 #include "ISplicer.hpp"
 
-#include <list>
 #include <vector>
 
 namespace MAT_NS_BEGIN {
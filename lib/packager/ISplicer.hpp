@@ -8,7 +8,6 @@
 #include "pal/PAL.hpp"
 #include "DataPackage.hpp"
 
-#include <list>
 #include <vector>
 
 namespace MAT_NS_BEGIN {
@@ -23,7 +22,7 @@ class ISplicer
     struct PackageInfo {
         std::string     tenantToken;
         Span            header;
-        std::list<Span> records;
+        std::vector<Span> records;
     };
 
   public:
@@ -28,9 +28,10 @@ namespace MAT_NS_BEGIN {
             }
             if (ctx->splicer->getSizeEstimate() + record.blob.size() > ctx->maxUploadSize) {
                 wantMore = false;
+                ctx->packageFull = true;
                 if (!ctx->recordIdsAndTenantIds.empty()) {
-                    LOG_TRACE("Maximum upload size %u bytes exceeded, not adding the next event (ID %s, size %u bytes)",
-                        ctx->maxUploadSize, record.id.c_str(), static_cast<unsigned>(record.blob.size()));
+                    LOG_TRACE("Maximum upload size %u bytes exceeded, not adding the next event (ID %llu, size %u bytes)",
+                        ctx->maxUploadSize, static_cast<unsigned long long>(record.id), static_cast<unsigned>(record.blob.size()));
                     return;
                 }
                 else {
@@ -45,23 +46,29 @@ namespace MAT_NS_BEGIN {
                     ctx->latency, latencyToStr(ctx->latency));
             }
 
-            LOG_TRACE("Adding event %s:%s, size %u bytes",
-                tenantTokenToId(record.tenantToken).c_str(), record.id.c_str(), static_cast<unsigned>(record.blob.size()));
+            LOG_TRACE("Adding event %s:%llu, size %u bytes",
+                tenantTokenToId(record.tenantToken).c_str(), static_cast<unsigned long long>(record.id), static_cast<unsigned>(record.blob.size()));
 
             #ifdef HAVE_MAT_EVT_TRACEID
                         ctx->traceId = record.traceId;
             #endif // HAVE_MAT_EVT_TRACEID
 
-            std::string const& tenantToken = m_forcedTenantToken.empty() ? record.tenantToken : m_forcedTenantToken;
-            auto it = ctx->packageIds.lower_bound(tenantToken);
-            if (it == ctx->packageIds.end() || it->first != tenantToken)
+            size_t tenant = ctx->recordIdsAndTenantIds.addTenant(record.tenantToken);
+            if (tenant == ctx->tenantPackages.size())
             {
-                it = ctx->packageIds.insert(it, { tenantToken, ctx->splicer->addTenantToken(tenantToken) });
+                // First record of this tenant, all of a forced tenant share one package
+                std::string const& tenantToken = m_forcedTenantToken.empty() ? record.tenantToken : m_forcedTenantToken;
+                auto it = ctx->packageIds.lower_bound(tenantToken);
+                if (it == ctx->packageIds.end() || it->first != tenantToken)
+                {
+                    it = ctx->packageIds.insert(it, { tenantToken, ctx->splicer->addTenantToken(tenantToken) });
+                }
+                ctx->tenantPackages.push_back(it->second);
             }
 
-            ctx->splicer->addRecord(it->second, record.blob);
+            ctx->splicer->addRecord(ctx->tenantPackages[tenant], record.blob);
 
-            ctx->recordIdsAndTenantIds[record.id] = record.tenantToken;
+            ctx->recordIdsAndTenantIds.add(record.id, tenant);
             ctx->recordTimestamps.push_back(record.timestamp);
             ctx->maxRetryCountSeen = std::max<int>(ctx->maxRetryCountSeen, record.retryCount);
         }
@@ -10,6 +10,15 @@
 #include "ctmacros.hpp"
 #include "typename.hpp"
 
+#include <atomic>
+
+// Most verbose level of the trace statements compiled in, the others are compiled
+// out: 0 none, 1 errors, 2 warnings, 3 info, 4 detail (default). Set by the
+// TRACE_LEVEL_MAX CMake option, or per translation unit before this header.
+#ifndef MATSDK_LOG_LEVEL_MAX
+#define MATSDK_LOG_LEVEL_MAX 4
+#endif
+
 namespace PAL_NS_BEGIN
 {
 
@@ -52,13 +61,36 @@ namespace PAL_NS_BEGIN
 
     namespace detail {
         extern LogLevel g_logLevel;
+
+        // Most verbose level set for any single component, 0 if there is none
+        extern std::atomic<int> g_componentLogLevelMax;
+
+        extern bool isComponentLogEnabled(char const* component, LogLevel level) noexcept;
         extern void log(LogLevel level, char const* component, char const* fmt, ...);
     } // namespace detail
 
+    /// <summary>
+    /// Sets the level of one component, by name, in place of the global level.
+    /// Returns false if too many components have their own level already.
+    /// </summary>
+    bool setComponentLogLevel(char const* component, LogLevel level);
+
+    /// <summary>
+    /// All components follow the global level again.
+    /// </summary>
+    void resetComponentLogLevels();
+
 #define MATSDK_SET_LOG_LEVEL_(level_) (PAL::detail::g_logLevel = (level_))
 
 // Check if logging is enabled on a specific level
-#define MATSDK_LOG_ENABLED_(level_)   (PAL::detail::g_logLevel >= (level_))
+#define MATSDK_LOG_ENABLED_(level_)   ((level_) <= MATSDK_LOG_LEVEL_MAX && PAL::detail::g_logLevel >= (level_))
+
+// Check if logging may be enabled for some component on a specific level, cheap
+// enough to be done before the component and the arguments are evaluated
+#define MATSDK_LOG_MAYBE_ENABLED_(level_)                                        \
+    ((level_) <= MATSDK_LOG_LEVEL_MAX &&                                         \
+     (PAL::detail::g_logLevel >= (level_) ||                                     \
+      PAL::detail::g_componentLogLevelMax.load(std::memory_order_relaxed) >= (level_)))
 
 #define MATSDK_LOG_ENABLED_DETAIL()   MATSDK_LOG_ENABLED_(PAL::Detail)
 #define MATSDK_LOG_ENABLED_INFO()     MATSDK_LOG_ENABLED_(PAL::Info)
@@ -67,8 +99,11 @@ namespace PAL_NS_BEGIN
 
 // Log a message on a specific level, which is checked efficiently before evaluating arguments
 #define MATSDK_LOG_(level_, comp_, fmt_, ...)                                    \
-    if (MATSDK_LOG_ENABLED_(level_)) {                                           \
-        PAL::detail::log((level_), (comp_), (fmt_), ##__VA_ARGS__); \
+    if (MATSDK_LOG_MAYBE_ENABLED_(level_)) {                                     \
+        char const* matsdkLogComponent_ = (comp_);                               \
+        if (PAL::detail::isComponentLogEnabled(matsdkLogComponent_, (level_))) { \
+            PAL::detail::log((level_), matsdkLogComponent_, (fmt_), ##__VA_ARGS__); \
+        }                                                                        \
     } else static_cast<void>(0)
 
 } PAL_NS_END // namespace PAL
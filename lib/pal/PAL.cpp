@@ -3,6 +3,7 @@
 // SPDX-License-Identifier: Apache-2.0
 //
 #include "PAL.hpp"
+#include "TraceWriter.hpp"
 
 #include "ILogManager.hpp"
 #include "ISemanticContext.hpp"
@@ -10,17 +11,15 @@
 #include "utils/StringUtils.hpp"
 
 #include <algorithm>
+#include <cstring>
 #include <list>
 #include <memory>
 #include <chrono>
 #include <thread>
 
 #include <iostream>
-#include <sstream>
 #include <fstream>
 
-#include <iomanip>
-
 #include <stdarg.h>
 
 #include "utils/Utils.hpp"
@@ -87,62 +86,71 @@ namespace PAL_NS_BEGIN {
 
 #define DBG_BUFFER_LEN      2048
 
-#ifndef _WIN32
-#define DEBUG_LOG_NULL      "/dev/null"
-#else
-#define DEBUG_LOG_NULL      "NUL"
-#endif
+/* Components that may have a level of their own at the same time */
+#define MAX_COMPONENT_LOG_LEVELS    32
+#define MAX_COMPONENT_NAME_LEN      64
 
         bool isLoggingInited = false;
 
-#ifdef HAVE_MAT_LOGGING
-        std::recursive_mutex          debugLogMutex;
-        std::string                   debugLogPath;
-        std::unique_ptr<std::fstream> debugLogStream;
+        std::atomic<int> g_componentLogLevelMax(0);
 
-        bool log_init(bool isTraceEnabled, const std::string& traceFolderPath)
+        // Slots are only ever added and their names never change, so that readers need no lock
+        struct ComponentLogLevel
         {
-            if (!isTraceEnabled)
+            char             component[MAX_COMPONENT_NAME_LEN];
+            std::atomic<int> level;     // -1 to follow g_logLevel
+        };
+
+        static ComponentLogLevel   componentLogLevels[MAX_COMPONENT_LOG_LEVELS];
+        static std::atomic<size_t> componentLogLevelCount(0);
+        static std::mutex          componentLogLevelsLock;
+
+        bool isComponentLogEnabled(char const* component, LogLevel level) noexcept
+        {
+            size_t count = componentLogLevelCount.load(std::memory_order_acquire);
+            for (size_t i = 0; i < count; i++)
             {
-                return false;
+                if (strcmp(componentLogLevels[i].component, component) == 0)
+                {
+                    int componentLevel = componentLogLevels[i].level.load(std::memory_order_relaxed);
+                    if (componentLevel >= 0)
+                    {
+                        return componentLevel >= level;
+                    }
+                    break;
+                }
             }
+            return g_logLevel >= level;
+        }
 
-            bool result = true;
-            if (debugLogStream != nullptr)
+#ifdef HAVE_MAT_LOGGING
+        TraceWriter& getTraceWriter()
+        {
+            static TraceWriter writer;
+            return writer;
+        }
+
+        bool log_init(bool isTraceEnabled, const std::string& traceFolderPath, size_t maxFileSize)
+        {
+            if (!isTraceEnabled)
             {
-                return result;
+                return false;
             }
 
-            debugLogMutex.lock();
-            debugLogPath = traceFolderPath;
+            std::string debugLogPath = traceFolderPath;
             debugLogPath += "mat-debug-";
             debugLogPath += std::to_string(MAT::GetCurrentProcessId());
             debugLogPath += ".log";
-
-            debugLogStream = std::unique_ptr<std::fstream>(new std::fstream());
-            debugLogStream->open(debugLogPath, std::fstream::out);
-            if (!debugLogStream->is_open())
-            {
-                // If file cannot be created, log to /dev/null
-                debugLogStream->open(DEBUG_LOG_NULL);
-                result = false;
-            }
-            debugLogMutex.unlock();
-            return result;
+            return getTraceWriter().Start(debugLogPath, maxFileSize);
         }
 
         void log_done()
         {
-            debugLogMutex.lock();
-            if (debugLogStream)
-            {
-                debugLogStream = nullptr;
-                isLoggingInited = false;
-            }
-            debugLogMutex.unlock();
+            isLoggingInited = false;
+            getTraceWriter().Stop();
         }
 #else
-        bool log_init(bool /*isTraceEnabled*/, const std::string& /*traceFolderPath*/)
+        bool log_init(bool /*isTraceEnabled*/, const std::string& /*traceFolderPath*/, size_t /*maxFileSize*/)
         {
             return false;
         }
@@ -152,20 +160,6 @@ namespace PAL_NS_BEGIN {
         }
 #endif
 
-#if !defined(_WIN32) && defined(__linux__)
-        static std::mutex m;
-        static std::map<std::thread::id, pid_t> threads;
-        static long int gettid()
-        {
-            std::lock_guard<std::mutex> l(m);
-            long int tid = syscall(SYS_gettid);
-            threads[std::this_thread::get_id()] = tid;
-            return tid;
-        }
-#else
-#define     gettid()       std::this_thread::get_id()
-#endif
-
 #ifdef _MSC_VER
 #pragma warning(push)
 #pragma warning(disable:4996)
@@ -198,10 +192,10 @@ namespace PAL_NS_BEGIN {
             if (!isLoggingInited)
                 return;
 
-            static char const levels[] = "?EWID";
-            char buffer[2048] = { 0 };
+            char buffer[DBG_BUFFER_LEN] = { 0 };
 
-#ifdef _WIN32
+#if defined(_WIN32) && !defined(HAVE_MAT_WIN_LOG)
+            static char const levels[] = "?EWID";
             SYSTEMTIME st;
             ::GetSystemTime(&st);
 
@@ -219,63 +213,19 @@ namespace PAL_NS_BEGIN {
 
             buffer[std::min<size_t>(len + 0, sizeof(buffer) - 2)] = '\n';
             buffer[std::min<size_t>(len + 1, sizeof(buffer) - 1)] = '\0';
-#ifdef HAVE_MAT_WIN_LOG
-            // Log to debug log file if enabled
-            debugLogMutex.lock();
-            if (debugLogStream->good())
-            {
-                (*debugLogStream) << buffer;
-                // flush is not very efficient, but needed to get realtime file updates
-                debugLogStream->flush();
-            }
-            debugLogMutex.unlock();
-#else
             ::OutputDebugStringA(buffer);
-#endif //HAVE_MAT_WIN_LOG
 #else
-            auto now = std::chrono::system_clock::now();
-            int64_t millis = std::chrono::duration_cast<std::chrono::milliseconds>(now.time_since_epoch()).count();
-            auto in_time_t = std::chrono::system_clock::to_time_t(now);
-            std::stringstream ss;
-            struct tm timeNow;
-            localtime_r(&in_time_t, &timeNow);
-            ss << std::setw(4) << (timeNow.tm_year + 1900) << '-';
-            ss << std::setfill('0') << std::setw(2) << (timeNow.tm_mon + 1) << '-';
-            ss << std::setfill('0') << std::setw(2) << timeNow.tm_mday << 'T';
-            ss << std::setfill('0') << std::setw(2) << timeNow.tm_hour << ':';
-            ss << std::setfill('0') << std::setw(2) << timeNow.tm_min << ':';
-            ss << std::setfill('0') << std::setw(2) << timeNow.tm_sec << '.';
-            ss << std::setfill('0') << std::setw(3) << unsigned(millis % 1000) << 'Z';
-            ss << "|";
-
-            ss << std::setfill('0') << std::setw(8) << gettid();
-            ss << "|";
-            ss << levels[level];
-            ss << "|";
-            ss << component;
-            ss << "|";
-            ss << fmt;
-
+            // Only the message is formatted here, the trace writer thread adds
+            // the time, thread and component prefix and writes the file
             va_list ap;
             va_start(ap, fmt);
-            int len = vsnprintf(buffer, sizeof(buffer) - 1, ss.str().c_str(), ap);
-            // Avoid stack corruption if vsnprintf failed to format the output
-            // and returned -1
-            if ((len > 0) && (len < DBG_BUFFER_LEN))
+            int len = vsnprintf(buffer, sizeof(buffer), fmt, ap);
+            va_end(ap);
+            // vsnprintf returns -1 if it failed to format the output
+            if (len > 0)
             {
-                // Make sure all of our debug strings contain EOL
-                buffer[len] = '\n';
-                // Log to debug log file if enabled
-                debugLogMutex.lock();
-                if (debugLogStream->good())
-                {
-                    (*debugLogStream) << buffer;
-                    // flush is not very efficient, but needed to get realtime file updates
-                    debugLogStream->flush();
-                }
-                debugLogMutex.unlock();
+                getTraceWriter().Append(level, component, buffer, std::min<size_t>(static_cast<size_t>(len), sizeof(buffer) - 1));
             }
-            va_end(ap);
 #endif
 #else       /* Avoid unused parameter warning */
             (void)(level);
@@ -289,6 +239,55 @@ namespace PAL_NS_BEGIN {
 
     } // namespace detail
 
+    bool setComponentLogLevel(char const* component, LogLevel level)
+    {
+        if (component == nullptr || strlen(component) >= MAX_COMPONENT_NAME_LEN)
+        {
+            return false;
+        }
+
+        std::lock_guard<std::mutex> lock(detail::componentLogLevelsLock);
+        size_t count = detail::componentLogLevelCount.load(std::memory_order_relaxed);
+        size_t index = 0;
+        while (index < count && strcmp(detail::componentLogLevels[index].component, component) != 0)
+        {
+            index++;
+        }
+        if (index == count)
+        {
+            if (count == MAX_COMPONENT_LOG_LEVELS)
+            {
+                return false;
+            }
+            memcpy(detail::componentLogLevels[index].component, component, strlen(component) + 1);
+            detail::componentLogLevels[index].level.store(level, std::memory_order_relaxed);
+            detail::componentLogLevelCount.store(++count, std::memory_order_release);
+        }
+        else
+        {
+            detail::componentLogLevels[index].level.store(level, std::memory_order_relaxed);
+        }
+
+        int levelMax = 0;
+        for (size_t i = 0; i < count; i++)
+        {
+            levelMax = (std::max)(levelMax, detail::componentLogLevels[i].level.load(std::memory_order_relaxed));
+        }
+        detail::g_componentLogLevelMax.store(levelMax, std::memory_order_relaxed);
+        return true;
+    }
+
+    void resetComponentLogLevels()
+    {
+        std::lock_guard<std::mutex> lock(detail::componentLogLevelsLock);
+        size_t count = detail::componentLogLevelCount.load(std::memory_order_relaxed);
+        for (size_t i = 0; i < count; i++)
+        {
+            detail::componentLogLevels[i].level.store(-1, std::memory_order_relaxed);
+        }
+        detail::g_componentLogLevelMax.store(0, std::memory_order_relaxed);
+    }
+
     std::shared_ptr<ITaskDispatcher> PlatformAbstractionLayer::getDefaultTaskDispatcher()
     {
         if (!m_taskDispatcher)
@@ -367,6 +366,20 @@ namespace PAL_NS_BEGIN {
 #pragma warning(pop)
 #endif
 
+    uint64_t PlatformAbstractionLayer::generateRecordId() const
+    {
+        // 2^62, then 30 random bits drawn once per process, then a 32-bit counter:
+        // records of a process get increasing IDs and land at the end of the
+        // storage index, and IDs of other processes are unlikely to be hit.
+        static std::atomic<uint64_t> nextId([]() {
+            std::random_device device;
+            auto nanos = std::chrono::high_resolution_clock::now().time_since_epoch().count();
+            std::mt19937_64 random(static_cast<uint64_t>(device()) ^ static_cast<uint64_t>(nanos));
+            return (uint64_t(1) << 62) | ((random() & 0x3FFFFFFFull) << 32) | 1;
+        }());
+        return nextId++;
+    }
+
     int64_t PlatformAbstractionLayer::getUtcSystemTimeMs() const
     {
 #ifdef _WIN32
@@ -562,7 +575,13 @@ namespace PAL_NS_BEGIN {
                 traceFolderPath = static_cast<std::string&>(configuration[CFG_STR_TRACE_FOLDER_PATH]);
             }
 
-            detail::isLoggingInited = detail::log_init(configuration[CFG_BOOL_ENABLE_TRACE], traceFolderPath);
+            size_t traceFileSize = 0;
+            if (configuration.HasConfig(CFG_INT_TRACE_FILE_SIZE))
+            {
+                traceFileSize = static_cast<size_t>(static_cast<int64_t>(configuration[CFG_INT_TRACE_FILE_SIZE]));
+            }
+
+            detail::isLoggingInited = detail::log_init(configuration[CFG_BOOL_ENABLE_TRACE], traceFolderPath, traceFileSize);
             LOG_TRACE("Initializing...");
             m_SystemInformation = SystemInformationImpl::Create(configuration);
             m_DeviceInformation = DeviceInformationImpl::Create(configuration);
@@ -82,6 +82,8 @@ namespace PAL_NS_BEGIN
 
         std::string generateUuidString() const;
 
+        uint64_t generateRecordId() const;
+
         uint64_t getMonotonicTimeMs() const;
 
         int64_t getUtcSystemTimeMs() const;
@@ -150,6 +152,16 @@ namespace PAL_NS_BEGIN
         return GetPAL().generateUuidString();
     }
 
+    /**
+     * Returns a new identifier for a stored record. Identifiers of a process
+     * count up from a random base above 2^62, so that processes sharing an
+     * offline storage do not collide. They are never 0 and fit in an int64_t.
+     */
+    inline uint64_t generateRecordId()
+    {
+        return GetPAL().generateRecordId();
+    }
+
     /**
      * Return the monotonic system clock time in milliseconds (since unspecified point).
      */
@@ -0,0 +1,211 @@
+//
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// SPDX-License-Identifier: Apache-2.0
+//
+#include "pal/TimingWheel.hpp"
+
+#if defined(_MSC_VER) && defined(_WIN64)
+#include <intrin.h>
+#endif
+
+namespace PAL_NS_BEGIN {
+
+    static unsigned lowestBit(uint64_t mask)
+    {
+#if defined(__GNUC__) || defined(__clang__)
+        return static_cast<unsigned>(__builtin_ctzll(mask));
+#elif defined(_MSC_VER) && defined(_WIN64)
+        unsigned long index;
+        _BitScanForward64(&index, mask);
+        return static_cast<unsigned>(index);
+#else
+        unsigned index = 0;
+        while ((mask & 1) == 0)
+        {
+            mask >>= 1;
+            index++;
+        }
+        return index;
+#endif
+    }
+
+    const unsigned TimingWheel::SlotBits;
+    const unsigned TimingWheel::SlotCount;
+    const unsigned TimingWheel::LevelCount;
+    const uint64_t TimingWheel::NoWakeup;
+    const unsigned TimingWheel::SlotMask;
+
+    TimingWheel::TimingWheel(uint64_t now) :
+        m_now(now)
+    {
+        for (unsigned level = 0; level < LevelCount; level++)
+        {
+            m_occupied[level] = 0;
+        }
+    }
+
+    void TimingWheel::Add(MAT::Task* task, uint64_t targetTime)
+    {
+        auto result = m_entries.emplace(task, Entry());
+        Entry& entry = result.first->second;
+        if (!result.second)
+        {
+            // Queued again before it ran, only the new time counts
+            unlink(entry);
+        }
+        entry.task = task;
+        entry.targetTime = targetTime;
+        place(entry);
+    }
+
+    bool TimingWheel::Remove(MAT::Task* task)
+    {
+        auto it = m_entries.find(task);
+        if (it == m_entries.end())
+        {
+            return false;
+        }
+        unlink(it->second);
+        m_entries.erase(it);
+        return true;
+    }
+
+    MAT::Task* TimingWheel::PopExpired(uint64_t now)
+    {
+        if (m_due.head == nullptr)
+        {
+            advance(now);
+            if (m_due.head == nullptr)
+            {
+                return nullptr;
+            }
+        }
+
+        Entry& entry = *m_due.head;
+        MAT::Task* task = entry.task;
+        unlink(entry);
+        m_entries.erase(task);
+        return task;
+    }
+
+    uint64_t TimingWheel::NextWakeup() const
+    {
+        if (m_due.head != nullptr)
+        {
+            return m_now;
+        }
+        unsigned level;
+        unsigned slot;
+        if (!findNextSlot(level, slot))
+        {
+            return NoWakeup;
+        }
+        return slotStart(level, slot);
+    }
+
+    void TimingWheel::place(Entry& entry)
+    {
+        if (entry.targetTime <= m_now)
+        {
+            append(m_due, entry);
+            return;
+        }
+
+        // The level is that of the highest group differing from the current time,
+        // so the slot always lies ahead of the current time on that level.
+        uint64_t diff = entry.targetTime ^ m_now;
+        unsigned level = 0;
+        while ((level + 1 < LevelCount) && ((diff >> (SlotBits * (level + 1))) != 0))
+        {
+            level++;
+        }
+        unsigned slot = static_cast<unsigned>(entry.targetTime >> (SlotBits * level)) & SlotMask;
+        append(m_slots[level][slot], entry);
+        m_occupied[level] |= (uint64_t(1) << slot);
+    }
+
+    void TimingWheel::append(List& list, Entry& entry)
+    {
+        entry.list = &list;
+        entry.next = nullptr;
+        entry.prev = list.tail;
+        if (list.tail != nullptr)
+        {
+            list.tail->next = &entry;
+        }
+        else
+        {
+            list.head = &entry;
+        }
+        list.tail = &entry;
+    }
+
+    void TimingWheel::unlink(Entry& entry)
+    {
+        List& list = *entry.list;
+        (entry.prev != nullptr ? entry.prev->next : list.head) = entry.next;
+        (entry.next != nullptr ? entry.next->prev : list.tail) = entry.prev;
+        entry.prev = entry.next = nullptr;
+        entry.list = nullptr;
+
+        if ((list.head == nullptr) && (&list != &m_due))
+        {
+            size_t index = static_cast<size_t>(&list - &m_slots[0][0]);
+            m_occupied[index / SlotCount] &= ~(uint64_t(1) << (index % SlotCount));
+        }
+    }
+
+    bool TimingWheel::advance(uint64_t now)
+    {
+        unsigned level;
+        unsigned slot;
+        while (findNextSlot(level, slot))
+        {
+            uint64_t start = slotStart(level, slot);
+            if (start > now)
+            {
+                break;
+            }
+
+            // Tasks of the lowest level become due, the others move down
+            m_now = start;
+            List list = m_slots[level][slot];
+            m_slots[level][slot] = List();
+            m_occupied[level] &= ~(uint64_t(1) << slot);
+            for (Entry* entry = list.head; entry != nullptr;)
+            {
+                Entry* next = entry->next;
+                place(*entry);
+                entry = next;
+            }
+        }
+
+        if (now > m_now)
+        {
+            m_now = now;
+        }
+        return m_due.head != nullptr;
+    }
+
+    bool TimingWheel::findNextSlot(unsigned& level, unsigned& slot) const
+    {
+        // Every task of a level is due before any task of the levels above it
+        for (level = 0; level < LevelCount; level++)
+        {
+            if (m_occupied[level] != 0)
+            {
+                slot = lowestBit(m_occupied[level]);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    uint64_t TimingWheel::slotStart(unsigned level, unsigned slot) const
+    {
+        unsigned shift = SlotBits * (level + 1);
+        uint64_t prefix = (level + 1 < LevelCount) ? ((m_now >> shift) << shift) : 0;
+        return prefix | (uint64_t(slot) << (SlotBits * level));
+    }
+
+} PAL_NS_END
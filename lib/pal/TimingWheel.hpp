@@ -0,0 +1,121 @@
+//
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// SPDX-License-Identifier: Apache-2.0
+//
+#ifndef TIMING_WHEEL_HPP
+#define TIMING_WHEEL_HPP
+
+#include <stddef.h>
+#include <stdint.h>
+#include <unordered_map>
+
+#include "ITaskDispatcher.hpp"
+#include "ctmacros.hpp"
+
+namespace PAL_NS_BEGIN {
+
+    /// <summary>
+    /// Hierarchical timing wheel holding the timed tasks of a task dispatcher.
+    ///
+    /// Each level has 64 slots, a slot of level N spanning 64^N milliseconds.
+    /// A task goes to the level of the highest 6-bit group in which its target
+    /// time differs from the current time of the wheel. When the wheel reaches
+    /// a slot of an upper level, the tasks of that slot are moved down to finer
+    /// levels, and the tasks of a slot of the lowest level become due together.
+    /// Adding and cancelling a task are O(1), finding the next wakeup is a bit
+    /// scan of one occupancy mask per level.
+    ///
+    /// Tasks are tracked by address and never dereferenced, so cancelling a
+    /// task that has already run and been deleted is safe. The class is not
+    /// thread-safe, the dispatcher serializes calls to it.
+    /// </summary>
+    class TimingWheel
+    {
+    public:
+        static const unsigned SlotBits = 6;
+        static const unsigned SlotCount = 1u << SlotBits;
+        static const unsigned LevelCount = (64 + SlotBits - 1) / SlotBits;
+
+        /// <summary>
+        /// Value of NextWakeup() when the wheel is empty.
+        /// </summary>
+        static const uint64_t NoWakeup = UINT64_MAX;
+
+        explicit TimingWheel(uint64_t now);
+
+        TimingWheel(TimingWheel const&) = delete;
+        TimingWheel& operator=(TimingWheel const&) = delete;
+
+        /// <summary>
+        /// Adds a task due at targetTime. Tasks due at or before the current
+        /// time of the wheel are returned by the next call to PopExpired().
+        /// </summary>
+        void Add(MAT::Task* task, uint64_t targetTime);
+
+        /// <summary>
+        /// Removes a task which has not been returned by PopExpired() yet.
+        /// </summary>
+        /// <returns>false if the task is not in the wheel</returns>
+        bool Remove(MAT::Task* task);
+
+        /// <summary>
+        /// Advances the wheel to now and returns the next due task, in the
+        /// order of their target times.
+        /// </summary>
+        /// <returns>nullptr if no task is due</returns>
+        MAT::Task* PopExpired(uint64_t now);
+
+        /// <summary>
+        /// Time at which the wheel next needs to be advanced, either because
+        /// tasks become due or to move tasks down from an upper level.
+        /// </summary>
+        uint64_t NextWakeup() const;
+
+        size_t Size() const
+        {
+            return m_entries.size();
+        }
+
+        bool Empty() const
+        {
+            return m_entries.empty();
+        }
+
+    protected:
+        struct Entry;
+
+        struct List
+        {
+            Entry* head = nullptr;
+            Entry* tail = nullptr;
+        };
+
+        struct Entry
+        {
+            MAT::Task* task;
+            uint64_t   targetTime;
+            Entry*     prev;
+            Entry*     next;
+            List*      list;
+        };
+
+        static const unsigned SlotMask = SlotCount - 1;
+
+        void place(Entry& entry);
+        void append(List& list, Entry& entry);
+        void unlink(Entry& entry);
+        bool advance(uint64_t now);
+
+        bool findNextSlot(unsigned& level, unsigned& slot) const;
+        uint64_t slotStart(unsigned level, unsigned slot) const;
+
+        uint64_t m_now;
+        List     m_due;
+        List     m_slots[LevelCount][SlotCount];
+        uint64_t m_occupied[LevelCount];
+        std::unordered_map<MAT::Task*, Entry> m_entries;
+    };
+
+} PAL_NS_END
+
+#endif
@@ -0,0 +1,340 @@
+//
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// SPDX-License-Identifier: Apache-2.0
+//
+#include "pal/TraceWriter.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+#include <functional>
+
+#ifdef _WIN32
+#include <windows.h>
+#elif defined(__linux__)
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace PAL_NS_BEGIN {
+
+    namespace
+    {
+        std::atomic<uint64_t> s_nextGeneration(0);
+
+        uint64_t currentThreadId()
+        {
+#ifdef _WIN32
+            return static_cast<uint64_t>(::GetCurrentThreadId());
+#elif defined(__linux__)
+            return static_cast<uint64_t>(::syscall(SYS_gettid));
+#else
+            return static_cast<uint64_t>(std::hash<std::thread::id>()(std::this_thread::get_id()));
+#endif
+        }
+
+        inline size_t alignedSize(size_t size)
+        {
+            return (size + 7) & ~static_cast<size_t>(7);
+        }
+    }
+
+    TraceWriter::Ring::Ring(size_t capacity, uint64_t threadId) :
+        storage(capacity / sizeof(uint64_t)),
+        capacity(capacity),
+        threadId(threadId),
+        head(0),
+        tail(0),
+        dropped(0),
+        reportedDropped(0)
+    {
+    }
+
+    TraceWriter::TraceWriter(size_t ringSize) :
+        m_ringSize(8 * 1024),
+        m_generation(0),
+        m_running(false),
+        m_dropped(0),
+        m_maxFileSize(0),
+        m_fileSize(0),
+        m_stopping(false)
+    {
+        // A record of the longest message must fit in half the ring, even when wrapping
+        while (m_ringSize < ringSize)
+        {
+            m_ringSize *= 2;
+        }
+    }
+
+    TraceWriter::~TraceWriter()
+    {
+        Stop();
+    }
+
+    bool TraceWriter::Start(std::string const& path, size_t maxFileSize)
+    {
+        if (IsRunning())
+        {
+            return true;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(m_drainLock);
+            m_file.open(path, std::fstream::out | std::fstream::trunc);
+            if (!m_file.is_open())
+            {
+                return false;
+            }
+            m_path = path;
+            m_maxFileSize = maxFileSize;
+            m_fileSize = 0;
+        }
+
+        m_generation = s_nextGeneration.fetch_add(1) + 1;
+        m_stopping = false;
+        m_running.store(true, std::memory_order_release);
+        m_thread = std::thread(&TraceWriter::threadFunc, this);
+        return true;
+    }
+
+    void TraceWriter::Stop()
+    {
+        if (!m_running.exchange(false))
+        {
+            return;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(m_threadLock);
+            m_stopping = true;
+        }
+        m_wakeup.notify_all();
+        m_thread.join();
+
+        std::lock_guard<std::mutex> lock(m_drainLock);
+        drain();
+        m_file.close();
+    }
+
+    void TraceWriter::Append(LogLevel level, char const* component, char const* message, size_t length) noexcept
+    {
+        if (!IsRunning())
+        {
+            return;
+        }
+        Ring* ring = currentRing();
+        if (ring == nullptr)
+        {
+            return;
+        }
+
+        length = std::min(length, MaxMessageLength);
+        size_t const size = alignedSize(sizeof(RecordHeader) + length);
+        uint64_t const head = ring->head.load(std::memory_order_relaxed);
+        size_t offset = static_cast<size_t>(head & (ring->capacity - 1));
+        size_t const contiguous = ring->capacity - offset;
+        size_t const total = (size > contiguous) ? contiguous + size : size;
+
+        if (head + total - ring->tail.load(std::memory_order_acquire) > ring->capacity)
+        {
+            // Only this thread writes the counter
+            ring->dropped.store(ring->dropped.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+            return;
+        }
+
+        char* bytes = ring->bytes();
+        if (size > contiguous)
+        {
+            // The reader skips a tail too short for a header without a marker
+            if (contiguous >= sizeof(RecordHeader))
+            {
+                RecordHeader wrap = {};
+                memcpy(bytes + offset, &wrap, sizeof(wrap));
+            }
+            offset = 0;
+        }
+
+        RecordHeader header = {};
+        header.size = static_cast<uint32_t>(size);
+        header.length = static_cast<uint32_t>(length);
+        header.timeMs = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+        header.component = component;
+        header.level = static_cast<int32_t>(level);
+        memcpy(bytes + offset, &header, sizeof(header));
+        memcpy(bytes + offset + sizeof(header), message, length);
+
+        ring->head.store(head + total, std::memory_order_release);
+    }
+
+    TraceWriter::Ring* TraceWriter::currentRing() noexcept
+    {
+        // The calling thread's ring, registered with the writer generation it belongs to
+        struct ThreadRing
+        {
+            uint64_t              generation = 0;
+            std::shared_ptr<Ring> ring;
+        };
+        static thread_local ThreadRing threadRing;
+        if (threadRing.generation != m_generation)
+        {
+            try
+            {
+                std::shared_ptr<Ring> ring = std::make_shared<Ring>(m_ringSize, currentThreadId());
+                {
+                    std::lock_guard<std::mutex> lock(m_ringsLock);
+                    m_rings.push_back(ring);
+                }
+                threadRing.ring = ring;
+                threadRing.generation = m_generation;
+            }
+            catch (...)
+            {
+                return nullptr;
+            }
+        }
+        return threadRing.ring.get();
+    }
+
+    void TraceWriter::Flush()
+    {
+        std::lock_guard<std::mutex> lock(m_drainLock);
+        if (m_file.is_open())
+        {
+            drain();
+        }
+    }
+
+    void TraceWriter::threadFunc()
+    {
+        std::unique_lock<std::mutex> lock(m_threadLock);
+        while (!m_stopping)
+        {
+            lock.unlock();
+            Flush();
+            lock.lock();
+            m_wakeup.wait_for(lock, std::chrono::milliseconds(DrainIntervalMs), [this]() { return m_stopping; });
+        }
+    }
+
+    void TraceWriter::drain()
+    {
+        std::vector<std::shared_ptr<Ring>> rings;
+        {
+            std::lock_guard<std::mutex> lock(m_ringsLock);
+            rings = m_rings;
+        }
+
+        for (auto const& ring : rings)
+        {
+            drainRing(*ring);
+        }
+        m_file.flush();
+        rings.clear();
+
+        // Rings of threads that are gone are not needed once they are empty
+        std::lock_guard<std::mutex> lock(m_ringsLock);
+        m_rings.erase(std::remove_if(m_rings.begin(), m_rings.end(), [](std::shared_ptr<Ring> const& ring) {
+                          return ring.use_count() == 1 && ring->head.load(std::memory_order_acquire) == ring->tail.load(std::memory_order_relaxed);
+                      }),
+                      m_rings.end());
+    }
+
+    void TraceWriter::drainRing(Ring& ring)
+    {
+        char const* bytes = ring.bytes();
+        uint64_t const head = ring.head.load(std::memory_order_acquire);
+        uint64_t tail = ring.tail.load(std::memory_order_relaxed);
+        while (tail != head)
+        {
+            size_t const offset = static_cast<size_t>(tail & (ring.capacity - 1));
+            size_t const contiguous = ring.capacity - offset;
+            RecordHeader header;
+            if (contiguous < sizeof(header))
+            {
+                tail += contiguous;
+                continue;
+            }
+            memcpy(&header, bytes + offset, sizeof(header));
+            if (header.size == 0)
+            {
+                tail += contiguous;
+                continue;
+            }
+            writeLine(ring.threadId, header, bytes + offset + sizeof(header));
+            tail += header.size;
+            ring.tail.store(tail, std::memory_order_release);
+        }
+        ring.tail.store(tail, std::memory_order_release);
+
+        uint64_t const dropped = ring.dropped.load(std::memory_order_relaxed);
+        if (dropped != ring.reportedDropped)
+        {
+            uint64_t const count = dropped - ring.reportedDropped;
+            ring.reportedDropped = dropped;
+            m_dropped.fetch_add(count, std::memory_order_relaxed);
+
+            char message[64];
+            int length = snprintf(message, sizeof(message), "Dropped %llu trace lines", static_cast<unsigned long long>(count));
+            RecordHeader header = {};
+            header.length = static_cast<uint32_t>(std::max(length, 0));
+            header.timeMs = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+            header.component = "MATSDK.PAL";
+            header.level = static_cast<int32_t>(Warning);
+            writeLine(ring.threadId, header, message);
+        }
+    }
+
+#ifdef _MSC_VER
+#pragma warning(push)
+#pragma warning(disable:4996)
+#endif
+    void TraceWriter::writeLine(uint64_t threadId, RecordHeader const& header, char const* message)
+    {
+        static char const levels[] = "?EWID";
+        char const level = (header.level > 0 && header.level < 5) ? levels[header.level] : levels[0];
+
+        time_t const seconds = static_cast<time_t>(header.timeMs / 1000);
+        struct tm timeNow = {};
+#ifdef _WIN32
+        localtime_s(&timeNow, &seconds);
+#else
+        localtime_r(&seconds, &timeNow);
+#endif
+
+        char prefix[128];
+        int length = snprintf(prefix, sizeof(prefix), "%04d-%02d-%02dT%02d:%02d:%02d.%03uZ|%08llu|%c|%s|",
+                              timeNow.tm_year + 1900, timeNow.tm_mon + 1, timeNow.tm_mday,
+                              timeNow.tm_hour, timeNow.tm_min, timeNow.tm_sec, static_cast<unsigned>(header.timeMs % 1000),
+                              static_cast<unsigned long long>(threadId), level, header.component);
+        if (length < 0)
+        {
+            return;
+        }
+        length = std::min(length, static_cast<int>(sizeof(prefix) - 1));
+
+        m_file.write(prefix, length);
+        m_file.write(message, header.length);
+        m_file.put('\n');
+        m_fileSize += static_cast<size_t>(length) + header.length + 1;
+        if (m_maxFileSize != 0 && m_fileSize >= m_maxFileSize)
+        {
+            rotate();
+        }
+    }
+#ifdef _MSC_VER
+#pragma warning(pop)
+#endif
+
+    void TraceWriter::rotate()
+    {
+        std::string const previous = m_path + ".1";
+        m_file.close();
+        std::remove(previous.c_str());
+        std::rename(m_path.c_str(), previous.c_str());
+        m_file.open(m_path, std::fstream::out | std::fstream::trunc);
+        m_fileSize = 0;
+    }
+
+} PAL_NS_END
@@ -0,0 +1,141 @@
+//
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// SPDX-License-Identifier: Apache-2.0
+//
+#ifndef TRACE_WRITER_HPP
+#define TRACE_WRITER_HPP
+
+#include <atomic>
+#include <condition_variable>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <stdint.h>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "ctmacros.hpp"
+#include "DebugTrace.hpp"
+
+namespace PAL_NS_BEGIN {
+
+    /// <summary>
+    /// Background writer of the SDK trace file.
+    ///
+    /// Every tracing thread appends binary records (time, level, component and
+    /// the formatted message) to a ring of its own, without locking. A writer
+    /// thread drains the rings, adds the line prefix, writes the file and
+    /// rotates it once it grows beyond the maximum size. When a ring is full the
+    /// record is dropped and counted instead of blocking the traced thread.
+    /// </summary>
+    class TraceWriter
+    {
+    public:
+        static constexpr size_t DefaultRingSize    = 64 * 1024;
+        static constexpr size_t MaxMessageLength   = 2047;
+        static constexpr unsigned DrainIntervalMs  = 20;
+
+        /// <param name="ringSize">Bytes of each thread's ring, a power of two</param>
+        explicit TraceWriter(size_t ringSize = DefaultRingSize);
+        ~TraceWriter();
+
+        TraceWriter(TraceWriter const&) = delete;
+        TraceWriter& operator=(TraceWriter const&) = delete;
+
+        /// <summary>
+        /// Opens the trace file and starts the writer thread.
+        /// </summary>
+        /// <param name="path">Trace file, rotated to path + ".1"</param>
+        /// <param name="maxFileSize">Size at which the file is rotated, 0 for no rotation</param>
+        /// <returns>false if the file could not be created</returns>
+        bool Start(std::string const& path, size_t maxFileSize);
+
+        /// <summary>
+        /// Writes out what is pending, stops the writer thread and closes the file.
+        /// </summary>
+        void Stop();
+
+        bool IsRunning() const noexcept
+        {
+            return m_running.load(std::memory_order_acquire);
+        }
+
+        /// <summary>
+        /// Queues a trace line on the calling thread's ring, never blocks.
+        /// The component must be a string with static storage duration.
+        /// </summary>
+        void Append(LogLevel level, char const* component, char const* message, size_t length) noexcept;
+
+        /// <summary>
+        /// Writes out all records queued so far, on the calling thread.
+        /// </summary>
+        void Flush();
+
+        /// <summary>
+        /// Number of records dropped because a ring was full, as far as the writer has seen them.
+        /// </summary>
+        uint64_t GetDroppedCount() const noexcept
+        {
+            return m_dropped.load(std::memory_order_relaxed);
+        }
+
+    protected:
+        struct RecordHeader
+        {
+            uint32_t    size;       // Bytes taken in the ring, 0 marks a wrap to the start
+            uint32_t    length;     // Message length
+            int64_t     timeMs;
+            char const* component;
+            int32_t     level;
+        };
+
+        /// <summary>
+        /// Single producer, single consumer byte ring of one thread.
+        /// </summary>
+        struct Ring
+        {
+            Ring(size_t capacity, uint64_t threadId);
+
+            std::vector<uint64_t>  storage;     // uint64_t keeps records 8-byte aligned
+            size_t                 capacity;
+            uint64_t               threadId;
+            std::atomic<uint64_t>  head;        // Written by the owning thread
+            std::atomic<uint64_t>  tail;        // Written by the draining thread
+            std::atomic<uint64_t>  dropped;     // Written by the owning thread
+            uint64_t               reportedDropped;
+
+            char* bytes() noexcept { return reinterpret_cast<char*>(storage.data()); }
+        };
+
+        Ring* currentRing() noexcept;
+        void threadFunc();
+        void drain();
+        void drainRing(Ring& ring);
+        void writeLine(uint64_t threadId, RecordHeader const& header, char const* message);
+        void rotate();
+
+        size_t                               m_ringSize;
+        uint64_t                             m_generation;
+        std::atomic<bool>                    m_running;
+        std::atomic<uint64_t>                m_dropped;
+
+        std::mutex                           m_ringsLock;
+        std::vector<std::shared_ptr<Ring>>   m_rings;
+
+        // Held while draining, there is one consumer of the rings at a time
+        std::mutex                           m_drainLock;
+        std::fstream                         m_file;
+        std::string                          m_path;
+        size_t                               m_maxFileSize;
+        size_t                               m_fileSize;
+
+        std::mutex                           m_threadLock;
+        std::condition_variable              m_wakeup;
+        bool                                 m_stopping;
+        std::thread                          m_thread;
+    };
+
+} PAL_NS_END
+
+#endif // TRACE_WRITER_HPP
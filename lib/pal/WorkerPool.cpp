@@ -0,0 +1,308 @@
+//
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// SPDX-License-Identifier: Apache-2.0
+//
+// clang-format off
+#include "pal/WorkerPool.hpp"
+#include "pal/PAL.hpp"
+
+#if defined(MATSDK_PAL_CPP11) || defined(MATSDK_PAL_WIN32)
+
+#include <algorithm>
+
+/* Same clamping of far timers as the WorkerThread, in case of monotonic clock drift */
+#define MAX_FUTURE_DELTA_MS (60 * 60 * 1000)
+
+namespace PAL_NS_BEGIN {
+
+    class WorkerPoolLane : public MAT::ITaskDispatcher
+    {
+    public:
+        WorkerPoolLane(std::shared_ptr<WorkerPool> const& pool) :
+            m_pool(pool)
+        {
+        }
+
+        ~WorkerPoolLane()
+        {
+            Join();
+        }
+
+        void Join() override
+        {
+            m_pool->close(m_lane);
+        }
+
+        void Queue(MAT::Task* task) override
+        {
+            m_pool->queue(m_lane, task);
+        }
+
+        bool Cancel(MAT::Task* task, uint64_t waitTime) override
+        {
+            return m_pool->cancel(m_lane, task, waitTime);
+        }
+
+    protected:
+        std::shared_ptr<WorkerPool> m_pool;
+        WorkerPool::Lane            m_lane;
+    };
+
+    std::shared_ptr<WorkerPool> WorkerPool::Create(size_t threadCount)
+    {
+        return std::shared_ptr<WorkerPool>(new WorkerPool(threadCount));
+    }
+
+    WorkerPool::WorkerPool(size_t threadCount) :
+        m_timers(getMonotonicTimeMs()),
+        m_timerDeadline(0),
+        m_stopping(false)
+    {
+        threadCount = std::max<size_t>(threadCount, 1);
+        for (size_t i = 0; i < threadCount; i++)
+        {
+            m_threads.push_back(std::thread(&WorkerPool::threadFunc, this));
+        }
+        LOG_INFO("Started worker pool with %u threads", static_cast<unsigned>(threadCount));
+    }
+
+    WorkerPool::~WorkerPool()
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_lock);
+            m_stopping = true;
+        }
+        m_wakeup.notify_all();
+
+        std::thread::id this_id = std::this_thread::get_id();
+        for (auto& thread : m_threads)
+        {
+            try {
+                if (thread.joinable() && (thread.get_id() != this_id))
+                    thread.join();
+                else
+                    thread.detach();
+            }
+            catch (...) {};
+        }
+    }
+
+    std::shared_ptr<MAT::ITaskDispatcher> WorkerPool::CreateLane()
+    {
+        return std::make_shared<WorkerPoolLane>(shared_from_this());
+    }
+
+    void WorkerPool::queue(Lane& lane, MAT::Task* task)
+    {
+        std::unique_lock<std::mutex> lock(m_lock);
+        if (lane.closed)
+        {
+            LOG_WARN("Task queued after Join, dropped");
+            lock.unlock();
+            delete task;
+            return;
+        }
+
+        if (task->Type == MAT::Task::TimedCall)
+        {
+            const auto maxTargetTime = getMonotonicTimeMs() + MAX_FUTURE_DELTA_MS;
+            if (task->TargetTime > maxTargetTime)
+            {
+                task->TargetTime = maxTargetTime;
+            }
+            m_timers.Add(task, task->TargetTime);
+            m_timerLanes[task] = &lane;
+            // Only a timer due before the watching thread wakes up needs a wakeup
+            if ((m_timerWaiter == std::thread::id()) || (task->TargetTime < m_timerDeadline))
+            {
+                m_wakeup.notify_all();
+            }
+            return;
+        }
+
+        enqueue(lane, task);
+    }
+
+    void WorkerPool::enqueue(Lane& lane, MAT::Task* task)
+    {
+        lane.queue.push_back(task);
+        if (!lane.scheduled)
+        {
+            lane.scheduled = true;
+            m_ready.push_back(&lane);
+            m_wakeup.notify_one();
+        }
+    }
+
+    // Same contract as WorkerThread::Cancel: a timed task which has not started
+    // yet is removed, a running one is waited for up to waitTime ms, and a task
+    // cancelling itself is reported as cancelled. Tasks are compared by address
+    // only, as they are deleted once done.
+    bool WorkerPool::cancel(Lane& lane, MAT::Task* task, uint64_t waitTime)
+    {
+        if (task == nullptr)
+        {
+            return false;
+        }
+
+        std::unique_lock<std::mutex> lock(m_lock);
+        if (lane.inProgress == task)
+        {
+            if (lane.runner == std::this_thread::get_id())
+            {
+                return true;
+            }
+            if (waitTime > 0)
+            {
+                m_taskDone.wait_for(lock, std::chrono::milliseconds(waitTime), [&lane, task]() { return lane.inProgress != task; });
+            }
+            return (lane.inProgress != task);
+        }
+
+        if (m_timers.Remove(task))
+        {
+            m_timerLanes.erase(task);
+        }
+        else
+        {
+            // A due timer waits for its turn in the lane queue
+            auto it = std::find(lane.queue.begin(), lane.queue.end(), task);
+            if ((it == lane.queue.end()) || ((*it)->Type != MAT::Task::TimedCall))
+            {
+                return true;
+            }
+            lane.queue.erase(it);
+        }
+        lock.unlock();
+        delete task;
+        return true;
+    }
+
+    void WorkerPool::close(Lane& lane)
+    {
+        std::vector<MAT::Task*> dropped;
+        {
+            std::unique_lock<std::mutex> lock(m_lock);
+            if (lane.closed)
+            {
+                return;
+            }
+            lane.closed = true;
+
+            // Let queued tasks run as a WorkerThread does before it stops. A pool
+            // thread cannot wait for them, the other lanes may need it to make
+            // progress, so it drops them and only waits for a running task.
+            const auto self = std::this_thread::get_id();
+            if (std::none_of(m_threads.begin(), m_threads.end(), [self](std::thread const& thread) { return thread.get_id() == self; }))
+            {
+                m_taskDone.wait(lock, [&lane]() { return !lane.scheduled; });
+            }
+            else
+            {
+                dropped.assign(lane.queue.begin(), lane.queue.end());
+                lane.queue.clear();
+                m_ready.remove(&lane);
+                if (lane.runner != self)
+                {
+                    m_taskDone.wait(lock, [&lane]() { return lane.inProgress == nullptr; });
+                }
+                lane.scheduled = (lane.inProgress != nullptr);
+            }
+
+            for (auto it = m_timerLanes.begin(); it != m_timerLanes.end();)
+            {
+                if (it->second == &lane)
+                {
+                    m_timers.Remove(it->first);
+                    dropped.push_back(it->first);
+                    it = m_timerLanes.erase(it);
+                }
+                else
+                {
+                    ++it;
+                }
+            }
+        }
+
+        for (MAT::Task* task : dropped)
+        {
+            delete task;
+        }
+    }
+
+    void WorkerPool::threadFunc()
+    {
+        LOG_INFO("Running pool thread");
+        std::unique_lock<std::mutex> lock(m_lock);
+        while (!m_stopping)
+        {
+            auto now = getMonotonicTimeMs();
+            while (MAT::Task* task = m_timers.PopExpired(now))
+            {
+                auto it = m_timerLanes.find(task);
+                Lane* lane = it->second;
+                m_timerLanes.erase(it);
+                enqueue(*lane, task);
+            }
+
+            if (m_ready.empty())
+            {
+                // One idle thread watches the timers, the others wait for work
+                const auto nextWakeup = m_timers.NextWakeup();
+                const auto self = std::this_thread::get_id();
+                if ((nextWakeup != TimingWheel::NoWakeup) &&
+                    ((m_timerWaiter == std::thread::id()) || (nextWakeup < m_timerDeadline)))
+                {
+                    m_timerWaiter = self;
+                    m_timerDeadline = nextWakeup;
+                    m_wakeup.wait_for(lock, std::chrono::milliseconds(std::min<uint64_t>(nextWakeup - now, MAX_FUTURE_DELTA_MS)));
+                }
+                else
+                {
+                    m_wakeup.wait(lock);
+                }
+                if (m_timerWaiter == self)
+                {
+                    m_timerWaiter = std::thread::id();
+                }
+                continue;
+            }
+
+            Lane* lane = m_ready.front();
+            m_ready.pop_front();
+            std::unique_ptr<MAT::Task> task(lane->queue.front());
+            lane->queue.pop_front();
+            lane->inProgress = task.get();
+            lane->runner = std::this_thread::get_id();
+
+            // Hand over the remaining work and the timers to idle threads
+            if (!m_ready.empty() || ((m_timerWaiter == std::thread::id()) && !m_timers.Empty()))
+            {
+                m_wakeup.notify_one();
+            }
+
+            lock.unlock();
+            LOG_TRACE("Execute item=%p type=%s\n", task.get(), task->TypeName.c_str());
+            (*task)();
+            task->Type = MAT::Task::Done;
+            task.reset();
+            lock.lock();
+
+            lane->inProgress = nullptr;
+            lane->runner = std::thread::id();
+            if (!lane->queue.empty())
+            {
+                // Back of the line, behind the lanes which waited meanwhile
+                m_ready.push_back(lane);
+            }
+            else
+            {
+                lane->scheduled = false;
+            }
+            m_taskDone.notify_all();
+        }
+    }
+
+} PAL_NS_END
+
+#endif
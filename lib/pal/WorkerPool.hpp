@@ -0,0 +1,90 @@
+//
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// SPDX-License-Identifier: Apache-2.0
+//
+#ifndef WORKER_POOL_HPP
+#define WORKER_POOL_HPP
+
+#include <condition_variable>
+#include <deque>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <stdint.h>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "ITaskDispatcher.hpp"
+#include "ctmacros.hpp"
+#include "TimingWheel.hpp"
+
+namespace PAL_NS_BEGIN {
+
+    /// <summary>
+    /// Bounded pool of worker threads shared by several task dispatchers, called
+    /// lanes, typically one per ILogManager.
+    ///
+    /// Tasks of one lane run one at a time and in order, as on a WorkerThread, so
+    /// components written for a single dispatcher thread need no extra locking.
+    /// Lanes with work are served round-robin, one task per turn, so one busy
+    /// ILogManager cannot hold back the others. Timed tasks of all lanes share a
+    /// single TimingWheel, watched by one idle thread at a time.
+    /// </summary>
+    class WorkerPool : public std::enable_shared_from_this<WorkerPool>
+    {
+    public:
+        static std::shared_ptr<WorkerPool> Create(size_t threadCount);
+
+        WorkerPool(WorkerPool const&) = delete;
+        WorkerPool& operator=(WorkerPool const&) = delete;
+
+        ~WorkerPool();
+
+        /// <summary>
+        /// Creates a task dispatcher running its tasks on this pool. The lane
+        /// keeps the pool alive.
+        /// </summary>
+        std::shared_ptr<MAT::ITaskDispatcher> CreateLane();
+
+        size_t GetThreadCount() const
+        {
+            return m_threads.size();
+        }
+
+    protected:
+        friend class WorkerPoolLane;
+
+        struct Lane
+        {
+            std::deque<MAT::Task*> queue;
+            MAT::Task*             inProgress = nullptr;
+            std::thread::id        runner;
+            bool                   scheduled = false;   // Waiting in m_ready or running
+            bool                   closed = false;
+        };
+
+        explicit WorkerPool(size_t threadCount);
+
+        void queue(Lane& lane, MAT::Task* task);
+        bool cancel(Lane& lane, MAT::Task* task, uint64_t waitTime);
+        void close(Lane& lane);
+
+        void enqueue(Lane& lane, MAT::Task* task);
+        void threadFunc();
+
+        std::mutex                             m_lock;
+        std::condition_variable                m_wakeup;
+        std::condition_variable                m_taskDone;
+        std::vector<std::thread>               m_threads;
+        std::list<Lane*>                       m_ready;
+        TimingWheel                            m_timers;
+        std::unordered_map<MAT::Task*, Lane*>  m_timerLanes;
+        std::thread::id                        m_timerWaiter;
+        uint64_t                               m_timerDeadline;
+        bool                                   m_stopping;
+    };
+
+} PAL_NS_END
+
+#endif
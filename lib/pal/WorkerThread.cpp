@@ -5,6 +5,7 @@
 // clang-format off
 #include "pal/WorkerThread.hpp"
 #include "pal/PAL.hpp"
+#include "pal/TimingWheel.hpp"
 
 #if defined(MATSDK_PAL_CPP11) || defined(MATSDK_PAL_WIN32)
 
@@ -32,14 +33,16 @@ namespace PAL_NS_BEGIN {
         std::timed_mutex      m_execution_mutex;
 
         std::list<MAT::Task*> m_queue;
-        std::list<MAT::Task*> m_timerQueue;
+        TimingWheel           m_timers;
         Event                 m_event;
         MAT::Task*            m_itemInProgress;
+        uint64_t              m_sleepUntil = 0;
         int count = 0;
 
     public:
 
-        WorkerThread()
+        WorkerThread() :
+            m_timers(getMonotonicTimeMs())
         {
             m_itemInProgress = nullptr;
             m_hThread = std::thread(WorkerThread::threadFunc, static_cast<void*>(this));
@@ -69,9 +72,9 @@ namespace PAL_NS_BEGIN {
             {
                 LOG_WARN("m_queue is not empty!");
             }
-            if (!m_timerQueue.empty())
+            if (!m_timers.Empty())
             {
-                LOG_WARN("m_timerQueue is not empty!");
+                LOG_WARN("m_timers is not empty!");
             }
         }
 
@@ -80,15 +83,21 @@ namespace PAL_NS_BEGIN {
             LOG_INFO("queue item=%p", &item);
             LOCKGUARD(m_lock);
             if (item->Type == MAT::Task::TimedCall) {
-                auto it = m_timerQueue.begin();
-                while (it != m_timerQueue.end() && (*it)->TargetTime < item->TargetTime) {
-                    ++it;
+                // Clamp in case of monotonic clock drift
+                const auto maxTargetTime = getMonotonicTimeMs() + MAX_FUTURE_DELTA_MS;
+                if (item->TargetTime > maxTargetTime) {
+                    item->TargetTime = maxTargetTime;
                 }
-                m_timerQueue.insert(it, item);
-            }
-            else {
-                m_queue.push_back(item);
+                m_timers.Add(item, item->TargetTime);
+                count++;
+                // A sleeping thread only needs to wake up earlier for this timer,
+                // a running one picks it up on its next pass.
+                if (item->TargetTime < m_sleepUntil) {
+                    m_event.post();
+                }
+                return;
             }
+            m_queue.push_back(item);
             count++;
             m_event.post();
         }
@@ -108,8 +117,9 @@ namespace PAL_NS_BEGIN {
         //   once the item is done executing. Method may fail and return if
         //   waitTime given was insufficient to wait for completion.
         //
-        // - if task being cancelled is not executing yet, then erase it from
-        //   timer queue without any wait.
+        // - if task being cancelled is not executing yet, then remove it from
+        //   the timer wheel without any wait. The wheel only compares the
+        //   address, so a task that already ran and got deleted is not touched.
         //
         // TODO: current callers of this API do not check the status code.
         // Refactor this code to return the following cancellation status:
@@ -151,13 +161,9 @@ namespace PAL_NS_BEGIN {
                 return (m_itemInProgress != item);
             }
 
-            {
-                auto it = std::find(m_timerQueue.begin(), m_timerQueue.end(), item);
-                if (it != m_timerQueue.end()) {
-                    // Still in the queue
-                    m_timerQueue.erase(it);
-                    delete item;
-                }
+            if (m_timers.Remove(item)) {
+                // Still in the queue
+                delete item;
             }
 #if 0
             for (;;) {
@@ -189,24 +195,14 @@ namespace PAL_NS_BEGIN {
                     LOCKGUARD(self->m_lock);
 
                     auto now = getMonotonicTimeMs();
-                    if (!self->m_timerQueue.empty()) {
-                        const auto currTargetTime = self->m_timerQueue.front()->TargetTime;
-                        if (currTargetTime <= now) {
-                            // process the item at the front immediately
-                            item = std::unique_ptr<MAT::Task>(self->m_timerQueue.front());
-                            self->m_timerQueue.pop_front();
-                        } else {
-                           // timed call in future, we need to resort the items in the queue
-                           const auto delta = currTargetTime - now;
-                           if (delta > MAX_FUTURE_DELTA_MS) {
-                               const auto itemPtr = self->m_timerQueue.front();
-                               self->m_timerQueue.pop_front();
-                               itemPtr->TargetTime = now + MAX_FUTURE_DELTA_MS;
-                               self->Queue(itemPtr);
-                               continue;
-                           }
-                           // value used for sleep in case if m_queue ends up being empty
-                           nextTimerInMs = static_cast<unsigned>(delta);
+                    item = std::unique_ptr<MAT::Task>(self->m_timers.PopExpired(now));
+                    if (!item) {
+                        // Timers due in the same millisecond share one wakeup. Timers
+                        // further away may cost a wakeup to move them down the wheel.
+                        const auto nextWakeup = self->m_timers.NextWakeup();
+                        if (nextWakeup != TimingWheel::NoWakeup) {
+                            // value used for sleep in case if m_queue ends up being empty
+                            nextTimerInMs = static_cast<unsigned>(std::min<uint64_t>(nextWakeup - now, MAX_FUTURE_DELTA_MS));
                         }
                     }
 
@@ -217,6 +213,9 @@ namespace PAL_NS_BEGIN {
 
                     if (item) {
                         self->m_itemInProgress = item.get();
+                        self->m_sleepUntil = 0;
+                    } else {
+                        self->m_sleepUntil = now + nextTimerInMs;
                     }
                 }
 
@@ -466,7 +466,7 @@ namespace MAT_NS_BEGIN {
     /// <param name="durationMs">The duration ms.</param>
     /// <param name="latencyToSendMs">The latency to send ms.</param>
     /// <param name="metastatsOnly">if set to <c>true</c> [metastats only].</param>
-    void MetaStats::updateOnPackageSentSucceeded(std::map<std::string, std::string> const& recordIdsAndTenantids, EventLatency eventLatency, unsigned retryFailedTimes, unsigned durationMs, std::vector<unsigned> const& /*latencyToSendMs*/, bool metastatsOnly)
+    void MetaStats::updateOnPackageSentSucceeded(PackagedRecords const& recordIdsAndTenantids, EventLatency eventLatency, unsigned retryFailedTimes, unsigned durationMs, std::vector<unsigned> const& /*latencyToSendMs*/, bool metastatsOnly)
     {
         // Package summary stats
         PackageStats& packageStats = m_telemetryStats.packageStats;
@@ -500,9 +500,9 @@ namespace MAT_NS_BEGIN {
         // Per-tenant
         if (m_enableTenantStats)
         {
-            for (const auto& entry : recordIdsAndTenantids)
+            for (size_t i = 0; i < recordIdsAndTenantids.size(); i++)
             {
-                updatePackageSent(m_telemetryTenantStats[entry.second]);
+                updatePackageSent(m_telemetryTenantStats[recordIdsAndTenantids.tenantToken(i)]);
             }
         }
 
@@ -11,6 +11,7 @@
 
 #include "Enums.hpp"
 #include "CsProtocol_types.hpp"
+#include "system/Contexts.hpp"
 
 #include <memory>
 #include <algorithm>
@@ -526,7 +527,7 @@ namespace MAT_NS_BEGIN {
 
         void updateOnEventIncoming(std::string const& tenanttoken, unsigned size, EventLatency latency, bool metastats);
         void updateOnPostData(unsigned postDataLength, bool metastatsOnly);
-        void updateOnPackageSentSucceeded(std::map<std::string, std::string> const& recordIdsAndTenantids, EventLatency eventLatency, unsigned retryFailedTimes, unsigned durationMs, std::vector<unsigned> const& latencyToSendMs, bool metastatsOnly);
+        void updateOnPackageSentSucceeded(PackagedRecords const& recordIdsAndTenantids, EventLatency eventLatency, unsigned retryFailedTimes, unsigned durationMs, std::vector<unsigned> const& latencyToSendMs, bool metastatsOnly);
         void updateOnPackageFailed(int statusCode);
         void updateOnPackageRetry(int statusCode, unsigned retryFailedTimes);
         void updateOnRecordsDropped(EventDroppedReason reason, std::map<std::string, size_t> const& droppedCount);
@@ -0,0 +1,272 @@
+//
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// SPDX-License-Identifier: Apache-2.0
+//
+#include "MetricAggregator.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <functional>
+#include <thread>
+
+namespace MAT_NS_BEGIN {
+
+    MATSDK_LOG_INST_COMPONENT_CLASS(MetricAggregator, "EventsSDK.MetricAggregator", "Events telemetry client - MetricAggregator class");
+
+    constexpr int MetricAggregator::MaxBucketExponent;
+    constexpr size_t MetricAggregator::BucketCount;
+
+    namespace {
+
+        // Builds use -ffast-math, which lets the compiler assume that there
+        // are no NaN and infinities: check the exponent bits instead
+        uint64_t exponentBits(double value)
+        {
+            uint64_t bits;
+            memcpy(&bits, &value, sizeof(bits));
+            return bits & 0x7FF0000000000000ull;
+        }
+
+        bool isNaN(double value)
+        {
+            uint64_t bits;
+            memcpy(&bits, &value, sizeof(bits));
+            return (exponentBits(value) == 0x7FF0000000000000ull) && ((bits & 0x000FFFFFFFFFFFFFull) != 0);
+        }
+
+        bool isInfinite(double value)
+        {
+            return (exponentBits(value) == 0x7FF0000000000000ull) && !isNaN(value);
+        }
+
+        // Lock-free read-modify-write for doubles, which have no fetch_add
+        template<typename TUpdate>
+        void atomicUpdate(std::atomic<double>& target, TUpdate update)
+        {
+            double current = target.load(std::memory_order_relaxed);
+            double desired;
+            do {
+                desired = update(current);
+                if (desired == current)
+                {
+                    return;
+                }
+            } while (!target.compare_exchange_weak(current, desired, std::memory_order_relaxed));
+        }
+
+    }
+
+    MetricAggregator::MetricAggregator(AggregatedMetricData const& metric,
+        unsigned intervalInSec,
+        EventProperties const& properties,
+        ILogger* logger,
+        std::shared_ptr<ITaskDispatcher> taskDispatcher) :
+        m_metric(metric),
+        m_properties(properties),
+        m_logger(logger),
+        m_intervalMs(intervalInSec * 1000),
+        m_intervalStartMs(PAL::getMonotonicTimeMs()),
+        m_taskDispatcher(taskDispatcher)
+    {
+        // A shard per hardware thread keeps collisions between pushing threads rare
+        m_shardCount = std::min<size_t>(std::max(std::thread::hardware_concurrency(), 1u), 16);
+        m_shards.reset(new Shard[m_shardCount]);
+        for (size_t i = 0; i < m_shardCount; i++)
+        {
+            resetSlot(m_shards[i].slots[0]);
+            resetSlot(m_shards[i].slots[1]);
+        }
+
+        m_metric.count = 0;
+        m_metric.duration = 0;
+        m_metric.aggregates.clear();
+        m_metric.buckets.clear();
+
+        if (m_logger == nullptr)
+        {
+            LOG_WARN("Aggregated metric %s has no logger, roll-ups are dropped", m_metric.name.c_str());
+        }
+        if ((m_intervalMs > 0) && m_taskDispatcher)
+        {
+            LOCKGUARD(m_timerLock);
+            m_timer = PAL::scheduleTask(m_taskDispatcher.get(), m_intervalMs, this, &MetricAggregator::onTimer);
+        }
+    }
+
+    MetricAggregator::~MetricAggregator()
+    {
+        {
+            LOCKGUARD(m_timerLock);
+            m_stopped = true;
+        }
+        // Waits for a roll-up in progress on the dispatcher
+        m_timer.Cancel(std::numeric_limits<uint32_t>::max());
+        RollUp();
+    }
+
+    void MetricAggregator::Push(double value)
+    {
+        if (isNaN(value))
+        {
+            return;
+        }
+
+        // Register as a writer of the active slot. If a roll-up flipped the
+        // epoch in between, the slot may already be drained: retry on the new one.
+        Shard& shard = currentShard();
+        Slot* slot;
+        for (;;)
+        {
+            uint64_t epoch = m_epoch.load();
+            slot = &shard.slots[epoch & 1];
+            slot->writers.fetch_add(1);
+            if (m_epoch.load() == epoch)
+            {
+                break;
+            }
+            slot->writers.fetch_sub(1, std::memory_order_release);
+        }
+
+        slot->count.fetch_add(1, std::memory_order_relaxed);
+        atomicUpdate(slot->sum, [value](double current) { return current + value; });
+        atomicUpdate(slot->sumOfSquares, [value](double current) { return current + value * value; });
+        atomicUpdate(slot->min, [value](double current) { return std::min(current, value); });
+        atomicUpdate(slot->max, [value](double current) { return std::max(current, value); });
+        slot->buckets[getBucketIndex(value)].fetch_add(1, std::memory_order_relaxed);
+
+        slot->writers.fetch_sub(1, std::memory_order_release);
+    }
+
+    bool MetricAggregator::RollUp()
+    {
+        LOCKGUARD(m_rollUpLock);
+        uint64_t nowMs = PAL::getMonotonicTimeMs();
+        uint64_t previous = m_epoch.fetch_add(1);
+
+        AggregatedMetricData data(m_metric);
+        data.duration = static_cast<long>((nowMs - m_intervalStartMs) * 1000);
+        m_intervalStartMs = nowMs;
+
+        uint64_t count = 0;
+        double sum = 0, sumOfSquares = 0;
+        double min = std::numeric_limits<double>::max();
+        double max = std::numeric_limits<double>::lowest();
+        uint64_t buckets[BucketCount] = {};
+        for (size_t i = 0; i < m_shardCount; i++)
+        {
+            Slot& slot = m_shards[i].slots[previous & 1];
+            while (slot.writers.load(std::memory_order_acquire) != 0)
+            {
+                std::this_thread::yield();
+            }
+
+            count += slot.count.load(std::memory_order_relaxed);
+            sum += slot.sum.load(std::memory_order_relaxed);
+            sumOfSquares += slot.sumOfSquares.load(std::memory_order_relaxed);
+            min = std::min(min, slot.min.load(std::memory_order_relaxed));
+            max = std::max(max, slot.max.load(std::memory_order_relaxed));
+            for (size_t b = 0; b < BucketCount; b++)
+            {
+                buckets[b] += slot.buckets[b].load(std::memory_order_relaxed);
+            }
+            resetSlot(slot);
+        }
+
+        if (count == 0)
+        {
+            return false;
+        }
+
+        data.count = static_cast<long>(count);
+        data.aggregates[AggregateType_Sum] = sum;
+        data.aggregates[AggregateType_SumOfSquares] = sumOfSquares;
+        data.aggregates[AggregateType_Minimum] = min;
+        data.aggregates[AggregateType_Maximum] = max;
+        for (size_t b = 0; b < BucketCount; b++)
+        {
+            if (buckets[b] != 0)
+            {
+                data.buckets[getBucketBound(b)] = static_cast<long>(buckets[b]);
+            }
+        }
+
+        LOG_TRACE("Rolled up %llu sample(s) of %s", static_cast<unsigned long long>(count), m_metric.name.c_str());
+        if (m_logger != nullptr)
+        {
+            m_logger->LogAggregatedMetric(data, m_properties);
+        }
+        return true;
+    }
+
+    long MetricAggregator::GetBucket(double value)
+    {
+        return getBucketBound(getBucketIndex(value));
+    }
+
+    size_t MetricAggregator::getBucketIndex(double value)
+    {
+        double magnitude = std::fabs(value);
+        if (magnitude < 1)
+        {
+            return 0;
+        }
+
+        // magnitude = mantissa * 2^exponent with mantissa in [0.5, 1)
+        int exponent = MaxBucketExponent;
+        if (!isInfinite(magnitude))
+        {
+            double mantissa = std::frexp(magnitude, &exponent);
+            if (mantissa == 0.5)
+            {
+                exponent--;
+            }
+            exponent = std::min(exponent, MaxBucketExponent);
+        }
+        return 1 + ((value < 0) ? (MaxBucketExponent + 1) : 0) + static_cast<size_t>(exponent);
+    }
+
+    long MetricAggregator::getBucketBound(size_t index)
+    {
+        if (index == 0)
+        {
+            return 0;
+        }
+        bool negative = (index > static_cast<size_t>(MaxBucketExponent) + 1);
+        int exponent = static_cast<int>((index - 1) % (MaxBucketExponent + 1));
+        return negative ? -(1L << exponent) : (1L << exponent);
+    }
+
+    void MetricAggregator::resetSlot(Slot& slot)
+    {
+        slot.count.store(0, std::memory_order_relaxed);
+        slot.sum.store(0, std::memory_order_relaxed);
+        slot.sumOfSquares.store(0, std::memory_order_relaxed);
+        slot.min.store(std::numeric_limits<double>::max(), std::memory_order_relaxed);
+        slot.max.store(std::numeric_limits<double>::lowest(), std::memory_order_relaxed);
+        for (auto& bucket : slot.buckets)
+        {
+            bucket.store(0, std::memory_order_relaxed);
+        }
+    }
+
+    MetricAggregator::Shard& MetricAggregator::currentShard()
+    {
+        // Thread ids are often aligned addresses, mix the bits before picking a shard
+        uint64_t hash = static_cast<uint64_t>(std::hash<std::thread::id>()(std::this_thread::get_id()));
+        hash *= 0x9E3779B97F4A7C15ull;
+        return m_shards[static_cast<size_t>(hash >> 32) % m_shardCount];
+    }
+
+    void MetricAggregator::onTimer()
+    {
+        RollUp();
+
+        LOCKGUARD(m_timerLock);
+        if (!m_stopped)
+        {
+            m_timer = PAL::scheduleTask(m_taskDispatcher.get(), m_intervalMs, this, &MetricAggregator::onTimer);
+        }
+    }
+
+} MAT_NS_END
@@ -0,0 +1,121 @@
+//
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// SPDX-License-Identifier: Apache-2.0
+//
+#ifndef METRICAGGREGATOR_HPP
+#define METRICAGGREGATOR_HPP
+
+#include "pal/PAL.hpp"
+#include "pal/TaskDispatcher.hpp"
+
+#include "ILogger.hpp"
+
+#include <atomic>
+#include <limits>
+#include <memory>
+#include <mutex>
+
+namespace MAT_NS_BEGIN {
+
+    /// <summary>
+    /// In-process aggregation of a metric. Samples are accumulated (count, sum,
+    /// sum of squares, min, max and a power-of-two histogram) in shards picked
+    /// by the pushing thread, without locks. A timer on the task dispatcher
+    /// periodically rolls the shards up into one AggregatedMetricData event.
+    ///
+    /// Every shard has two slots and a global epoch selects the active one. A
+    /// roll-up flips the epoch, waits for the writers still in the previous
+    /// slots and then drains them, so concurrent pushes are never lost or split.
+    /// </summary>
+    class MetricAggregator
+    {
+    public:
+        /// <summary>
+        /// Largest histogram bucket exponent whose bound still fits in a long.
+        /// </summary>
+        static constexpr int MaxBucketExponent = std::numeric_limits<long>::digits - 1;
+
+        /// <param name="metric">Name and descriptive fields copied into every roll-up</param>
+        /// <param name="intervalInSec">Roll-up interval, 0 for manual roll-ups only</param>
+        MetricAggregator(AggregatedMetricData const& metric,
+            unsigned intervalInSec,
+            EventProperties const& properties,
+            ILogger* logger,
+            std::shared_ptr<ITaskDispatcher> taskDispatcher = PAL::getDefaultTaskDispatcher());
+
+        /// <summary>
+        /// Stops the timer and rolls up the remaining samples.
+        /// </summary>
+        ~MetricAggregator();
+
+        MetricAggregator(MetricAggregator const&) = delete;
+        MetricAggregator& operator=(MetricAggregator const&) = delete;
+
+        /// <summary>
+        /// Adds a sample. Lock-free, NaN is ignored.
+        /// </summary>
+        void Push(double value);
+
+        /// <summary>
+        /// Aggregates the samples pushed since the previous roll-up and logs
+        /// them through the logger, if there are any.
+        /// </summary>
+        /// <returns>false if there was nothing to roll up</returns>
+        bool RollUp();
+
+        /// <summary>
+        /// Histogram bucket of a value: the smallest power of two that is not
+        /// less than its magnitude, with the sign of the value. Magnitudes below
+        /// 1 go to bucket 0.
+        /// </summary>
+        static long GetBucket(double value);
+
+    protected:
+        MATSDK_LOG_DECL_COMPONENT_CLASS();
+
+        // Bucket 0, then exponents 0..MaxBucketExponent for positive and for negative values
+        static constexpr size_t BucketCount = 1 + 2 * (MaxBucketExponent + 1);
+
+        struct Slot
+        {
+            std::atomic<unsigned>  writers { 0 };
+            std::atomic<uint64_t>  count { 0 };
+            std::atomic<double>    sum { 0 };
+            std::atomic<double>    sumOfSquares { 0 };
+            std::atomic<double>    min { std::numeric_limits<double>::max() };
+            std::atomic<double>    max { std::numeric_limits<double>::lowest() };
+            std::atomic<uint32_t>  buckets[BucketCount];
+        };
+
+        struct Shard
+        {
+            Slot slots[2];
+        };
+
+        static size_t getBucketIndex(double value);
+        static long getBucketBound(size_t index);
+        static void resetSlot(Slot& slot);
+        Shard& currentShard();
+        void onTimer();
+
+        AggregatedMetricData             m_metric;
+        EventProperties                  m_properties;
+        ILogger*                         m_logger;
+        const unsigned                   m_intervalMs;
+
+        size_t                           m_shardCount;
+        std::unique_ptr<Shard[]>         m_shards;
+        std::atomic<uint64_t>            m_epoch { 0 };
+
+        std::mutex                       m_rollUpLock;
+        uint64_t                         m_intervalStartMs;
+
+        std::mutex                       m_timerLock;
+        bool                             m_stopped { false };
+        std::shared_ptr<ITaskDispatcher> m_taskDispatcher;
+        PAL::DeferredCallbackHandle      m_timer;
+    };
+
+} MAT_NS_END
+
+#endif // METRICAGGREGATOR_HPP
@@ -75,7 +75,7 @@ namespace MAT_NS_BEGIN {
             result &= m_semanticContextDecorator.decorate(record, true);
             if (result)
             {
-                IncomingEventContext evt(PAL::generateUuidString(), tenantToken, EventLatency_Normal, EventPersistence_Normal, &record);
+                IncomingEventContext evt(PAL::generateRecordId(), tenantToken, EventLatency_Normal, EventPersistence_Normal, &record);
                 m_iTelemetrySystem.sendEvent(&evt);
             }
             else
@@ -204,12 +204,7 @@ namespace MAT_NS_BEGIN {
         {
             LOCKGUARD(m_metaStats_mtx);
             m_metaStats.updateOnPackageFailed(status);
-            std::map<std::string, size_t> countOnTenant;
-            for (const auto& recordAndTenant : ctx->recordIdsAndTenantIds)
-            {
-                countOnTenant[recordAndTenant.second]++;
-            }
-            m_metaStats.updateOnRecordsRejected(REJECTED_REASON_SERVER_DECLINED, countOnTenant);
+            m_metaStats.updateOnRecordsRejected(REJECTED_REASON_SERVER_DECLINED, ctx->recordIdsAndTenantIds.countPerTenant());
         }
         scheduleSend();
         return true;
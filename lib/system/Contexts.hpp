@@ -33,14 +33,14 @@ namespace MAT_NS_BEGIN {
         }
 
 #ifdef HAVE_MAT_EVT_TRACEID   
-        IncomingEventContext(std::string const& id, std::string const& tenantToken, EventLatency latency, EventPersistence persistence, ::CsProtocol::Record* source)
+        IncomingEventContext(StorageRecordId id, std::string const& tenantToken, EventLatency latency, EventPersistence persistence, ::CsProtocol::Record* source)
             : source(source),
             record{ id, tenantToken, latency, persistence, (source != nullptr) ? source->cV : "" },
 	    policyBitFlags(0)
         {
         }
 #else
-        IncomingEventContext(std::string const& id, std::string const& tenantToken, EventLatency latency, EventPersistence persistence, ::CsProtocol::Record* source)
+        IncomingEventContext(StorageRecordId id, std::string const& tenantToken, EventLatency latency, EventPersistence persistence, ::CsProtocol::Record* source)
             : source(source),
             record{ id, tenantToken, latency, persistence },
 	    policyBitFlags(0)
@@ -57,6 +57,74 @@ namespace MAT_NS_BEGIN {
 
     //---
 
+    /**
+    * IDs of the records in an upload package and their tenant tokens. Tokens
+    * are stored once per tenant, each record keeps the index of its tenant.
+    */
+    class PackagedRecords {
+    public:
+        /**
+        * Returns the index of a tenant token, adding it if it is new
+        */
+        size_t addTenant(std::string const& tenantToken)
+        {
+            // Records mostly come in runs of the same tenant
+            if (m_lastTenant < m_tenants.size() && m_tenants[m_lastTenant] == tenantToken) {
+                return m_lastTenant;
+            }
+            for (m_lastTenant = 0; m_lastTenant < m_tenants.size(); m_lastTenant++) {
+                if (m_tenants[m_lastTenant] == tenantToken) {
+                    return m_lastTenant;
+                }
+            }
+            m_tenants.push_back(tenantToken);
+            return m_lastTenant;
+        }
+
+        void add(StorageRecordId recordId, size_t tenant)
+        {
+            m_ids.push_back(recordId);
+            m_recordTenants.push_back(static_cast<uint32_t>(tenant));
+        }
+
+        void add(StorageRecordId recordId, std::string const& tenantToken)
+        {
+            add(recordId, addTenant(tenantToken));
+        }
+
+        size_t size() const { return m_ids.size(); }
+        bool empty() const { return m_ids.empty(); }
+
+        std::vector<StorageRecordId> const& ids() const { return m_ids; }
+        std::vector<std::string> const& tenantTokens() const { return m_tenants; }
+
+        std::string const& tenantToken(size_t record) const
+        {
+            return m_tenants[m_recordTenants[record]];
+        }
+
+        std::map<std::string, size_t> countPerTenant() const
+        {
+            std::vector<size_t> counts(m_tenants.size());
+            for (uint32_t tenant : m_recordTenants) {
+                counts[tenant]++;
+            }
+            std::map<std::string, size_t> result;
+            for (size_t i = 0; i < m_tenants.size(); i++) {
+                result[m_tenants[i]] = counts[i];
+            }
+            return result;
+        }
+
+    protected:
+        std::vector<StorageRecordId> m_ids;
+        std::vector<uint32_t>        m_recordTenants;
+        std::vector<std::string>     m_tenants;
+        size_t                       m_lastTenant = 0;
+    };
+
+    //---
+
     class EventsUploadContext {
 
     private:
@@ -95,12 +163,14 @@ namespace MAT_NS_BEGIN {
         // Packaging
         std::unique_ptr<ISplicer>            splicer;
         unsigned                             maxUploadSize = 0;
+        bool                                 packageFull = false;  // More events were left than maxUploadSize allowed
         EventLatency                         latency = EventLatency_Unspecified;
         std::map<std::string, size_t>        packageIds;
 #ifdef HAVE_MAT_EVT_TRACEID  
         std::string                          traceId;
 #endif
-        std::map<std::string, std::string>   recordIdsAndTenantIds;
+        PackagedRecords                      recordIdsAndTenantIds;
+        std::vector<size_t>                  tenantPackages;  // Splicer package of each tenant of recordIdsAndTenantIds
         std::vector<int64_t>                 recordTimestamps;
         unsigned                             maxRetryCountSeen = 0;
 
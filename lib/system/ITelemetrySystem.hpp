@@ -46,6 +46,7 @@ namespace MAT_NS_BEGIN {
 
         // Core sendEvent
         virtual void sendEvent(IncomingEventContextPtr const& event) = 0;
+        virtual void sendEvents(std::vector<IncomingEventContextPtr> const& events) = 0;
 
     protected:
         virtual void handleFlushTaskDispatcher() = 0;
@@ -56,23 +56,39 @@ namespace MAT_NS_BEGIN {
         onStop = [this](void)
         {
             uint32_t timeoutInSec = m_config.GetTeardownTime();
+            bool persistOnly = m_config[CFG_BOOL_PERSIST_ON_TEARDOWN];
 
             bool result = true;
             int64_t stopTimes[5] = { 0, 0, 0, 0, 0 };
 
             // Perform upload only if not paused
-            if ((timeoutInSec > 0) && (!tpm.isPaused()))
+            if ((timeoutInSec > 0) && (!tpm.isPaused()) && (!persistOnly))
             {
                 // perform uploads if required
                 stopTimes[0] = GetUptimeMs();
                 LOG_TRACE("Shutdown timer started...");
+                tpm.beginTeardown();
+                size_t recordsAtLastUpload = storage.GetRecordCount();
                 upload();
                 // Try to push thru as much data as possible.
                 // If either data is available for upload or
                 // If there's outstanding request (some records marked in-flight),
                 // then try to wait for up to config[CFG_INT_MAX_TEARDOWN_TIME]
-                while (storage.GetRecordCount() || tpm.isUploadInProgress() )
+                for (;;)
                 {
+                    // Read the version first, so that a change while checking is not missed
+                    uint64_t uploadState = tpm.uploadStateVersion();
+                    size_t recordCount = storage.GetRecordCount();
+                    if (!tpm.isUploadInProgress())
+                    {
+                        // Start another round only while the previous one made progress
+                        if ((recordCount == 0) || (recordCount >= recordsAtLastUpload) || !upload())
+                        {
+                            break;
+                        }
+                        recordsAtLastUpload = recordCount;
+                        continue;
+                    }
                     auto uploadTime = GetUptimeMs() - stopTimes[0];
                     if (uploadTime >= (1000L * timeoutInSec))
                     {
@@ -80,7 +96,7 @@ namespace MAT_NS_BEGIN {
                         LOG_TRACE("Shutdown timer expired, exiting...");
                         break;
                     }
-                    MAT::sleep(100);
+                    tpm.waitForUploadStateChange(uploadState, std::chrono::milliseconds { 1000L * timeoutInSec - uploadTime });
                     LOG_INFO("offline records=%zu, pending uploads=%zu", storage.GetRecordCount(), hcm.requestCount());
                 }
                 stopTimes[0] = GetUptimeMs() - stopTimes[0];
@@ -88,6 +104,9 @@ namespace MAT_NS_BEGIN {
 
             // cancel all pending and force-finish all uploads
             stopTimes[1] = GetUptimeMs();
+            // Records left in memory are saved while the pipeline winds down,
+            // Shutdown() then only saves records released by aborted uploads
+            std::thread flushThread([this]() { storage.FlushForShutdown(); });
             // TODO: Should this still pause, since the TPM now has abort logic in addition to pause logic?
             // hcm.cancelAllRequests is also part of pause, so the logic is definitely redundant. Issue 387
             onPause();
@@ -109,6 +128,7 @@ namespace MAT_NS_BEGIN {
 
             // stop storage
             stopTimes[4] = GetUptimeMs();
+            flushThread.join();
             storage.stop();
             stopTimes[4] = GetUptimeMs() - stopTimes[4];
 
@@ -193,6 +213,12 @@ namespace MAT_NS_BEGIN {
         storage.trimmed >> stats.onStorageTrimmed;
         storage.recordsDropped >> stats.onStorageRecordsDropped;
         storage.recordsRejected >> stats.onStorageRecordsRejected;
+
+        HttpConnectionPoolOptions poolOptions;
+        poolOptions.maxConnectionsPerHost = static_cast<uint32_t>(m_config[CFG_MAP_HTTP][CFG_INT_HTTP_MAX_CONNECTIONS_PER_HOST]);
+        poolOptions.idleTimeoutMs = static_cast<uint32_t>(m_config[CFG_MAP_HTTP][CFG_INT_HTTP_IDLE_TIMEOUT]);
+        poolOptions.maxConsecutiveFailures = static_cast<uint32_t>(m_config[CFG_MAP_HTTP][CFG_INT_HTTP_MAX_CONNECTION_FAILURES]);
+        httpClient.SetConnectionPoolOptions(poolOptions);
     }
 
     TelemetrySystem::~TelemetrySystem()
@@ -211,7 +237,53 @@ namespace MAT_NS_BEGIN {
         return false;
     }
 
-    void TelemetrySystem::handleIncomingEventPrepared(IncomingEventContextPtr const& event)
+    /// <summary>
+    /// Serializes and stores a batch of events, then notifies stats and TPM.
+    /// Storage is written with a single StoreRecords call for the whole batch.
+    /// </summary>
+    /// <param name="events">The events.</param>
+    void TelemetrySystem::sendEvents(std::vector<IncomingEventContextPtr> const& events)
+    {
+        std::vector<IncomingEventContextPtr> prepared;
+        prepared.reserve(events.size());
+        for (const auto& event : events)
+        {
+            if (bondSerializer.serialize(event) && isEventSizeAllowed(event))
+            {
+                event->source = nullptr;
+                prepared.push_back(event);
+            }
+        }
+
+        if (prepared.empty() || !storage.storeRecords(prepared))
+        {
+            return;
+        }
+
+        // TPM scheduling only depends on the latency of the incoming event,
+        // so it is notified once per latency present in the batch.
+        IncomingEventContextPtr lastOfLatency[EventLatency_Max + 1] = {};
+        for (const auto& event : prepared)
+        {
+            if (stats.onIncomingEventAccepted(event))
+            {
+                const auto latency = event->record.latency;
+                if ((latency >= EventLatency_Off) && (latency <= EventLatency_Max))
+                {
+                    lastOfLatency[latency] = event;
+                }
+            }
+        }
+        for (const auto& event : lastOfLatency)
+        {
+            if (event != nullptr)
+            {
+                tpm.eventArrived(event);
+            }
+        }
+    }
+
+    bool TelemetrySystem::isEventSizeAllowed(IncomingEventContextPtr const& event)
     {
         uint32_t maxBlobSize = m_config[CFG_MAP_TPM][CFG_INT_TPM_MAX_BLOB_BYTES];
         if (event->record.blob.size() > maxBlobSize)
@@ -222,6 +294,15 @@ namespace MAT_NS_BEGIN {
             m_logManager.DispatchEvent(evt);
             LOG_INFO("Event %s/%s dropped because size more than 2 MB",
                 tenantTokenToId(event->record.tenantToken).c_str(), event->source->baseType.c_str());
+            return false;
+        }
+        return true;
+    }
+
+    void TelemetrySystem::handleIncomingEventPrepared(IncomingEventContextPtr const& event)
+    {
+        if (!isEventSizeAllowed(event))
+        {
             return;
         }
 
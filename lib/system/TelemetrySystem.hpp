@@ -55,12 +55,15 @@ namespace MAT_NS_BEGIN {
         ~TelemetrySystem();
 
         virtual bool upload() override;
+        virtual void sendEvents(std::vector<IncomingEventContextPtr> const& events) override;
         virtual void handleIncomingEventPrepared(IncomingEventContextPtr const& event) override;
 
     protected:
 
         virtual void handleFlushTaskDispatcher() override;
 
+        bool isEventSizeAllowed(IncomingEventContextPtr const& event);
+
 #ifdef HAVE_MAT_ZLIB
         HttpDeflateCompression    compression;
 #else
@@ -34,6 +34,7 @@ namespace MAT_NS_BEGIN {
             m_config(runtimeConfig),
             m_isStarted(false),
             m_isPaused(false),
+            bondSerializer(runtimeConfig),
             stats(*this, taskDispatcher)
         {
             onStart  = []() { return true; };
@@ -139,6 +140,14 @@ namespace MAT_NS_BEGIN {
             sending(event);
         }
 
+        virtual void sendEvents(std::vector<IncomingEventContextPtr> const& events) override
+        {
+            for (const auto& event : events)
+            {
+                sending(event);
+            }
+        }
+
         /// <summary>
         /// Gets the log manager.
         /// </summary>
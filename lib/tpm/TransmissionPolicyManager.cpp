@@ -14,9 +14,12 @@ namespace MAT_NS_BEGIN {
     class PauseGuard {
     public:
         PauseGuard() = delete;
-        PauseGuard(ILogManager & logManager)
+        // During teardown the activity is paused on purpose, while the system
+        // still waits for the last uploads
+        PauseGuard(ILogManager & logManager, bool isTearingDown)
         : m_logManager(logManager)
-        , m_unpaused(m_logManager.StartActivity())
+        , m_isTearingDown(isTearingDown)
+        , m_unpaused(!isTearingDown && m_logManager.StartActivity())
         {}
 
         ~PauseGuard()
@@ -28,10 +31,11 @@ namespace MAT_NS_BEGIN {
 
         bool isPaused() const noexcept
         {
-            return !m_unpaused;
+            return !m_unpaused && !m_isTearingDown;
         }
     private:
         ILogManager& m_logManager;
+        bool m_isTearingDown;
         bool m_unpaused;
     };
 
@@ -51,6 +55,7 @@ namespace MAT_NS_BEGIN {
     {
         m_backoff = IBackoff::createFromConfig(m_backoffConfig);
         assert(m_backoff);
+        laneFor(EventLatency_Max).interval = std::chrono::milliseconds {};
         m_deviceStateHandler.Start();
     }
 
@@ -102,7 +107,7 @@ namespace MAT_NS_BEGIN {
     // If delayInMs is negative, do not schedule.
     void TransmissionPolicyManager::scheduleUpload(const std::chrono::milliseconds& delay, EventLatency latency, bool force)
     {
-        PauseGuard guard(m_system.getLogManager());
+        PauseGuard guard(m_system.getLogManager(), m_isTearingDown);
         if (guard.isPaused()) {
             return;
         }
@@ -112,21 +117,11 @@ namespace MAT_NS_BEGIN {
             return;
         }
         LOCKGUARD(m_scheduledUploadMutex);
-        if (delay.count() < 0 || m_timerdelay.count() < 0)
-        {
-            LOG_TRACE("Negative delay(%d) or m_timerdelay(%d), no upload", delay.count(), m_timerdelay.count());
-            return;
-        }
         if (m_scheduledUploadAborted)
         {
             LOG_TRACE("Scheduled upload aborted, no upload.");
             return;
         }
-        if (uploadCount() >= static_cast<uint32_t>(m_config[CFG_INT_MAX_PENDING_REQ]) )
-        {
-            LOG_TRACE("Maximum number of HTTP requests reached");
-            return;
-        }
 
         if (m_isPaused)
         {
@@ -139,22 +134,35 @@ namespace MAT_NS_BEGIN {
             latency = std::max(latency, EventLatency_RealTime); // low priority disabled by profile
         }
 
-        if ((!force)&&(m_isUploadScheduled))
+        UploadLane& lane = laneFor(latency);
+        if (delay.count() < 0 || lane.interval.count() < 0)
+        {
+            LOG_TRACE("Negative delay(%d) or lane interval(%d), no upload", delay.count(), lane.interval.count());
+            return;
+        }
+
         {
-            if (m_runningLatency > latency)
+            LOCKGUARD(m_activeUploads_lock);
+            if (!canStartUpload(lane))
             {
-                // Allow lower priority (normal) events to get thru in the next batch
-                m_runningLatency = latency;
+                // The lane is picked up again when one of the running uploads finishes
+                lane.waiting = true;
+                LOG_TRACE("Maximum number of HTTP requests reached for lat=%d", lane.latency);
+                return;
             }
+        }
+
+        if ((!force)&&(lane.isUploadScheduled))
+        {
             auto now = PAL::getMonotonicTimeMs();
-            auto delta = Abs64(m_scheduledUploadTime, now);
+            auto delta = Abs64(lane.scheduledUploadTime, now);
             if (delta <= static_cast<uint64_t>(delay.count()))
             {
                 // Don't need to cancel and reschedule if it's about to happen now anyways.
-                // m_isUploadScheduled check does not have to be strictly atomic because
+                // isUploadScheduled check does not have to be strictly atomic because
                 // the completion of upload will schedule more uploads as-needed, we only
                 // want to avoid the unnecessary wasteful rescheduling.
-                LOG_TRACE("WAIT  upload %d ms for lat=%d", delta, m_runningLatency);
+                LOG_TRACE("WAIT  upload %d ms for lat=%d", delta, lane.latency);
                 return;
             }
         }
@@ -162,43 +170,42 @@ namespace MAT_NS_BEGIN {
         // Cancel upload if already scheduled.
         if (force || delay.count() == 0)
         {
-            if (!cancelUploadTask())
+            if (!cancelUploadTask(lane))
             {
                 LOG_TRACE("Upload either hasn't been scheduled or already done.");
             }
         }
 
         // Schedule new upload
-        if (!m_isUploadScheduled.exchange(true))
+        if (!lane.isUploadScheduled.exchange(true))
         {
-            m_scheduledUploadTime = PAL::getMonotonicTimeMs() + delay.count();
-            m_runningLatency = latency;
-            LOG_TRACE("SCHED upload %d ms for lat=%d", delay.count(), m_runningLatency);
-            m_scheduledUpload = PAL::scheduleTask(&m_taskDispatcher, static_cast<unsigned>(delay.count()), this, &TransmissionPolicyManager::uploadAsync, latency);
+            lane.scheduledUploadTime = PAL::getMonotonicTimeMs() + delay.count();
+            LOG_TRACE("SCHED upload %d ms for lat=%d", delay.count(), lane.latency);
+            lane.scheduledUpload = PAL::scheduleTask(&m_taskDispatcher, static_cast<unsigned>(delay.count()), this, &TransmissionPolicyManager::uploadAsync, lane.latency);
         }
     }
 
     void TransmissionPolicyManager::uploadAsync(EventLatency latency)
     {
-        PauseGuard guard(m_system.getLogManager());
+        PauseGuard guard(m_system.getLogManager(), m_isTearingDown);
         if (guard.isPaused()) {
             return;
         }
-        m_runningLatency = latency;
-        m_scheduledUploadTime = std::numeric_limits<uint64_t>::max();
+        UploadLane& lane = laneFor(latency);
+        lane.scheduledUploadTime = std::numeric_limits<uint64_t>::max();
 
         {
             LOCKGUARD(m_scheduledUploadMutex);
-            m_isUploadScheduled = false;  // Allow to schedule another uploadAsync
+            lane.isUploadScheduled = false;  // Allow to schedule another uploadAsync
             if ((m_isPaused) || (m_scheduledUploadAborted))
             {
                 LOG_TRACE("Paused or upload aborted: cancel pending upload task.");
                 cancelUploadTask();  // If there is a pending upload task, kill it
+                notifyUploadStateChanged();
                 return;
             }
         }
 
-#ifdef ENABLE_BW_CONTROLLER   /* Bandwidth controller is not currently supported */
         if (m_bandwidthController) {
             unsigned proposedBandwidthBps = m_bandwidthController->GetProposedBandwidthBps();
             unsigned minimumBandwidthBps = m_config.GetMinimumUploadBandwidthBps();
@@ -210,15 +217,20 @@ namespace MAT_NS_BEGIN {
                 unsigned delayMs = 1000;
                 LOG_INFO("Bandwidth controller proposed bandwidth %u bytes/sec but minimum accepted is %u, will retry %u ms later",
                     proposedBandwidthBps, minimumBandwidthBps, delayMs);
-                scheduleUpload(delayMs, latency); // reschedule uploadAsync to run again 1000 ms later
+                scheduleUpload(std::chrono::milliseconds { delayMs }, lane.latency); // reschedule uploadAsync to run again 1000 ms later
                 return;
             }
         }
-#endif
 
         auto ctx = m_system.createEventsUploadContext();
-        ctx->requestedMinLatency = m_runningLatency;
-        addUpload(ctx);
+        ctx->requestedMinLatency = lane.latency;
+        ctx->maxUploadSize = uploadBudget(lane);
+        if (!tryAddUpload(ctx))
+        {
+            LOG_TRACE("No free HTTP request for lat=%d, waiting for a running upload to finish", lane.latency);
+            notifyUploadStateChanged();
+            return;
+        }
         initiateUpload(ctx);
     }
 
@@ -231,17 +243,28 @@ namespace MAT_NS_BEGIN {
             LOG_WARN("HTTP NOT removing non-existing ctx from active uploads ctx=%p", ctx.get());
         }
 
-        PauseGuard guard(m_system.getLogManager());
-        if (guard.isPaused()) {
-            return;
-        }
-        // Rescheduling upload
-        if (nextUpload.count() >= 0)
         {
-            LOG_TRACE("Scheduling upload in %d ms", nextUpload.count());
-            EventLatency proposed = calculateNewPriority();
-            scheduleUpload(nextUpload, proposed); // reschedule uploadAsync again
+            PauseGuard guard(m_system.getLogManager(), m_isTearingDown);
+            if (!guard.isPaused())
+            {
+                // Hand the freed HTTP request over to a lane that had to wait for one
+                EventLatency waitingLatency;
+                if (takeWaitingLane(waitingLatency))
+                {
+                    LOG_TRACE("Resuming upload for lat=%d", waitingLatency);
+                    scheduleUpload(std::chrono::milliseconds{}, waitingLatency);
+                }
+
+                // Rescheduling upload
+                if (nextUpload.count() >= 0)
+                {
+                    LOG_TRACE("Scheduling upload in %d ms", nextUpload.count());
+                    scheduleUpload(nextUpload, laneFor(ctx->requestedMinLatency).latency); // reschedule uploadAsync again
+                }
+            }
         }
+        // Waiters see the upload gone and its follow-up already scheduled
+        notifyUploadStateChanged();
     }
 
     bool TransmissionPolicyManager::updateTimersIfNecessary()
@@ -250,14 +273,72 @@ namespace MAT_NS_BEGIN {
         if (needsUpdate)
         {
             TransmitProfiles::getTimers(m_timers);
+            laneFor(EventLatency_Normal).interval = std::chrono::milliseconds { m_timers[0] };
+            laneFor(EventLatency_RealTime).interval = std::chrono::milliseconds { m_timers[1] };
         }
         return needsUpdate;
     }
 
+    UploadLane& TransmissionPolicyManager::laneFor(EventLatency latency)
+    {
+        // CostDeferred and Normal events share a lane: profiles have no
+        // separate timer for them and Normal uploads carry both
+        if (latency > EventLatency_RealTime)
+        {
+            return m_lanes[2];
+        }
+        return (latency == EventLatency_RealTime) ? m_lanes[1] : m_lanes[0];
+    }
+
+    unsigned TransmissionPolicyManager::uploadBudget(UploadLane const& lane) const
+    {
+        unsigned budget = std::max(1u, m_config.GetMaximumUploadSizeBytes() / std::max(lane.budgetDivisor, 1u));
+        unsigned proposedBps = proposedBandwidthBps();
+        if (proposedBps != std::numeric_limits<unsigned>::max())
+        {
+            uint64_t paced = uint64_t { proposedBps } * UploadPacingInterval.count() / 1000;
+            budget = static_cast<unsigned>(std::min<uint64_t>(budget, std::max<uint64_t>(paced, MinPacedUploadSize)));
+        }
+        return budget;
+    }
+
+    unsigned TransmissionPolicyManager::proposedBandwidthBps() const
+    {
+        // No controller or no estimate yet: uploads are not paced
+        return (m_bandwidthController != nullptr) ? m_bandwidthController->GetProposedBandwidthBps() : std::numeric_limits<unsigned>::max();
+    }
+
+    std::chrono::milliseconds TransmissionPolicyManager::reportUploadCompleted(EventsUploadContextPtr const& ctx)
+    {
+        if ((m_bandwidthController == nullptr) || (ctx->httpRequest == nullptr) || (ctx->durationMs < 0))
+        {
+            return std::chrono::milliseconds {};
+        }
+
+        unsigned bytes = static_cast<unsigned>(ctx->httpRequest->GetSizeEstimate());
+        m_bandwidthController->OnUploadCompleted(bytes, static_cast<unsigned>(ctx->durationMs), !ctx->packageFull);
+
+        // Leave a gap before the next upload of the lane, so that on average
+        // the lane does not send faster than the proposed bandwidth
+        unsigned proposedBps = m_bandwidthController->GetProposedBandwidthBps();
+        if ((proposedBps == 0) || (proposedBps == std::numeric_limits<unsigned>::max()))
+        {
+            return std::chrono::milliseconds {};
+        }
+        int64_t gapMs = static_cast<int64_t>(uint64_t { bytes } * 1000 / proposedBps) - ctx->durationMs;
+        if (gapMs > 0)
+        {
+            LOG_TRACE("Pacing: next upload for lat=%d in %lld ms at %u bytes/sec", ctx->requestedMinLatency, gapMs, proposedBps);
+        }
+        return std::chrono::milliseconds { std::max<int64_t>(gapMs, 0) };
+    }
+
     bool TransmissionPolicyManager::handleStart()
     {
+        m_isTearingDown = false;
         m_isPaused = false;
-        scheduleUpload(std::chrono::seconds{1}, calculateNewPriority());
+        // Normal uploads drain events of all latencies left from previous sessions
+        scheduleUpload(std::chrono::seconds{1}, EventLatency_Normal);
         return true;
     }
 
@@ -289,10 +370,7 @@ namespace MAT_NS_BEGIN {
         }
 
         // Make sure we wait for all active upload callbacks to finish
-        while (uploadCount() > 0)
-        {
-            std::this_thread::yield();
-        }
+        waitForUploadsToFinish();
         allUploadsFinished();
         return true;
     }
@@ -307,10 +385,7 @@ namespace MAT_NS_BEGIN {
      {
         cancelUploadTask();
         // Make sure ongoing uploads are finished.
-        while (uploadCount() > 0)
-        {
-            std::this_thread::yield();
-        }
+        waitForUploadsToFinish();
 
         allUploadsFinished();
         return true;
@@ -336,79 +411,60 @@ namespace MAT_NS_BEGIN {
         if (event->record.latency > EventLatency_RealTime) {
             auto ctx = m_system.createEventsUploadContext();
             ctx->requestedMinLatency = event->record.latency;
-            addUpload(ctx);
-            initiateUpload(ctx);
+            ctx->maxUploadSize = uploadBudget(laneFor(event->record.latency));
+            if (tryAddUpload(ctx))
+            {
+                initiateUpload(ctx);
+            }
             return;
         }
 
         // Schedule async upload if not scheduled yet
-        if (!m_isUploadScheduled || TransmitProfiles::isTimerUpdateRequired())
+        UploadLane& lane = laneFor(event->record.latency);
+        if (!lane.isUploadScheduled || TransmitProfiles::isTimerUpdateRequired())
         {
             if (updateTimersIfNecessary())
             {
-                m_timerdelay = std::chrono::milliseconds { m_timers[1] };
                 forceTimerRestart = true;
             }
-            EventLatency proposed = calculateNewPriority();
-            if (m_timerdelay.count() >= 0)
+            if (lane.interval.count() >= 0)
             {
-                scheduleUpload(m_timerdelay, proposed, forceTimerRestart);
+                scheduleUpload(lane.interval, lane.latency, forceTimerRestart);
             }
         }
     }
 
-    // We do only Normal if too few values or timers[0] == timers[2]
-    // We do only RealTime if timers[0] < 0 (do not transmit)
-    // We alternate RealTime and Normal otherwise (timers differ)
-    EventLatency TransmissionPolicyManager::calculateNewPriority()
-    {
-        updateTimersIfNecessary();
-
-        if (m_timers[0] == m_timers[1])
-        {
-            return EventLatency_Normal;
-        }
-
-        if (m_timers[0] < 0)
-        {
-            return EventLatency_RealTime;
-        }
-
-        if (m_runningLatency == EventLatency_RealTime)
-        {
-            return EventLatency_Normal;
-        }
-
-        return EventLatency_RealTime;
-    }
-
     void TransmissionPolicyManager::handleNothingToUpload(EventsUploadContextPtr const& ctx)
     {
         LOG_TRACE("No stored events to send at the moment");
         resetBackoff();
-        if (ctx->requestedMinLatency == EventLatency_Normal)
+        if (ctx->requestedMinLatency == EventLatency_RealTime)
         {
+            // Let the Normal lane pick up whatever is left before going idle
             finishUpload(ctx, std::chrono::milliseconds{ -1 });
+            scheduleUpload(laneFor(EventLatency_RealTime).interval, EventLatency_Normal);
         }
         else
         {
-            finishUpload(ctx, m_timerdelay);
+            finishUpload(ctx, std::chrono::milliseconds{ -1 });
         }
     }
 
     void TransmissionPolicyManager::handlePackagingFailed(EventsUploadContextPtr const& ctx)
     {
-        finishUpload(ctx, m_timerdelay);
+        finishUpload(ctx, laneFor(ctx->requestedMinLatency).interval);
     }
 
     void TransmissionPolicyManager::handleEventsUploadSuccessful(EventsUploadContextPtr const& ctx)
     {
         resetBackoff();
-        finishUpload(ctx, std::chrono::milliseconds{});
+        finishUpload(ctx, reportUploadCompleted(ctx));
     }
 
     void TransmissionPolicyManager::handleEventsUploadRejected(EventsUploadContextPtr const& ctx)
     {
+        // The request still went over the link
+        reportUploadCompleted(ctx);
         finishUpload(ctx, increaseBackoff());
     }
 
@@ -425,7 +481,29 @@ namespace MAT_NS_BEGIN {
     void TransmissionPolicyManager::addUpload(EventsUploadContextPtr const& ctx)
     {
         LOCKGUARD(m_activeUploads_lock);
-        m_activeUploads.insert(ctx);
+        if (m_activeUploads.insert(ctx).second)
+        {
+            UploadLane& lane = laneFor(ctx->requestedMinLatency);
+            lane.inFlight++;
+            lane.inFlightBytes += ctx->maxUploadSize;
+        }
+    }
+
+    bool TransmissionPolicyManager::tryAddUpload(EventsUploadContextPtr const& ctx)
+    {
+        LOCKGUARD(m_activeUploads_lock);
+        UploadLane& lane = laneFor(ctx->requestedMinLatency);
+        if (!canStartUpload(lane))
+        {
+            lane.waiting = true;
+            return false;
+        }
+        if (m_activeUploads.insert(ctx).second)
+        {
+            lane.inFlight++;
+            lane.inFlightBytes += ctx->maxUploadSize;
+        }
+        return true;
     }
 
     bool TransmissionPolicyManager::removeUpload(EventsUploadContextPtr const& ctx)
@@ -436,14 +514,92 @@ namespace MAT_NS_BEGIN {
         {
             LOG_TRACE("HTTP removing from active uploads ctx=%p", ctx.get());
             m_activeUploads.erase(it);
+            UploadLane& lane = laneFor(ctx->requestedMinLatency);
+            if (lane.inFlight > 0)
+            {
+                lane.inFlight--;
+            }
+            lane.inFlightBytes -= std::min<uint64_t>(lane.inFlightBytes, ctx->maxUploadSize);
             return true;
         }
         return false;
     }
 
+    bool TransmissionPolicyManager::canStartUpload(UploadLane const& lane) const
+    {
+        size_t maxPending = std::max(1, static_cast<int>(m_config[CFG_INT_MAX_PENDING_REQ]));
+        if (m_activeUploads.size() >= maxPending)
+        {
+            return false;
+        }
+
+        unsigned totalWeight = 0;
+        for (auto const& other : m_lanes)
+        {
+            totalWeight += other.weight;
+        }
+        auto share = [&](UploadLane const& l) {
+            return std::max<size_t>(1, maxPending * l.weight / totalWeight);
+        };
+
+        // Lanes are ordered by priority: borrow only what lower lanes leave unused
+        size_t limit = share(lane);
+        for (auto const& other : m_lanes)
+        {
+            if (&other == &lane)
+            {
+                break;
+            }
+            size_t otherShare = share(other);
+            limit += (other.inFlight < otherShare) ? (otherShare - other.inFlight) : 0;
+        }
+        if (lane.inFlight >= limit)
+        {
+            return false;
+        }
+
+        // Paced bulk uploads keep at most two pacing intervals worth of data in
+        // flight, like BBR's congestion window gain. Higher latency lanes carry
+        // small packages and are not held back.
+        unsigned proposedBps = proposedBandwidthBps();
+        if ((&lane == &m_lanes[0]) && (lane.inFlight > 0) && (proposedBps != std::numeric_limits<unsigned>::max()))
+        {
+            uint64_t window = 2 * uint64_t { proposedBps } * UploadPacingInterval.count() / 1000;
+            return lane.inFlightBytes + uploadBudget(lane) <= window;
+        }
+        return true;
+    }
+
+    bool TransmissionPolicyManager::takeWaitingLane(EventLatency& latency)
+    {
+        LOCKGUARD(m_activeUploads_lock);
+        UploadLane* next = nullptr;
+        // Highest priority first, so that it wins ties
+        for (size_t i = LaneCount; i-- > 0;)
+        {
+            UploadLane& lane = m_lanes[i];
+            if (!lane.waiting || !canStartUpload(lane))
+            {
+                continue;
+            }
+            // Weighted fair queueing: the lane with the least requests per weight goes next
+            if ((next == nullptr) || ((lane.inFlight + 1) * next->weight < (next->inFlight + 1) * lane.weight))
+            {
+                next = &lane;
+            }
+        }
+        if (next == nullptr)
+        {
+            return false;
+        }
+        next->waiting = false;
+        latency = next->latency;
+        return true;
+    }
+
     void TransmissionPolicyManager::pauseAllUploads()
     {
-        PauseGuard guard(m_system.getLogManager());
+        PauseGuard guard(m_system.getLogManager(), m_isTearingDown);
         m_isPaused = true;
         cancelUploadTask();
     }
@@ -455,14 +611,24 @@ namespace MAT_NS_BEGIN {
 
     bool TransmissionPolicyManager::cancelUploadTask()
     {
-        bool result = m_scheduledUpload.Cancel(getCancelWaitTime().count());
+        bool result = false;
+        for (auto& lane : m_lanes)
+        {
+            result |= cancelUploadTask(lane);
+        }
+        return result;
+    }
+
+    bool TransmissionPolicyManager::cancelUploadTask(UploadLane& lane)
+    {
+        bool result = lane.scheduledUpload.Cancel(getCancelWaitTime().count());
 
         // TODO: There is a potential for upload tasks to not be canceled, especially if they aren't waited for.
         //       We either need a stronger guarantee here (could impact SDK performance), or a mechanism to
         //       ensure those tasks are canceled when the log manager is destroyed. Issue 388
         if (result)
         {
-            m_isUploadScheduled.exchange(false);
+            lane.isUploadScheduled.exchange(false);
         }
         return result;
     }
@@ -476,7 +642,18 @@ namespace MAT_NS_BEGIN {
     bool TransmissionPolicyManager::isUploadInProgress() const noexcept
     {
         // unfinished uploads that haven't processed callbacks or pending upload task
-        return (uploadCount() > 0) || m_isUploadScheduled;
+        if (uploadCount() > 0)
+        {
+            return true;
+        }
+        for (auto const& lane : m_lanes)
+        {
+            if (lane.isUploadScheduled)
+            {
+                return true;
+            }
+        }
+        return false;
     }
 
     bool TransmissionPolicyManager::isPaused() const noexcept
@@ -484,4 +661,35 @@ namespace MAT_NS_BEGIN {
         return m_isPaused;
     }
 
+    void TransmissionPolicyManager::beginTeardown()
+    {
+        m_isTearingDown = true;
+    }
+
+    uint64_t TransmissionPolicyManager::uploadStateVersion()
+    {
+        LOCKGUARD(m_uploadStateMutex);
+        return m_uploadStateVersion;
+    }
+
+    bool TransmissionPolicyManager::waitForUploadStateChange(uint64_t version, std::chrono::milliseconds timeout)
+    {
+        std::unique_lock<std::mutex> lock(m_uploadStateMutex);
+        return m_uploadStateChanged.wait_for(lock, timeout, [this, version]() { return m_uploadStateVersion != version; });
+    }
+
+    void TransmissionPolicyManager::notifyUploadStateChanged()
+    {
+        LOCKGUARD(m_uploadStateMutex);
+        m_uploadStateVersion++;
+        m_uploadStateChanged.notify_all();
+    }
+
+    void TransmissionPolicyManager::waitForUploadsToFinish()
+    {
+        // finishUpload notifies after removing the upload, so no wakeup is lost
+        std::unique_lock<std::mutex> lock(m_uploadStateMutex);
+        m_uploadStateChanged.wait(lock, [this]() { return uploadCount() == 0; });
+    }
+
 } MAT_NS_END
@@ -22,6 +22,7 @@
 
 #include <atomic>
 #include <chrono>
+#include <condition_variable>
 #include <cstdint>
 #include <limits>
 #include <set>
@@ -42,6 +43,40 @@ constexpr std::chrono::milliseconds DefaultTaskCancelTime { 500 };
 
 constexpr const char* const DefaultBackoffConfig = "E,3000,300000,2,1";
 
+// Paced uploads carry what the proposed bandwidth moves in one interval, but
+// not less than the minimum size, so that per-request overhead stays small.
+constexpr std::chrono::milliseconds UploadPacingInterval { 1000 };
+constexpr unsigned MinPacedUploadSize = 16 * 1024;
+
+    /// <summary>
+    /// Upload lane of one latency class. Each lane runs its own upload timer
+    /// and tracks its own in-flight uploads, so that a large upload of one
+    /// class never holds back uploads of another.
+    /// </summary>
+    struct UploadLane
+    {
+        UploadLane(EventLatency latency, unsigned weight, unsigned budgetDivisor) :
+            latency(latency),
+            weight(weight),
+            budgetDivisor(budgetDivisor)
+        {
+        }
+
+        const EventLatency               latency;          // Minimum latency of the events the lane uploads
+        const unsigned                   weight;           // Weighted share of CFG_INT_MAX_PENDING_REQ
+        const unsigned                   budgetDivisor;    // Upload size is the configured maximum divided by this
+
+        std::chrono::milliseconds        interval { std::chrono::seconds { 2 } };
+        std::atomic<bool>                isUploadScheduled { false };
+        uint64_t                         scheduledUploadTime { std::numeric_limits<uint64_t>::max() };
+        PAL::DeferredCallbackHandle      scheduledUpload;
+
+        // Guarded by m_activeUploads_lock
+        size_t                           inFlight { 0 };
+        uint64_t                         inFlightBytes { 0 };   // Sum of the upload budgets
+        bool                             waiting { false };  // Wanted to upload while all of its slots were busy
+    };
+
     class TransmissionPolicyManager
     {
 
@@ -60,6 +95,12 @@ constexpr const char* const DefaultBackoffConfig = "E,3000,300000,2,1";
         void finishUpload(EventsUploadContextPtr const& ctx, const std::chrono::milliseconds& nextUpload);
         bool updateTimersIfNecessary();
 
+        static constexpr size_t LaneCount = 3;
+        UploadLane& laneFor(EventLatency latency);
+        unsigned uploadBudget(UploadLane const& lane) const;
+        unsigned proposedBandwidthBps() const;
+        std::chrono::milliseconds reportUploadCompleted(EventsUploadContextPtr const& ctx);
+
         bool handleStart();
         bool handlePause();
         bool handleStop();
@@ -75,8 +116,6 @@ constexpr const char* const DefaultBackoffConfig = "E,3000,300000,2,1";
         void handleEventsUploadFailed(EventsUploadContextPtr const& ctx);
         void handleEventsUploadAborted(EventsUploadContextPtr const& ctx);
 
-        EventLatency calculateNewPriority();
-
         std::mutex                       m_lock;
 
         ITelemetrySystem&                m_system;
@@ -90,14 +129,32 @@ constexpr const char* const DefaultBackoffConfig = "E,3000,300000,2,1";
         DeviceStateHandler               m_deviceStateHandler;
 
         std::atomic<bool>                m_isPaused { true };
-        std::atomic<bool>                m_isUploadScheduled { false };
-        uint64_t                         m_scheduledUploadTime { std::numeric_limits<uint64_t>::max() };
+        std::atomic<bool>                m_isTearingDown { false };
         std::mutex                       m_scheduledUploadMutex;
-        PAL::DeferredCallbackHandle      m_scheduledUpload;
         bool                             m_scheduledUploadAborted { false };
 
+        // Lanes ordered by priority. Immediate (Max) latency events are
+        // sent right away but still share the in-flight limit.
+        UploadLane                       m_lanes[LaneCount] {
+            { EventLatency_Normal,   1, 1 },
+            { EventLatency_RealTime, 2, 4 },
+            { EventLatency_Max,      4, 4 }
+        };
+
         mutable std::mutex               m_activeUploads_lock;
         std::set<EventsUploadContextPtr> m_activeUploads;
+
+        // Bumped whenever an upload finishes or a scheduled upload is dropped
+        std::mutex                       m_uploadStateMutex;
+        std::condition_variable          m_uploadStateChanged;
+        uint64_t                         m_uploadStateVersion { 0 };
+
+        void notifyUploadStateChanged();
+
+        /// <summary>
+        /// Blocks until there are no active uploads left.
+        /// </summary>
+        void waitForUploadsToFinish();
         
         /// <summary>
         /// Thread-safe method to add the upload to active uploads.
@@ -105,12 +162,35 @@ constexpr const char* const DefaultBackoffConfig = "E,3000,300000,2,1";
         /// <param name="ctx">The CTX.</param>
         void addUpload(EventsUploadContextPtr const& ctx);
         
+        /// <summary>
+        /// Thread-safe method to add the upload to active uploads if its lane
+        /// is allowed another HTTP request, otherwise marks the lane as waiting.
+        /// </summary>
+        /// <param name="ctx">The CTX.</param>
+        /// <returns>true if the upload was added.</returns>
+        bool tryAddUpload(EventsUploadContextPtr const& ctx);
+
         /// <summary>
         /// Thread-safe method to remove the upload from active uploads.
         /// </summary>
         /// <param name="ctx">The CTX.</param>
         /// <returns></returns>
         bool removeUpload(EventsUploadContextPtr const& ctx);
+
+        /// <summary>
+        /// Checks whether the lane may start another upload: every lane is
+        /// guaranteed its weighted share of CFG_INT_MAX_PENDING_REQ and may
+        /// borrow the unused share of lower priority lanes. Must be called
+        /// with m_activeUploads_lock held.
+        /// </summary>
+        bool canStartUpload(UploadLane const& lane) const;
+
+        /// <summary>
+        /// Picks the waiting lane that uses the smallest part of its share.
+        /// </summary>
+        /// <param name="latency">Latency of the picked lane.</param>
+        /// <returns>false if no waiting lane may start an upload.</returns>
+        bool takeWaitingLane(EventLatency& latency);
         
         /// <summary>
         /// Cancel pending upload task and stop scheduling further uploads.
@@ -120,9 +200,14 @@ constexpr const char* const DefaultBackoffConfig = "E,3000,300000,2,1";
         std::chrono::milliseconds getCancelWaitTime() const noexcept;
 
         /// <summary>
-        /// Cancels pending upload task.
+        /// Cancels pending upload tasks of all lanes.
         /// </summary>
         bool cancelUploadTask();
+
+        /// <summary>
+        /// Cancels pending upload task of the lane.
+        /// </summary>
+        bool cancelUploadTask(UploadLane& lane);
         
         /// <summary>
         /// Calculate the number of pending upload contexts.
@@ -130,8 +215,6 @@ constexpr const char* const DefaultBackoffConfig = "E,3000,300000,2,1";
         /// <returns></returns>
         size_t uploadCount() const noexcept;
 
-        std::chrono::milliseconds        m_timerdelay { std::chrono::seconds { 2 } };
-        EventLatency                     m_runningLatency { EventLatency_RealTime };
         TimerArray                       m_timers;
 
     public:
@@ -155,6 +238,24 @@ constexpr const char* const DefaultBackoffConfig = "E,3000,300000,2,1";
         virtual bool isUploadInProgress() const noexcept;
 
         virtual bool isPaused() const noexcept;
+
+        /// <summary>
+        /// Keeps uploading while the log manager activity is paused for
+        /// teardown. The caller must wait for the uploads to finish.
+        /// </summary>
+        virtual void beginTeardown();
+
+        /// <summary>
+        /// Current version of the upload state, to be passed to waitForUploadStateChange.
+        /// </summary>
+        uint64_t uploadStateVersion();
+
+        /// <summary>
+        /// Waits until an upload finishes or a scheduled upload is dropped
+        /// after the given version was read.
+        /// </summary>
+        /// <returns>false on timeout</returns>
+        bool waitForUploadStateChange(uint64_t version, std::chrono::milliseconds timeout);
     };
 
 } MAT_NS_END
@@ -71,7 +71,76 @@ namespace MAT_NS_BEGIN {
     size_t      TransmitProfiles::currRule = 0;
     NetworkCost TransmitProfiles::currNetCost = NetworkCost::NetworkCost_Any;
     PowerSource TransmitProfiles::currPowState = PowerSource::PowerSource_Any;
-    bool        TransmitProfiles::isTimerUpdated = true;
+    std::atomic<bool> TransmitProfiles::isTimerUpdated { true };
+
+    /// <summary>
+    /// Rules of the active profile compiled into a table indexed by device
+    /// state, so that a state change does not scan the rules. Values from
+    /// Any (-1) up to the largest enum value have a slot.
+    /// </summary>
+    static const size_t NET_COST_SLOTS = NetworkCost_Roaming + 2;
+    static const size_t POWER_SOURCE_SLOTS = PowerSource_LowBattery + 2;
+    static const int8_t NO_MATCHING_RULE = -1;
+
+    static int8_t ruleTable[NET_COST_SLOTS][POWER_SOURCE_SLOTS];
+    static bool   isRuleTableStale = true;
+
+    /// <summary>
+    /// Timers of the active rule as getTimers() returns them, packed so that
+    /// they are read with a single atomic load. Both timers at -1 mean that
+    /// there are no usable timers: rule timers are always multiples of 1000.
+    /// </summary>
+    static const int NO_TIMER = -1;
+    static std::atomic<uint64_t> currTimers { UINT64_MAX };
+
+    static uint64_t packTimers(int first, int second)
+    {
+        return (static_cast<uint64_t>(static_cast<uint32_t>(first)) << 32) | static_cast<uint32_t>(second);
+    }
+
+    static bool isRuleMatching(const TransmitProfileRule& rule, NetworkCost netCost, PowerSource powState)
+    {
+        return ((rule.netCost == netCost) || (NetworkCost::NetworkCost_Any == netCost) || (NetworkCost::NetworkCost_Any == rule.netCost)) &&
+               ((rule.powerState == powState) || (PowerSource::PowerSource_Any == powState) || (PowerSource::PowerSource_Any == rule.powerState));
+    }
+
+    static int findRule(const TransmitProfileRules& profile, NetworkCost netCost, PowerSource powState)
+    {
+        for (size_t i = 0; i < profile.rules.size(); i++)
+        {
+            if (isRuleMatching(profile.rules[i], netCost, powState))
+            {
+                return static_cast<int>(i);
+            }
+        }
+        return NO_MATCHING_RULE;
+    }
+
+    static void compileRuleTable(const TransmitProfileRules& profile)
+    {
+        for (size_t cost = 0; cost < NET_COST_SLOTS; cost++)
+        {
+            for (size_t power = 0; power < POWER_SOURCE_SLOTS; power++)
+            {
+                // Profiles have at most MAX_TRANSMIT_RULES rules
+                ruleTable[cost][power] = static_cast<int8_t>(findRule(profile,
+                    static_cast<NetworkCost>(static_cast<int>(cost) - 1),
+                    static_cast<PowerSource>(static_cast<int>(power) - 1)));
+            }
+        }
+        isRuleTableStale = false;
+    }
+
+    static int lookupRule(const TransmitProfileRules& profile, NetworkCost netCost, PowerSource powState)
+    {
+        size_t cost = static_cast<size_t>(static_cast<int>(netCost) + 1);
+        size_t power = static_cast<size_t>(static_cast<int>(powState) + 1);
+        if ((cost < NET_COST_SLOTS) && (power < POWER_SOURCE_SLOTS))
+        {
+            return ruleTable[cost][power];
+        }
+        return findRule(profile, netCost, powState);
+    }
 
     /// <summary>
     /// Get current transmit profile name
@@ -158,6 +227,7 @@ namespace MAT_NS_BEGIN {
         }
 #endif  
         currRule = 0;
+        isRuleTableStale = true;
         updateStates(currNetCost, currPowState);
     }
 
@@ -448,6 +518,7 @@ namespace MAT_NS_BEGIN {
             currProfileName = DEFAULT_PROFILE;
             LOG_WARN("selected profile %s instead", currProfileName.c_str());
         }
+        isRuleTableStale = true;
         updateStates(currNetCost, currPowState);
         return result;
     }
@@ -459,41 +530,17 @@ namespace MAT_NS_BEGIN {
     void TransmitProfiles::getTimers(TimerArray& out) {
         EnsureDefaultProfiles();
 
-        LOCK_PROFILES;
-        auto it = profiles.find(currProfileName);
+        // Cleared before reading, so that an update in between is not lost
+        isTimerUpdated = false;
+        uint64_t timers = currTimers.load();
+        out[0] = static_cast<int>(static_cast<uint32_t>(timers >> 32));
+        out[1] = static_cast<int>(static_cast<uint32_t>(timers));
         // When we can't get timers, we won't set isTimerUpdated to false,
         // so we will keep calling getTimers from TransmissionPolicyManager.
-        if (it == profiles.end()) {
-            out.fill(-1);
-            LOG_WARN("No active profile found, disabling all transmission timers.");
-            return;
+        if ((out[0] == NO_TIMER) && (out[1] == NO_TIMER)) {
+            isTimerUpdated = true;
+            LOG_WARN("No usable transmit profile rule, disabling all transmission timers.");
         }
-        if (currRule >= it->second.rules.size()) {
-            out.fill(-1);
-            LOG_ERROR(
-                "Profile %s current rule %iz >= profile length %iz",
-                currProfileName.c_str(),
-                currRule,
-                it->second.rules.size()
-            );
-            return;
-        }
-        auto const & rule = (it->second).rules[currRule];
-        if (rule.timers.empty()) {
-            out.fill(-1);
-            LOG_ERROR(
-                "Profile %s rule %iz has no timers",
-                currProfileName.c_str(),
-                currRule
-            );
-            return;
-        }
-        out[0] = 1000 * rule.timers[0];
-        out[1] = out[0];
-        if (rule.timers.size() > 2) {
-            out[1] = 1000 * rule.timers[2];
-        }
-        isTimerUpdated = false;
     }
 
     /// <summary>
@@ -501,7 +548,6 @@ namespace MAT_NS_BEGIN {
     /// </summary>
     bool TransmitProfiles::isTimerUpdateRequired()
     {
-        LOCK_PROFILES;
         return isTimerUpdated;
     }
 
@@ -509,19 +555,31 @@ namespace MAT_NS_BEGIN {
     /// This function is called only from updateStates
     /// </summary>
     void TransmitProfiles::onTimersUpdated() {
-        isTimerUpdated = true;
-#ifdef HAVE_MAT_LOGGING
+        uint64_t timers = packTimers(NO_TIMER, NO_TIMER);
         auto it = profiles.find(currProfileName);
-        if (it != profiles.end()) {
-            /* Debug routine to print the list of currently selected timers */
-            TransmitProfileRule &rule = (it->second).rules[currRule];
-            // Print just 3 timers for now because we support only 3
-            LOG_INFO("timers=[%3d,%3d,%3d]",
-                rule.timers[0],
-                rule.timers[1],
-                rule.timers[2]);
-        }
+        if ((it != profiles.end()) && (currRule < it->second.rules.size())) {
+            auto const& rule = (it->second).rules[currRule];
+            if (!rule.timers.empty()) {
+                int normal = 1000 * rule.timers[0];
+                int realTime = (rule.timers.size() > 2) ? 1000 * rule.timers[2] : normal;
+                timers = packTimers(normal, realTime);
+            }
+            else {
+                LOG_ERROR("Profile %s rule %iz has no timers", currProfileName.c_str(), currRule);
+            }
+#ifdef HAVE_MAT_LOGGING
+            if (rule.timers.size() > 2) {
+                /* Debug routine to print the list of currently selected timers */
+                // Print just 3 timers for now because we support only 3
+                LOG_INFO("timers=[%3d,%3d,%3d]",
+                    rule.timers[0],
+                    rule.timers[1],
+                    rule.timers[2]);
+            }
 #endif
+        }
+        currTimers = timers;
+        isTimerUpdated = true;
     }
 
     /// <summary>
@@ -538,20 +596,13 @@ namespace MAT_NS_BEGIN {
         auto it = profiles.find(currProfileName);
         if (it != profiles.end()) {
             auto &profile = it->second;
-            // Search for a matching rule. If not found, then return the first (the most restrictive) rule in the list.
-            currRule = 0;
-            for (size_t i = 0; i < profile.rules.size(); i++) {
-                const auto &rule = profile.rules[i];
-                if ((
-                    (rule.netCost == netCost) || (NetworkCost::NetworkCost_Any == netCost) || (NetworkCost::NetworkCost_Any == rule.netCost)) &&
-                    ((rule.powerState == powState) || (PowerSource::PowerSource_Any == powState) || (PowerSource::PowerSource_Any == rule.powerState))
-                    )
-                {
-                    currRule = i;
-                    result = true;
-                    break;
-                }
+            if (isRuleTableStale) {
+                compileRuleTable(profile);
             }
+            // Use the matching rule. If not found, then use the first (the most restrictive) rule in the list.
+            int rule = lookupRule(profile, netCost, powState);
+            result = (rule != NO_MATCHING_RULE);
+            currRule = result ? static_cast<size_t>(rule) : 0;
             onTimersUpdated();
         }
         return result;
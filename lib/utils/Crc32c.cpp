@@ -0,0 +1,170 @@
+//
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// SPDX-License-Identifier: Apache-2.0
+//
+#include "Crc32c.hpp"
+
+#include <cstring>
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define HAVE_CRC32C_SSE42
+#include <nmmintrin.h>
+#define CRC32C_TARGET __attribute__((target("sse4.2")))
+#elif defined(_M_X64)
+#define HAVE_CRC32C_SSE42
+#include <intrin.h>
+#include <nmmintrin.h>
+#define CRC32C_TARGET
+#elif defined(__aarch64__) && defined(__ARM_FEATURE_CRC32)
+#define HAVE_CRC32C_ARMV8
+#include <arm_acle.h>
+#endif
+
+namespace MAT_NS_BEGIN
+{
+    namespace {
+
+        // Reversed Castagnoli polynomial
+        constexpr uint32_t Polynomial = 0x82F63B78;
+
+        struct SlicingTables
+        {
+            uint32_t table[8][256];
+
+            SlicingTables()
+            {
+                for (uint32_t i = 0; i < 256; i++)
+                {
+                    uint32_t crc = i;
+                    for (int bit = 0; bit < 8; bit++)
+                    {
+                        crc = (crc >> 1) ^ ((crc & 1) ? Polynomial : 0);
+                    }
+                    table[0][i] = crc;
+                }
+                // table[k][i] is the CRC of byte i followed by k zero bytes
+                for (size_t k = 1; k < 8; k++)
+                {
+                    for (uint32_t i = 0; i < 256; i++)
+                    {
+                        table[k][i] = (table[k - 1][i] >> 8) ^ table[0][table[k - 1][i] & 0xFF];
+                    }
+                }
+            }
+        };
+
+        SlicingTables const& slicingTables()
+        {
+            static SlicingTables const tables;
+            return tables;
+        }
+
+        uint32_t computeSlicingBy8(uint32_t crc, uint8_t const* data, size_t size)
+        {
+            auto const& t = slicingTables().table;
+            while (size >= 8)
+            {
+                uint32_t low = crc ^ (static_cast<uint32_t>(data[0]) | (static_cast<uint32_t>(data[1]) << 8) |
+                                      (static_cast<uint32_t>(data[2]) << 16) | (static_cast<uint32_t>(data[3]) << 24));
+                crc = t[7][low & 0xFF] ^ t[6][(low >> 8) & 0xFF] ^ t[5][(low >> 16) & 0xFF] ^ t[4][low >> 24] ^
+                      t[3][data[4]] ^ t[2][data[5]] ^ t[1][data[6]] ^ t[0][data[7]];
+                data += 8;
+                size -= 8;
+            }
+            while (size--)
+            {
+                crc = t[0][(crc ^ *data++) & 0xFF] ^ (crc >> 8);
+            }
+            return crc;
+        }
+
+#if defined(HAVE_CRC32C_SSE42)
+        CRC32C_TARGET
+        uint32_t computeSse42(uint32_t crc, uint8_t const* data, size_t size)
+        {
+            uint64_t crc64 = crc;
+            while (size >= 8)
+            {
+                uint64_t word;
+                memcpy(&word, data, sizeof(word));
+                crc64 = _mm_crc32_u64(crc64, word);
+                data += 8;
+                size -= 8;
+            }
+            crc = static_cast<uint32_t>(crc64);
+            while (size--)
+            {
+                crc = _mm_crc32_u8(crc, *data++);
+            }
+            return crc;
+        }
+
+        bool cpuHasSse42()
+        {
+#if defined(_M_X64)
+            int info[4];
+            __cpuid(info, 1);
+            return (info[2] & (1 << 20)) != 0;
+#else
+            return __builtin_cpu_supports("sse4.2");
+#endif
+        }
+#elif defined(HAVE_CRC32C_ARMV8)
+        uint32_t computeArmV8(uint32_t crc, uint8_t const* data, size_t size)
+        {
+            while (size >= 8)
+            {
+                uint64_t word;
+                memcpy(&word, data, sizeof(word));
+                crc = __crc32cd(crc, word);
+                data += 8;
+                size -= 8;
+            }
+            while (size--)
+            {
+                crc = __crc32cb(crc, *data++);
+            }
+            return crc;
+        }
+#endif
+
+        using ComputeFunction = uint32_t (*)(uint32_t, uint8_t const*, size_t);
+
+        ComputeFunction selectImplementation()
+        {
+#if defined(HAVE_CRC32C_SSE42)
+            if (cpuHasSse42())
+            {
+                return computeSse42;
+            }
+#elif defined(HAVE_CRC32C_ARMV8)
+            // Only compiled in when the target architecture guarantees the instructions
+            return computeArmV8;
+#endif
+            return computeSlicingBy8;
+        }
+
+        ComputeFunction implementation()
+        {
+            static ComputeFunction const selected = selectImplementation();
+            return selected;
+        }
+
+    }
+
+    uint32_t Crc32c::Compute(uint8_t const* data, size_t size, uint32_t crc)
+    {
+        return ~implementation()(~crc, data, size);
+    }
+
+    uint32_t Crc32c::ComputeSoftware(uint8_t const* data, size_t size, uint32_t crc)
+    {
+        return ~computeSlicingBy8(~crc, data, size);
+    }
+
+    bool Crc32c::IsHardwareAccelerated()
+    {
+        return implementation() != computeSlicingBy8;
+    }
+
+} MAT_NS_END
@@ -0,0 +1,40 @@
+//
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// SPDX-License-Identifier: Apache-2.0
+//
+#ifndef LIB_CRC32C_HPP
+#define LIB_CRC32C_HPP
+
+#include "ctmacros.hpp"
+#include <cstddef>
+#include <cstdint>
+
+namespace MAT_NS_BEGIN
+{
+    /// <summary>
+    /// CRC-32C (Castagnoli). Uses the SSE4.2 or ARMv8 CRC instructions when the
+    /// CPU has them and a slicing-by-8 table lookup otherwise.
+    /// </summary>
+    class Crc32c
+    {
+        public:
+            /// <summary>
+            /// Computes the CRC of a buffer, or continues a CRC previously
+            /// returned for the data preceding it.
+            /// </summary>
+            static uint32_t Compute(uint8_t const* data, size_t size, uint32_t crc = 0);
+
+            /// <summary>
+            /// Table-driven implementation, regardless of the CPU.
+            /// </summary>
+            static uint32_t ComputeSoftware(uint8_t const* data, size_t size, uint32_t crc = 0);
+
+            /// <summary>
+            /// Whether Compute() uses CPU instructions.
+            /// </summary>
+            static bool IsHardwareAccelerated();
+    };
+
+} MAT_NS_END
+
+#endif
@@ -0,0 +1,166 @@
+//
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// SPDX-License-Identifier: Apache-2.0
+//
+#include "Sha256.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+namespace MAT_NS_BEGIN
+{
+    constexpr size_t Sha256::DigestSize;
+    constexpr size_t Sha256::BlockSize;
+
+    namespace {
+
+        uint32_t const RoundConstants[64] = {
+            0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+            0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+            0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+            0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+            0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+            0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+            0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+            0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2
+        };
+
+        inline uint32_t rotateRight(uint32_t value, unsigned bits)
+        {
+            return (value >> bits) | (value << (32 - bits));
+        }
+
+    }
+
+    Sha256::Sha256() :
+        m_state{ 0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a, 0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19 },
+        m_bufferSize(0),
+        m_totalSize(0)
+    {
+    }
+
+    void Sha256::Update(uint8_t const* data, size_t size)
+    {
+        m_totalSize += size;
+        if (m_bufferSize > 0)
+        {
+            size_t count = std::min(size, BlockSize - m_bufferSize);
+            memcpy(m_buffer + m_bufferSize, data, count);
+            m_bufferSize += count;
+            data += count;
+            size -= count;
+            if (m_bufferSize < BlockSize)
+            {
+                return;
+            }
+            processBlock(m_buffer);
+            m_bufferSize = 0;
+        }
+        while (size >= BlockSize)
+        {
+            processBlock(data);
+            data += BlockSize;
+            size -= BlockSize;
+        }
+        memcpy(m_buffer, data, size);
+        m_bufferSize = size;
+    }
+
+    std::vector<uint8_t> Sha256::Finish()
+    {
+        // Padding: 0x80, zeros up to 56 bytes into the last block, then the length in bits
+        uint64_t totalBits = m_totalSize * 8;
+        uint8_t padding[BlockSize + 8] = { 0x80 };
+        size_t paddingSize = ((m_bufferSize < 56) ? 56 : 56 + BlockSize) - m_bufferSize;
+        for (size_t i = 0; i < 8; i++)
+        {
+            padding[paddingSize + i] = static_cast<uint8_t>(totalBits >> (56 - 8 * i));
+        }
+        Update(padding, paddingSize + 8);
+
+        std::vector<uint8_t> digest(DigestSize);
+        for (size_t i = 0; i < 8; i++)
+        {
+            digest[4 * i]     = static_cast<uint8_t>(m_state[i] >> 24);
+            digest[4 * i + 1] = static_cast<uint8_t>(m_state[i] >> 16);
+            digest[4 * i + 2] = static_cast<uint8_t>(m_state[i] >> 8);
+            digest[4 * i + 3] = static_cast<uint8_t>(m_state[i]);
+        }
+        return digest;
+    }
+
+    std::vector<uint8_t> Sha256::Hash(uint8_t const* data, size_t size)
+    {
+        Sha256 sha;
+        sha.Update(data, size);
+        return sha.Finish();
+    }
+
+    std::vector<uint8_t> Sha256::Hmac(std::vector<uint8_t> const& key, uint8_t const* data, size_t size)
+    {
+        uint8_t innerPad[BlockSize];
+        uint8_t outerPad[BlockSize];
+        std::vector<uint8_t> blockKey = (key.size() > BlockSize) ? Hash(key.data(), key.size()) : key;
+        blockKey.resize(BlockSize, 0);
+        for (size_t i = 0; i < BlockSize; i++)
+        {
+            innerPad[i] = blockKey[i] ^ 0x36;
+            outerPad[i] = blockKey[i] ^ 0x5c;
+        }
+
+        Sha256 inner;
+        inner.Update(innerPad, BlockSize);
+        inner.Update(data, size);
+        std::vector<uint8_t> innerDigest = inner.Finish();
+
+        Sha256 outer;
+        outer.Update(outerPad, BlockSize);
+        outer.Update(innerDigest.data(), innerDigest.size());
+        return outer.Finish();
+    }
+
+    void Sha256::processBlock(uint8_t const* block)
+    {
+        uint32_t w[64];
+        for (size_t i = 0; i < 16; i++)
+        {
+            w[i] = (static_cast<uint32_t>(block[4 * i]) << 24) | (static_cast<uint32_t>(block[4 * i + 1]) << 16) |
+                   (static_cast<uint32_t>(block[4 * i + 2]) << 8) | static_cast<uint32_t>(block[4 * i + 3]);
+        }
+        for (size_t i = 16; i < 64; i++)
+        {
+            uint32_t s0 = rotateRight(w[i - 15], 7) ^ rotateRight(w[i - 15], 18) ^ (w[i - 15] >> 3);
+            uint32_t s1 = rotateRight(w[i - 2], 17) ^ rotateRight(w[i - 2], 19) ^ (w[i - 2] >> 10);
+            w[i] = w[i - 16] + s0 + w[i - 7] + s1;
+        }
+
+        uint32_t a = m_state[0], b = m_state[1], c = m_state[2], d = m_state[3];
+        uint32_t e = m_state[4], f = m_state[5], g = m_state[6], h = m_state[7];
+        for (size_t i = 0; i < 64; i++)
+        {
+            uint32_t s1 = rotateRight(e, 6) ^ rotateRight(e, 11) ^ rotateRight(e, 25);
+            uint32_t ch = (e & f) ^ (~e & g);
+            uint32_t temp1 = h + s1 + ch + RoundConstants[i] + w[i];
+            uint32_t s0 = rotateRight(a, 2) ^ rotateRight(a, 13) ^ rotateRight(a, 22);
+            uint32_t maj = (a & b) ^ (a & c) ^ (b & c);
+            uint32_t temp2 = s0 + maj;
+            h = g;
+            g = f;
+            f = e;
+            e = d + temp1;
+            d = c;
+            c = b;
+            b = a;
+            a = temp1 + temp2;
+        }
+        m_state[0] += a;
+        m_state[1] += b;
+        m_state[2] += c;
+        m_state[3] += d;
+        m_state[4] += e;
+        m_state[5] += f;
+        m_state[6] += g;
+        m_state[7] += h;
+    }
+
+} MAT_NS_END
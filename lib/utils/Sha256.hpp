@@ -0,0 +1,49 @@
+//
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// SPDX-License-Identifier: Apache-2.0
+//
+#ifndef LIB_SHA256_HPP
+#define LIB_SHA256_HPP
+
+#include "ctmacros.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace MAT_NS_BEGIN
+{
+    /// <summary>
+    /// SHA-256 (FIPS 180-4) and HMAC-SHA256 (RFC 2104).
+    /// </summary>
+    class Sha256
+    {
+        public:
+            static constexpr size_t DigestSize = 32;
+            static constexpr size_t BlockSize = 64;
+
+            Sha256();
+
+            void Update(uint8_t const* data, size_t size);
+
+            /// <summary>
+            /// Returns the digest of everything passed to Update(). The object
+            /// must not be updated afterwards.
+            /// </summary>
+            std::vector<uint8_t> Finish();
+
+            static std::vector<uint8_t> Hash(uint8_t const* data, size_t size);
+
+            static std::vector<uint8_t> Hmac(std::vector<uint8_t> const& key, uint8_t const* data, size_t size);
+
+        protected:
+            void processBlock(uint8_t const* block);
+
+            uint32_t m_state[8];
+            uint8_t  m_buffer[BlockSize];
+            size_t   m_bufferSize;
+            uint64_t m_totalSize;
+    };
+
+} MAT_NS_END
+
+#endif
@@ -81,6 +81,17 @@ namespace MAT_NS_BEGIN {
         return tenantToken.substr(0, tenantToken.find('-'));
     }
 
+    /// <summary>
+    /// Length of the tenant id at the start of a tenant token, for tracing the id
+    /// without a copy: LOG_TRACE("tenantId=%.*s", MATSDK_TENANT_ID_ARGS(token))
+    /// </summary>
+    inline int tenantTokenIdLength(std::string const& tenantToken)
+    {
+        return static_cast<int>((std::min)(tenantToken.find('-'), tenantToken.size()));
+    }
+
+#define MATSDK_TENANT_ID_ARGS(token_)   MAT::tenantTokenIdLength(token_), (token_).c_str()
+
     inline uint64_t GetUptimeMs()
     {
         return std::chrono::system_clock::now().time_since_epoch() / std::chrono::milliseconds(1);
@@ -62,4 +62,43 @@ namespace MAT_NS_BEGIN
 #endif
     }
 
+    bool ZlibUtils::DeflateVector(const std::vector<uint8_t>& in, std::vector<uint8_t>& out, bool isGzip, int level)
+    {
+#ifdef HAVE_MAT_ZLIB
+        z_stream zs;
+        memset(&zs, 0, sizeof(zs));
+
+        int windowBits = isGzip ? (MAX_WBITS | 16) : -MAX_WBITS;
+        int ret = deflateInit2(&zs, level, Z_DEFLATED, windowBits, 8 /*DEF_MEM_LEVEL*/, Z_DEFAULT_STRATEGY);
+        if (ret != Z_OK)
+        {
+            LOG_WARN("Deflate failed, error=%u/%u (%s)", 1, ret, zs.msg);
+            return false;
+        }
+
+        // deflateBound() is large enough to compress everything in a single call
+        out.resize(deflateBound(&zs, static_cast<uLong>(in.size())));
+        zs.next_in = in.data();
+        zs.avail_in = static_cast<uInt>(in.size());
+        zs.next_out = out.data();
+        zs.avail_out = static_cast<uInt>(out.size());
+        ret = deflate(&zs, Z_FINISH);
+        out.resize(zs.total_out);
+        deflateEnd(&zs);
+        if (ret != Z_STREAM_END)
+        {
+            LOG_WARN("Deflate failed, error=%u/%u (%s)", 2, ret, zs.msg);
+            out.clear();
+            return false;
+        }
+        return true;
+#else
+        UNREFERENCED_PARAMETER(in);
+        UNREFERENCED_PARAMETER(out);
+        UNREFERENCED_PARAMETER(isGzip);
+        UNREFERENCED_PARAMETER(level);
+        return false;
+#endif
+    }
+
 } MAT_NS_END
@@ -15,6 +15,12 @@ namespace MAT_NS_BEGIN
     {
         public:
             static bool InflateVector(const std::vector<uint8_t>& in, std::vector<uint8_t>& out, bool isGzip);
+
+            /// <summary>
+            /// Compresses a buffer into raw deflate (or gzip) format, replacing the contents of out.
+            /// </summary>
+            /// <param name="level">zlib compression level, from 1 (fastest) to 9 (smallest)</param>
+            static bool DeflateVector(const std::vector<uint8_t>& in, std::vector<uint8_t>& out, bool isGzip, int level);
     };
 
 } MAT_NS_END
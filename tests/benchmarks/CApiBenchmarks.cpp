@@ -0,0 +1,81 @@
+//
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// SPDX-License-Identifier: Apache-2.0
+//
+
+#include "common/Common.hpp"
+#include "CommonFields.h"
+#include "mat.h"
+
+#include <benchmark/benchmark.h>
+
+using namespace testing;
+using namespace MAT;
+
+namespace {
+
+    char const* const benchmarkToken = "7c8b1796cbc44bd5a03803c01c2b9d61-b6e370dd-28d9-4a52-9556-762543cf7aa7-6991";
+
+    /// <summary>
+    /// A C API client that only keeps events in storage
+    /// </summary>
+    class PausedCApiClient
+    {
+    public:
+        PausedCApiClient()
+        {
+            handle = evt_open(benchmarkToken);
+            evt_pause(handle);
+        }
+
+        ~PausedCApiClient()
+        {
+            evt_close(handle);
+        }
+
+        evt_handle_t handle;
+    };
+
+}
+
+static void CApi_Log(benchmark::State& state)
+{
+    PausedCApiClient client;
+    evt_prop event[] = TELEMETRY_EVENT
+    (
+        _STR(COMMONFIELDS_EVENT_NAME, "CApi.Benchmark"),
+        _STR(COMMONFIELDS_IKEY, benchmarkToken),
+        _STR("strKey", "value1"),
+        _INT("intKey", 12345),
+        _DBL("dblKey", 3.14),
+        _BOOL("boolKey", true)
+    );
+
+    for (auto _ : state)
+    {
+        evt_log(client.handle, event);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(CApi_Log);
+
+static void CApi_LogWithLogger(benchmark::State& state)
+{
+    PausedCApiClient client;
+    evt_handle_t logger = evt_get_logger(client.handle, benchmarkToken, nullptr);
+    evt_prop event[] = TELEMETRY_EVENT
+    (
+        _STR(COMMONFIELDS_EVENT_NAME, "CApi.Benchmark"),
+        _STR("strKey", "value1"),
+        _INT("intKey", 12345),
+        _DBL("dblKey", 3.14),
+        _BOOL("boolKey", true)
+    );
+
+    for (auto _ : state)
+    {
+        evt_log_with_logger(logger, event);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(CApi_LogWithLogger);
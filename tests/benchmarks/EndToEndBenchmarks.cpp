@@ -0,0 +1,166 @@
+//
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// SPDX-License-Identifier: Apache-2.0
+//
+#include "mat/config.h"
+#ifdef HAVE_MAT_DEFAULT_HTTP_CLIENT
+
+#include "common/Common.hpp"
+#include "common/HttpServer.hpp"
+#include "api/LogManagerFactory.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <atomic>
+#include <chrono>
+#include <ctime>
+
+using namespace testing;
+using namespace MAT;
+
+namespace {
+
+    class Collector : public HttpServer::Callback
+    {
+    public:
+        int onHttpRequest(HttpServer::Request const& /*request*/, HttpServer::Response& response) override
+        {
+            requests++;
+            response.headers["Content-Type"] = "text/plain";
+            response.content = "{ \"status\": \"0\" }";
+            return 200;
+        }
+
+        std::atomic<size_t> requests{ 0 };
+    };
+
+    /// <summary>
+    /// Counts the records handed to the HTTP client and the packages accepted by the collector
+    /// </summary>
+    class UploadTracker : public DebugEventListener
+    {
+    public:
+        void OnDebugEvent(DebugEvent& evt) override
+        {
+            switch (evt.type)
+            {
+            case EVT_SENDING:
+                records += evt.param1;
+                packages++;
+                break;
+            case EVT_HTTP_OK:
+                accepted++;
+                break;
+            default:
+                break;
+            }
+        }
+
+        bool done(size_t expectedRecords) const
+        {
+            return records >= expectedRecords && accepted >= packages;
+        }
+
+        std::atomic<size_t> records{ 0 };
+        std::atomic<size_t> packages{ 0 };
+        std::atomic<size_t> accepted{ 0 };
+    };
+
+    double percentile(std::vector<double> values, double fraction)
+    {
+        if (values.empty())
+        {
+            return 0;
+        }
+        size_t index = static_cast<size_t>(fraction * static_cast<double>(values.size() - 1));
+        std::nth_element(values.begin(), values.begin() + index, values.end());
+        return values[index];
+    }
+
+}
+
+/// <summary>
+/// Logs a burst of events into a LogManager uploading to a local collector and
+/// measures the time until all of them were accepted. CPU time is that of the
+/// whole process, the collector included.
+/// </summary>
+static void EndToEnd_LogAndUpload(benchmark::State& state)
+{
+    size_t const eventCount = static_cast<size_t>(state.range(0));
+
+    HttpServer server;
+    Collector collector;
+    int port = server.addListeningPort(0);
+    std::ostringstream os;
+    os << "localhost:" << port;
+    server.setServerName(os.str());
+    server.addHandler("/collector/", collector);
+    server.start();
+
+    std::vector<double> ingestUs;
+    ingestUs.reserve(eventCount * static_cast<size_t>(state.max_iterations));
+    double totalSeconds = 0;
+    double totalCpuSeconds = 0;
+
+    for (auto _ : state)
+    {
+        std::string cacheFile = GetUniqueDBFileName();
+        ILogConfiguration config;
+        config[CFG_STR_CACHE_FILE_PATH] = cacheFile;
+        config[CFG_STR_COLLECTOR_URL] = "http://" + os.str() + "/collector/";
+        config[CFG_INT_TRACE_LEVEL_MIN] = ACTTraceLevel_Error;
+        config[CFG_STR_FACTORY_NAME] = "EndToEnd";
+        config["version"] = "1.0.0";
+        config[CFG_MAP_FACTORY_CONFIG][CFG_STR_FACTORY_HOST] = "EndToEnd";
+
+        UploadTracker tracker;
+        std::unique_ptr<ILogManager> lm(LogManagerFactory::Create(config));
+        lm->AddEventListener(EVT_SENDING, tracker);
+        lm->AddEventListener(EVT_HTTP_OK, tracker);
+        ILogger* logger = lm->GetLogger("benchmark-tenant");
+        EventProperties props = CreateSampleEvent("benchmark_event", EventPriority_Normal);
+
+        std::clock_t cpuStart = std::clock();
+        auto start = std::chrono::steady_clock::now();
+        for (size_t i = 0; i < eventCount; i++)
+        {
+            auto logStart = std::chrono::steady_clock::now();
+            logger->LogEvent(props);
+            ingestUs.push_back(std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - logStart).count());
+        }
+
+        auto deadline = start + std::chrono::seconds(60);
+        while (!tracker.done(eventCount))
+        {
+            if (std::chrono::steady_clock::now() > deadline)
+            {
+                state.SkipWithError("Events were not uploaded within 60 seconds");
+                break;
+            }
+            lm->UploadNow();
+            PAL::sleep(10);
+        }
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        totalCpuSeconds += static_cast<double>(std::clock() - cpuStart) / CLOCKS_PER_SEC;
+        totalSeconds += seconds;
+        state.SetIterationTime(seconds);
+
+        lm->RemoveEventListener(EVT_SENDING, tracker);
+        lm->RemoveEventListener(EVT_HTTP_OK, tracker);
+        lm.reset();
+        ::remove(cacheFile.c_str());
+    }
+
+    server.stop();
+
+    double events = static_cast<double>(eventCount * state.iterations());
+    state.SetItemsProcessed(static_cast<int64_t>(events));
+    state.counters["events_per_sec"] = (totalSeconds > 0) ? events / totalSeconds : 0;
+    state.counters["cpu_us_per_event"] = totalCpuSeconds * 1e6 / events;
+    state.counters["ingest_p50_us"] = percentile(ingestUs, 0.50);
+    state.counters["ingest_p99_us"] = percentile(ingestUs, 0.99);
+    state.counters["requests"] = static_cast<double>(collector.requests);
+}
+BENCHMARK(EndToEnd_LogAndUpload)->Arg(10000)->Iterations(3)->UseManualTime()->Unit(benchmark::kMillisecond);
+
+#endif // HAVE_MAT_DEFAULT_HTTP_CLIENT
@@ -0,0 +1,31 @@
+//
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// SPDX-License-Identifier: Apache-2.0
+//
+
+#include "common/Common.hpp"
+#include "config/RuntimeConfig_Default.hpp"
+
+#include <benchmark/benchmark.h>
+
+int main(int argc, char** argv)
+{
+    benchmark::Initialize(&argc, argv);
+    if (benchmark::ReportUnrecognizedArguments(argc, argv))
+    {
+        return 1;
+    }
+
+    ILogConfiguration logConfig;
+    RuntimeConfig_Default runtimeConfig(logConfig);
+    PAL::initialize(runtimeConfig);
+
+    // Per-event trace messages would be all that is measured otherwise
+    PAL::detail::g_logLevel = PAL::LogLevel::Error;
+
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+
+    PAL::shutdown();
+    return 0;
+}
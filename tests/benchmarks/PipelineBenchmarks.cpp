@@ -0,0 +1,326 @@
+//
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// SPDX-License-Identifier: Apache-2.0
+//
+
+#include "common/Common.hpp"
+#include "api/LogManagerFactory.hpp"
+#include "bond/BondSerializer.hpp"
+#include "compression/HttpDeflateCompression.hpp"
+#include "config/RuntimeConfig_Default.hpp"
+#include "offline/OfflineStorage_SQLite.hpp"
+#include "pal/TaskDispatcher.hpp"
+#include "pal/WorkerThread.hpp"
+
+#include "NullObjects.hpp"
+
+#include <benchmark/benchmark.h>
+
+using namespace testing;
+using namespace MAT;
+
+namespace {
+
+    ::CsProtocol::Record makeRecord(int64_t seq)
+    {
+        ::CsProtocol::Record record;
+        record.name = "Benchmarks.Event";
+        record.iKey = "o:tenant";
+        record.time = 1234567890 + seq;
+        record.extProtocol.push_back(::CsProtocol::Protocol());
+        record.extProtocol[0].devMake = "Contoso";
+        record.extProtocol[0].devModel = "Model 1";
+        record.extUser.push_back(::CsProtocol::User());
+        record.extUser[0].localId = "c:user";
+        record.extUser[0].locale = "en-US";
+        record.extDevice.push_back(::CsProtocol::Device());
+        record.extDevice[0].localId = "c:device";
+        record.extDevice[0].deviceClass = "Desktop";
+        record.extOs.push_back(::CsProtocol::Os());
+        record.extOs[0].name = "Linux";
+        record.extOs[0].ver = "5.0";
+        record.extApp.push_back(::CsProtocol::App());
+        record.extApp[0].id = "app";
+        record.extApp[0].ver = "1.0.0";
+        record.extSdk.push_back(::CsProtocol::Sdk());
+        record.extSdk[0].seq = seq;
+        record.extSdk[0].libVer = "1.0";
+        record.data.push_back(::CsProtocol::Data());
+        record.data[0].properties["sequence"].stringValue = std::to_string(seq);
+        record.data[0].properties["message"].stringValue = "The quick brown fox jumps over the lazy dog";
+        return record;
+    }
+
+    std::vector<StorageRecord> makeStorageRecords(size_t count)
+    {
+        std::vector<StorageRecord> records;
+        records.reserve(count);
+        for (size_t i = 0; i < count; i++)
+        {
+            records.push_back(StorageRecord(PAL::generateRecordId(), "token", EventLatency_Normal, EventPersistence_Normal,
+                                            static_cast<int64_t>(1 + i), std::vector<uint8_t>(100, 1)));
+        }
+        return records;
+    }
+
+    class NullStorageObserver : public IOfflineStorageObserver
+    {
+    public:
+        void OnStorageOpened(std::string const&) override {}
+        void OnStorageFailed(std::string const&) override {}
+        void OnStorageOpenFailed(std::string const&) override {}
+        void OnStorageTrimmed(DroppedMap const&) override {}
+        void OnStorageRecordsDropped(std::map<std::string, size_t> const&) override {}
+        void OnStorageRecordsRejected(std::map<std::string, size_t> const&) override {}
+        void OnStorageRecordsSaved(size_t) override {}
+    };
+
+    /// <summary>
+    /// An in-memory SQLite storage big enough to never be trimmed while measured
+    /// </summary>
+    class SQLiteStorageFixture
+    {
+    public:
+        SQLiteStorageFixture() :
+            runtimeConfig(logConfig)
+        {
+            logConfig[CFG_INT_RAM_QUEUE_SIZE] = 256 * 1024 * 1024;
+            storage.reset(new OfflineStorage_SQLite(logManager, runtimeConfig, true));
+            storage->Initialize(observer);
+        }
+
+        ~SQLiteStorageFixture()
+        {
+            storage->Shutdown();
+        }
+
+        ILogConfiguration                      logConfig;
+        RuntimeConfig_Default                  runtimeConfig;
+        NullLogManager                         logManager;
+        NullStorageObserver                    observer;
+        std::unique_ptr<OfflineStorage_SQLite> storage;
+    };
+
+    /// <summary>
+    /// A log manager that keeps events in storage, it never uploads. The
+    /// log manager refers to the configuration, which must outlive it.
+    /// </summary>
+    std::unique_ptr<ILogManager> createPausedLogManager(ILogConfiguration& config, std::string const& cacheFile)
+    {
+        config[CFG_STR_CACHE_FILE_PATH] = cacheFile;
+        config[CFG_STR_COLLECTOR_URL] = "http://127.0.0.1:9/";
+        config[CFG_INT_TRACE_LEVEL_MIN] = ACTTraceLevel_Error;
+        config[CFG_STR_FACTORY_NAME] = "Benchmarks";
+        config["version"] = "1.0.0";
+        config[CFG_MAP_FACTORY_CONFIG][CFG_STR_FACTORY_HOST] = "Benchmarks";
+
+        std::unique_ptr<ILogManager> lm(LogManagerFactory::Create(config));
+        lm->PauseTransmission();
+        return lm;
+    }
+
+    class DispatchCounter
+    {
+    public:
+        void run()
+        {
+            if (++done == expected)
+            {
+                finished.post();
+            }
+        }
+
+        size_t      done = 0;
+        size_t      expected = 0;
+        PAL::Event  finished;
+    };
+
+}
+
+//---
+
+static void Logger_LogEvent(benchmark::State& state)
+{
+    std::string cacheFile = GetUniqueDBFileName();
+    ILogConfiguration config;
+    std::unique_ptr<ILogManager> lm = createPausedLogManager(config, cacheFile);
+    ILogger* logger = lm->GetLogger("benchmark-tenant");
+    EventProperties props = CreateSampleEvent("benchmark_event", EventPriority_Normal);
+
+    for (auto _ : state)
+    {
+        logger->LogEvent(props);
+    }
+    state.SetItemsProcessed(state.iterations());
+
+    lm.reset();
+    ::remove(cacheFile.c_str());
+}
+BENCHMARK(Logger_LogEvent);
+
+static void Logger_LogEvent_Traced(benchmark::State& state)
+{
+    std::string cacheFile = GetUniqueDBFileName();
+    ILogConfiguration config;
+    std::unique_ptr<ILogManager> lm = createPausedLogManager(config, cacheFile);
+    ILogger* logger = lm->GetLogger("benchmark-tenant");
+    EventProperties props = CreateSampleEvent("benchmark_event", EventPriority_Normal);
+
+    // Every pipeline stage traces each event at this level
+    MATSDK_SET_LOG_LEVEL_(PAL::Detail);
+    for (auto _ : state)
+    {
+        logger->LogEvent(props);
+    }
+    MATSDK_SET_LOG_LEVEL_(PAL::Error);
+    state.SetItemsProcessed(state.iterations());
+
+    lm.reset();
+    ::remove(cacheFile.c_str());
+}
+BENCHMARK(Logger_LogEvent_Traced);
+
+static void LogManager_GetLogger(benchmark::State& state)
+{
+    static std::string cacheFile;
+    static ILogConfiguration config;
+    static std::unique_ptr<ILogManager> lm;
+    if (state.thread_index() == 0)
+    {
+        cacheFile = GetUniqueDBFileName();
+        config = ILogConfiguration();
+        lm = createPausedLogManager(config, cacheFile);
+        for (int i = 0; i < 16; i++)
+        {
+            lm->GetLogger("benchmark-tenant-" + std::to_string(i), "Benchmarks.Source");
+        }
+    }
+
+    std::string const token = "Benchmark-Tenant-" + std::to_string(state.thread_index());
+    std::string const source = "Benchmarks.Source";
+    std::string const scope;
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(lm->GetLogger(token, source, scope));
+    }
+    state.SetItemsProcessed(state.iterations());
+
+    if (state.thread_index() == 0)
+    {
+        lm.reset();
+        ::remove(cacheFile.c_str());
+    }
+}
+BENCHMARK(LogManager_GetLogger)->ThreadRange(1, 4)->UseRealTime();
+
+static void BondSerializer_Serialize(benchmark::State& state)
+{
+    BondSerializer serializer;
+    ::CsProtocol::Record record = makeRecord(1);
+    size_t bytes = 0;
+
+    for (auto _ : state)
+    {
+        IncomingEventContext ctx(1, "tenant", EventLatency_Normal, EventPersistence_Normal, &record);
+        serializer.serialize(&ctx);
+        bytes += ctx.record.blob.size();
+        record.extSdk[0].seq++;
+    }
+    state.SetItemsProcessed(state.iterations());
+    state.SetBytesProcessed(static_cast<int64_t>(bytes));
+}
+BENCHMARK(BondSerializer_Serialize);
+
+static void OfflineStorage_SQLite_StoreRecords(benchmark::State& state)
+{
+    SQLiteStorageFixture fixture;
+    size_t const batchSize = static_cast<size_t>(state.range(0));
+    std::vector<StorageRecord> const records = makeStorageRecords(batchSize);
+
+    for (auto _ : state)
+    {
+        state.PauseTiming();
+        std::vector<StorageRecord> batch = records;
+        fixture.storage->DeleteAllRecords();
+        state.ResumeTiming();
+
+        fixture.storage->StoreRecords(batch);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(OfflineStorage_SQLite_StoreRecords)->Arg(500);
+
+static void OfflineStorage_SQLite_ReserveRelease(benchmark::State& state)
+{
+    SQLiteStorageFixture fixture;
+    size_t const recordCount = static_cast<size_t>(state.range(0));
+    std::vector<StorageRecord> records = makeStorageRecords(recordCount);
+    fixture.storage->StoreRecords(records);
+
+    HttpHeaders headers;
+    bool fromMemory = false;
+    std::vector<StorageRecordId> ids;
+    ids.reserve(recordCount);
+
+    for (auto _ : state)
+    {
+        ids.clear();
+        fixture.storage->GetAndReserveRecords([&ids](StorageRecord&& record) { ids.push_back(record.id); return true; },
+                                              60000, EventLatency_Normal, static_cast<unsigned>(recordCount));
+        fixture.storage->ReleaseRecords(ids, false, headers, fromMemory);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(OfflineStorage_SQLite_ReserveRelease)->Arg(500);
+
+static void HttpDeflateCompression_Compress(benchmark::State& state)
+{
+    ILogConfiguration logConfig;
+    RuntimeConfig_Default config(logConfig);
+    HttpDeflateCompression compression(config);
+
+    // A package of serialized records, as the packager hands them over
+    BondSerializer serializer;
+    std::vector<uint8_t> payload;
+    for (int64_t seq = 1; seq <= state.range(0); seq++)
+    {
+        ::CsProtocol::Record record = makeRecord(seq);
+        IncomingEventContext ctx(1, "tenant", EventLatency_Normal, EventPersistence_Normal, &record);
+        serializer.serialize(&ctx);
+        payload.insert(payload.end(), ctx.record.blob.begin(), ctx.record.blob.end());
+    }
+
+    EventsUploadContextPtr ctx = std::make_shared<EventsUploadContext>();
+    for (auto _ : state)
+    {
+        ctx->body = payload;
+        ctx->compressed = false;
+        compression.compress(ctx);
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * payload.size()));
+    state.counters["ratio"] = static_cast<double>(ctx->body.size()) / static_cast<double>(payload.size());
+}
+BENCHMARK(HttpDeflateCompression_Compress)->Arg(500);
+
+static void WorkerThread_Dispatch(benchmark::State& state)
+{
+    auto worker = PAL::WorkerThreadFactory::Create();
+    DispatchCounter counter;
+    size_t const batchSize = static_cast<size_t>(state.range(0));
+
+    for (auto _ : state)
+    {
+        counter.done = 0;
+        counter.expected = batchSize;
+        counter.finished.Reset();
+        for (size_t i = 0; i < batchSize; i++)
+        {
+            PAL::dispatchTask(worker.get(), &counter, &DispatchCounter::run);
+        }
+        counter.finished.wait();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+
+    worker->Join();
+}
+BENCHMARK(WorkerThread_Dispatch)->Arg(1000)->UseRealTime();
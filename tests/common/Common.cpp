@@ -5,6 +5,8 @@
 #include "Common.hpp"
 #include "zlib.h"
 #include "utils/Utils.hpp"
+
+#include <chrono>
 #ifdef _WIN32
 #include <windows.h>
 #include <stdio.h>
@@ -308,5 +310,76 @@ namespace testing {
 
     }
 
+    void MeasureStorageLifecycle(MAT::IOfflineStorage& storage, size_t count)
+    {
+        size_t const packageSize = 500;
+        std::vector<MAT::StorageRecord> records;
+        records.reserve(count);
+        for (size_t i = 0; i < count; i++)
+        {
+            records.push_back(MAT::StorageRecord(PAL::generateRecordId(), "token", MAT::EventLatency_Normal, MAT::EventPersistence_Normal,
+                                                 static_cast<int64_t>(1 + i), std::vector<uint8_t>(100, 1)));
+        }
+
+        std::vector<std::vector<MAT::StorageRecordId>> packages;
+        auto reserveAll = [&]() {
+            packages.clear();
+            for (;;)
+            {
+                std::vector<MAT::StorageRecordId> ids;
+                storage.GetAndReserveRecords([&ids](MAT::StorageRecord&& record) { ids.push_back(record.id); return true; },
+                                             60000, MAT::EventLatency_Normal, static_cast<unsigned>(packageSize));
+                if (ids.empty())
+                {
+                    break;
+                }
+                packages.push_back(std::move(ids));
+            }
+        };
+        auto reserved = [&]() {
+            size_t total = 0;
+            for (auto const& package : packages)
+            {
+                total += package.size();
+            }
+            return total;
+        };
+
+        // Per-record trace messages would be all that is measured otherwise
+        auto logLevel = PAL::detail::g_logLevel;
+        PAL::detail::g_logLevel = PAL::LogLevel::Error;
+        MAT::HttpHeaders headers;
+        bool fromMemory = false;
+
+        auto start = std::chrono::steady_clock::now();
+        EXPECT_EQ(storage.StoreRecords(records), count);
+        auto stored = std::chrono::steady_clock::now();
+        reserveAll();
+        auto reservedAt = std::chrono::steady_clock::now();
+        EXPECT_EQ(reserved(), count);
+        for (auto const& package : packages)
+        {
+            storage.ReleaseRecords(package, false, headers, fromMemory);
+        }
+        auto released = std::chrono::steady_clock::now();
+        reserveAll();
+        EXPECT_EQ(reserved(), count);
+        auto deleteStart = std::chrono::steady_clock::now();
+        for (auto const& package : packages)
+        {
+            storage.DeleteRecords(package, headers, fromMemory);
+        }
+        auto deleted = std::chrono::steady_clock::now();
+        PAL::detail::g_logLevel = logLevel;
+        EXPECT_EQ(storage.GetRecordCount(MAT::EventLatency_Unspecified), 0u);
+
+        auto nsPerRecord = [count](std::chrono::steady_clock::time_point from, std::chrono::steady_clock::time_point to) {
+            return static_cast<long long>(std::chrono::duration_cast<std::chrono::nanoseconds>(to - from).count() / count);
+        };
+        std::cerr << "[          ] store: " << nsPerRecord(start, stored) << " ns/record, reserve: " << nsPerRecord(stored, reservedAt)
+                  << " ns/record, release: " << nsPerRecord(reservedAt, released) << " ns/record, delete: " << nsPerRecord(deleteStart, deleted)
+                  << " ns/record (" << count << " records, packages of " << packageSize << ")" << std::endl;
+    }
+
 } // namespace testing
 
@@ -8,6 +8,7 @@
 #include <gmock/gmock.h>
 #include "pal/PAL.hpp"
 #include "EventProperty.hpp"
+#include "IOfflineStorage.hpp"
 #include <assert.h>
 #include <stdlib.h>
 #include <algorithm>
@@ -80,5 +81,12 @@ namespace testing {
     void LogCpuUsage(const char* label);
     void InflateVector(std::vector<uint8_t> &in, std::vector<uint8_t> &out, bool isGzip = false);
 
+    /// <summary>
+    /// Stores records into an offline storage, reserves them in upload sized
+    /// packages, releases, reserves again and deletes them, and prints the
+    /// time per record of each step.
+    /// </summary>
+    void MeasureStorageLifecycle(MAT::IOfflineStorage& storage, size_t count);
+
 } // namespace testing
 
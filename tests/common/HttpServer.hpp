@@ -9,6 +9,8 @@
 #include "SocketTools.hpp"
 #include "Reactor.hpp"
 
+#include <atomic>
+
 // #define ENABLE_HTTP_DEBUG
 
 #ifdef ENABLE_HTTP_DEBUG
@@ -73,6 +75,12 @@ class HttpServer : private Reactor::Callback
     std::list<std::pair<std::string, Callback*>> m_handlers;
     std::map<Socket, Connection> m_connections;
     size_t m_maxRequestHeadersSize, m_maxRequestContentSize;
+    std::atomic<size_t> m_acceptedConnections;
+
+    // Emulated link: all connections share the read bandwidth (0 = unlimited)
+    size_t m_readBandwidth { 0 };
+    uint64_t m_throttleStartMs { 0 };
+    uint64_t m_throttledBytes { 0 };
 
 	// Map of killed token to kill duration of that token
 	// Ideally we need a map of string --> std::pair<std::string /* suffix */, uint64_t /* duration */
@@ -100,7 +108,8 @@ class HttpServer : private Reactor::Callback
         allowKeepalive(true),
         m_reactor(*this),
         m_maxRequestHeadersSize(8192),
-        m_maxRequestContentSize(2 * 1024 * 1024)
+        m_maxRequestContentSize(2 * 1024 * 1024),
+        m_acceptedConnections(0)
     {
     }
 
@@ -117,6 +126,19 @@ class HttpServer : private Reactor::Callback
         m_maxRequestContentSize = maxRequestContentSize;
     }
 
+    // Limits how fast request data is read, in bytes per second, to emulate a slow uplink
+    void setReadBandwidth(size_t bytesPerSecond)
+    {
+        m_readBandwidth = bytesPerSecond;
+        m_throttleStartMs = 0;
+        m_throttledBytes = 0;
+    }
+
+    size_t getAcceptedConnections() const
+    {
+        return m_acceptedConnections;
+    }
+
     void setServerName(std::string const& name)
     {
         m_serverHost = name;
@@ -166,6 +188,9 @@ class HttpServer : private Reactor::Callback
         SocketAddr caddr;
         if (socket.accept(csocket, caddr)) {
             csocket.setNonBlocking();
+            // Headers and body are sent separately, don't let Nagle delay the body on keep-alive connections
+            csocket.setNoDelay();
+            m_acceptedConnections++;
             Connection& conn = m_connections[csocket];
             conn.socket = csocket;
             conn.state = Connection::Idle;
@@ -194,10 +219,28 @@ class HttpServer : private Reactor::Callback
             return;
         }
         conn.receiveBuffer.append(buffer, buffer + received);
+        if (m_readBandwidth > 0) {
+            throttleRead(static_cast<size_t>(received));
+        }
 
         handleConnection(conn);
     }
 
+    void throttleRead(size_t bytes)
+    {
+        // An idle link starts over instead of building up credit
+        uint64_t now = PAL::getMonotonicTimeMs();
+        if (now > m_throttleStartMs + m_throttledBytes * 1000 / m_readBandwidth) {
+            m_throttleStartMs = now;
+            m_throttledBytes = 0;
+        }
+        m_throttledBytes += bytes;
+        uint64_t due = m_throttleStartMs + m_throttledBytes * 1000 / m_readBandwidth;
+        if (due > now) {
+            PAL::sleep(static_cast<unsigned>(due - now));
+        }
+    }
+
     virtual void onSocketWritable(Socket socket) override
     {
         LOG_TRACE("HttpServer: writing socket fd=0x%x", socket.m_sock);
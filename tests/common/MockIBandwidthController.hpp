@@ -14,6 +14,7 @@ class MockIBandwidthController : public MAT::IBandwidthController
 {
   public:
     MOCK_METHOD0(GetProposedBandwidthBps, unsigned());
+    MOCK_METHOD3(OnUploadCompleted, void(unsigned, unsigned, bool));
 };
 
 
@@ -52,6 +52,7 @@ namespace testing {
         using MAT::ILogManagerInternal::GetLogger;
         MOCK_METHOD4(GetLogger, MAT::ILogger * (std::string const &, MAT::ContextFieldsProvider*, std::string const &, std::string const &));
         MOCK_METHOD1(sendEvent, void(MAT::IncomingEventContextPtr const &));
+        MOCK_METHOD1(sendEvents, void(std::vector<MAT::IncomingEventContextPtr> const &));
     };
 
 #if defined(__clang__)
@@ -52,6 +52,7 @@ namespace testing {
         MOCK_METHOD0(getContext, ISemanticContext&());
         MOCK_METHOD1(DispatchEvent, bool(DebugEvent evt));
         MOCK_METHOD1(sendEvent, void(IncomingEventContextPtr const& event));
+        MOCK_METHOD1(sendEvents, void(std::vector<IncomingEventContextPtr> const& events));
         MOCK_METHOD0(startAsync, void());
         MOCK_METHOD0(stopAsync, void());
         MOCK_METHOD0(handleFlushTaskDispatcher, void());
@@ -545,6 +545,79 @@ TEST(APITest, LogManager_Stress_SingleThreaded)
     EXPECT_GE(StressSingleThreaded(config), MAX_ITERATIONS);
 }
 
+TEST(APITest, LogManager_LogEvents_Throughput)
+{
+    auto& config = LogManager::GetLogConfiguration();
+    TestDebugEventListener debugListener;
+    addAllListeners(debugListener);
+
+    const size_t batchSize = 100;
+    std::vector<EventProperties> batch(batchSize, testing::CreateSampleEvent("event_name", EventPriority_Normal));
+
+    ILogger *logger = LogManager::Initialize(TEST_TOKEN, config);
+    auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < MAX_ITERATIONS; i++)
+    {
+        logger->LogEvent(batch[i % batchSize]);
+    }
+    auto singleUs = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+
+    start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < MAX_ITERATIONS; i += batchSize)
+    {
+        logger->LogEvents(batch);
+    }
+    auto batchUs = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+    LogManager::FlushAndTeardown();
+
+    std::cerr << "[          ] LogEvent  events/sec = " << (MAX_ITERATIONS * 1000000.0) / (std::max)(singleUs, decltype(singleUs)(1)) << std::endl;
+    std::cerr << "[          ] LogEvents events/sec = " << (MAX_ITERATIONS * 1000000.0) / (std::max)(batchUs, decltype(batchUs)(1)) << std::endl;
+    EXPECT_GE(debugListener.numLogged, 2 * MAX_ITERATIONS);
+    removeAllListeners(debugListener);
+}
+
+TEST(APITest, LogManager_AsyncStorageInit_TimeToFirstEvent)
+{
+    constexpr static unsigned numEvents = 100;
+    auto& config = LogManager::GetLogConfiguration();
+    ILogConfiguration previous = config;
+    config[CFG_STR_CACHE_FILE_PATH] = GetStoragePath();
+    config[CFG_INT_MAX_TEARDOWN_TIME] = 0;
+    config[CFG_MAP_METASTATS_CONFIG][CFG_INT_METASTATS_INTERVAL] = 0;
+
+    TestDebugEventListener debugListener;
+    addAllListeners(debugListener);
+    EventProperties event("async_storage_event");
+    for (bool async : { false, true })
+    {
+        CleanStorage();
+        debugListener.reset();
+        config[CFG_BOOL_ENABLE_ASYNC_STORAGE_INIT] = async;
+
+        auto start = std::chrono::steady_clock::now();
+        ILogger* logger = LogManager::Initialize(TEST_TOKEN, config);
+        logger->LogEvent(event);
+        auto firstEventUs = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+
+        LogManager::PauseTransmission();
+        for (unsigned i = 1; i < numEvents; i++)
+        {
+            logger->LogEvent(event);
+        }
+        EXPECT_NE(LogManager::GetLogSessionData(), nullptr);
+        LogManager::Flush();
+        LogManager::FlushAndTeardown();
+
+        std::cerr << "[          ] " << (async ? "async" : "sync ") << " storage init, time to first LogEvent us = " << firstEventUs << std::endl;
+        // Events logged while the disk storage was opening are saved to it
+        EXPECT_EQ(debugListener.numLogged, numEvents);
+        EXPECT_EQ(debugListener.numCached, numEvents);
+    }
+    removeAllListeners(debugListener);
+    config = previous;
+    CleanStorage();
+}
+
 constexpr static unsigned MAX_ITERATIONS_MT = 100;
 constexpr static unsigned MAX_THREADS = 25;
 /// <summary>
@@ -737,6 +810,74 @@ TEST(APITest, C_API_Test)
     ASSERT_EQ(capi_get_client(handle), nullptr);
 }
 
+TEST(APITest, C_API_LoggerHandle_Test)
+{
+    TestDebugEventListener debugListener;
+
+    const char* config = JSON_CONFIG(
+        {
+            "cacheFilePath": "MyOfflineStorage.db",
+            "config" : {
+                "host": "*"
+            },
+            "stats" : {
+                "interval": 0
+            },
+            "name" : "C-API-Client-1",
+            "version" : "1.0.0",
+            "primaryToken" : "7c8b1796cbc44bd5a03803c01c2b9d61-b6e370dd-28d9-4a52-9556-762543cf7aa7-6991",
+            "hostMode" : false,
+            "minimumTraceLevel" : 0,
+            "sdkmode" : 0
+        }
+    );
+
+    evt_prop event[] = TELEMETRY_EVENT
+    (
+        _STR(COMMONFIELDS_EVENT_NAME, EVENT_NAME_PURE_C),
+        _STR(COMMONFIELDS_IKEY, TEST_TOKEN),
+        _STR("strKey", "value1"),
+        _INT("intKey", 12345)
+    );
+
+    unsigned totalEvents = 0;
+    debugListener.OnLogX = [&](::CsProtocol::Record& record)
+    {
+        totalEvents++;
+        EXPECT_EQ(record.name, EVENT_NAME_PURE_C);
+        std::string iToken_o = "o:";
+        iToken_o += TEST_TOKEN;
+        EXPECT_THAT(iToken_o, testing::HasSubstr(record.iKey));
+        ASSERT_STREQ(record.data[0].properties["strKey"].stringValue.c_str(), "value1");
+        ASSERT_EQ(record.data[0].properties["intKey"].longValue, 12345);
+        EXPECT_EQ(record.data[0].properties.count(COMMONFIELDS_IKEY), 0u);
+    };
+
+    evt_handle_t handle = evt_open(config);
+    ASSERT_NE(handle, 0);
+    capi_client *client = capi_get_client(handle);
+    ASSERT_NE(client, nullptr);
+    client->logmanager->AddEventListener(EVT_LOG_EVENT, debugListener);
+
+    EXPECT_EQ(evt_get_logger(handle, nullptr, nullptr), 0);
+    evt_handle_t logger = evt_get_logger(handle, TEST_TOKEN, nullptr);
+    ASSERT_NE(logger, 0);
+    EXPECT_NE(evt_get_logger(handle, TEST_TOKEN, "source"), logger);
+
+    for (size_t i = 0; i < 5; i++)
+    {
+        EXPECT_EQ(evt_log_with_logger(logger, event), STATUS_SUCCESS);
+    }
+    EXPECT_EQ(totalEvents, 5u);
+
+    client->logmanager->RemoveEventListener(EVT_LOG_EVENT, debugListener);
+    evt_flushAndTeardown(handle);
+    evt_close(handle);
+
+    // Logger handles go away with their client
+    EXPECT_EQ(evt_log_with_logger(logger, event), ENOENT);
+}
+
 #ifdef HAVE_MAT_JSONHPP
 #if defined(_WIN32)
 TEST(APITest, UTC_Callback_Test)
@@ -1452,6 +1593,204 @@ TEST(APITest, Custom_Decorator)
     config.AddModule(CFG_MODULE_DECORATOR, nullptr);
 }
 
+/// <summary>
+/// Simulated slow network link: concurrent requests share the bandwidth
+/// equally and every request is answered with 200 once its body is sent.
+/// Records when each "critical_N" event reached the collector.
+/// </summary>
+class SlowNetworkHttpClient : public IHttpClient
+{
+    const size_t                    m_bytesPerSecond;
+    std::atomic<unsigned>           m_requestId { 0 };
+    std::atomic<size_t>             m_activeRequests { 0 };
+    std::mutex                      m_lock;
+    std::vector<std::thread>        m_requests;
+    std::map<size_t, std::chrono::steady_clock::time_point> m_delivered;
+
+  public:
+    SlowNetworkHttpClient(size_t bytesPerSecond) :
+        m_bytesPerSecond(bytesPerSecond)
+    {
+    }
+
+    virtual ~SlowNetworkHttpClient() noexcept
+    {
+        for (auto& request : m_requests)
+        {
+            request.join();
+        }
+    }
+
+    virtual IHttpRequest* CreateRequest() override
+    {
+        return new SimpleHttpRequest(std::to_string(m_requestId++));
+    }
+
+    virtual void SendRequestAsync(IHttpRequest* request, IHttpResponseCallback* callback) override
+    {
+        LOCKGUARD(m_lock);
+        m_requests.emplace_back([this, request, callback]()
+        {
+            auto const& body = request->GetBody();
+            m_activeRequests++;
+            for (size_t remaining = body.size(); remaining > 0;)
+            {
+                PAL::sleep(10);
+                size_t sent = (std::max)(size_t { 1 }, m_bytesPerSecond / 100 / m_activeRequests);
+                remaining -= (std::min)(remaining, sent);
+            }
+            m_activeRequests--;
+            onDelivered(body);
+            auto response = new SimpleHttpResponse(request->GetId());
+            response->m_result = HttpResult_OK;
+            response->m_statusCode = 200;
+            callback->OnHttpResponse(response);
+        });
+    }
+
+    virtual void CancelRequestAsync(std::string const&) override
+    {
+    }
+
+    size_t GetDeliveredCount()
+    {
+        LOCKGUARD(m_lock);
+        return m_delivered.size();
+    }
+
+    std::map<size_t, std::chrono::steady_clock::time_point> GetDelivered()
+    {
+        LOCKGUARD(m_lock);
+        return m_delivered;
+    }
+
+  protected:
+    void onDelivered(std::vector<uint8_t> const& body)
+    {
+        auto now = std::chrono::steady_clock::now();
+        const std::string marker = "critical_";
+        std::string text(body.begin(), body.end());
+        LOCKGUARD(m_lock);
+        for (size_t pos = text.find(marker); pos != std::string::npos; pos = text.find(marker, pos + 1))
+        {
+            size_t index = static_cast<size_t>(std::strtoul(text.c_str() + pos + marker.size(), nullptr, 10));
+            m_delivered.insert(std::make_pair(index, now));
+        }
+    }
+};
+
+TEST(APITest, LogManager_CriticalLatencyUnderNormalBacklog)
+{
+    constexpr size_t numBacklogEvents = 1500;
+    constexpr size_t numCriticalEvents = 20;
+    auto client = std::make_shared<SlowNetworkHttpClient>(256 * 1024);
+
+    auto& config = LogManager::GetLogConfiguration();
+    ILogConfiguration previous = config;
+    CleanStorage();
+    config.AddModule(CFG_MODULE_HTTP_CLIENT, client);
+    config[CFG_STR_CACHE_FILE_PATH] = GetStoragePath();
+    config[CFG_INT_MAX_TEARDOWN_TIME] = 0;
+    config[CFG_MAP_HTTP][CFG_BOOL_HTTP_COMPRESSION] = false;
+    config[CFG_MAP_TPM][CFG_INT_TPM_MAX_BLOB_BYTES] = 512 * 1024;
+
+    ILogger* logger = LogManager::Initialize(TEST_TOKEN, config);
+    LogManager::LoadTransmitProfiles(R"([{ "name": "Backlog", "rules": [ { "timers": [ 4, 2, 1 ] } ] }])");
+    LogManager::SetTransmitProfile("Backlog");
+
+    // About 1.5 MB of Normal events takes the simulated link several seconds to drain
+    EventProperties backlog("backlog_event");
+    backlog.SetProperty("payload", std::string(1000, 'x'));
+    for (size_t i = 0; i < numBacklogEvents; i++)
+    {
+        logger->LogEvent(backlog);
+    }
+
+    LogManager::UploadNow();
+
+    std::vector<std::chrono::steady_clock::time_point> logged;
+    PAL::sleep(500);
+    for (size_t i = 0; i < numCriticalEvents; i++)
+    {
+        EventProperties critical("critical_" + std::to_string(i));
+        critical.SetLatency(EventLatency_RealTime);
+        logged.push_back(std::chrono::steady_clock::now());
+        logger->LogEvent(critical);
+        PAL::sleep(200);
+    }
+
+    for (size_t waitMs = 0; (client->GetDeliveredCount() < numCriticalEvents) && (waitMs < 30000); waitMs += 100)
+    {
+        PAL::sleep(100);
+    }
+    LogManager::SetTransmitProfile(TransmitProfile_NearRealTime);
+    LogManager::FlushAndTeardown();
+    config = previous;
+    config.AddModule(CFG_MODULE_HTTP_CLIENT, nullptr);
+
+    auto delivered = client->GetDelivered();
+    ASSERT_EQ(delivered.size(), numCriticalEvents);
+    std::vector<int64_t> latencies;
+    for (auto const& item : delivered)
+    {
+        latencies.push_back(std::chrono::duration_cast<std::chrono::milliseconds>(item.second - logged[item.first]).count());
+    }
+    std::sort(latencies.begin(), latencies.end());
+    std::cerr << "[          ] critical p50 latency ms = " << latencies[latencies.size() / 2] << std::endl;
+    std::cerr << "[          ] critical p99 latency ms = " << latencies[(latencies.size() * 99 - 1) / 100] << std::endl;
+}
+
+TEST(APITest, LogManager_Teardown_10kQueuedEvents)
+{
+    constexpr unsigned numEvents = 10000;
+    auto& config = LogManager::GetLogConfiguration();
+    ILogConfiguration previous = config;
+    TestDebugEventListener debugListener;
+    addAllListeners(debugListener);
+
+    EventProperties event("teardown_event");
+    event.SetProperty("payload", std::string(100, 'x'));
+    for (bool persistOnly : { false, true })
+    {
+        auto client = std::make_shared<SlowNetworkHttpClient>(64 * 1024 * 1024);
+        CleanStorage();
+        debugListener.reset();
+        config.AddModule(CFG_MODULE_HTTP_CLIENT, client);
+        config[CFG_STR_CACHE_FILE_PATH] = GetStoragePath();
+        config[CFG_INT_MAX_TEARDOWN_TIME] = 5;
+        config[CFG_INT_RAM_QUEUE_SIZE] = 8 * 1024 * 1024;
+        config[CFG_MAP_METASTATS_CONFIG][CFG_INT_METASTATS_INTERVAL] = 0;
+        config[CFG_BOOL_PERSIST_ON_TEARDOWN] = persistOnly;
+
+        ILogger* logger = LogManager::Initialize(TEST_TOKEN, config);
+        // Nothing is uploaded before the teardown
+        LogManager::LoadTransmitProfiles(R"([{ "name": "Idle", "rules": [ { "timers": [ 600, 600, 600 ] } ] }])");
+        LogManager::SetTransmitProfile("Idle");
+        for (unsigned i = 0; i < numEvents; i++)
+        {
+            logger->LogEvent(event);
+        }
+
+        auto start = std::chrono::steady_clock::now();
+        LogManager::FlushAndTeardown();
+        auto teardownMs = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count();
+        config.AddModule(CFG_MODULE_HTTP_CLIENT, nullptr);
+
+        std::cerr << "[          ] " << (persistOnly ? "persist" : "upload ") << " teardown ms = " << teardownMs
+                  << ", sent = " << debugListener.numSent << ", cached = " << debugListener.numCached << std::endl;
+        // Every event is either uploaded or saved, without waiting for the whole teardown time
+        EXPECT_GE(debugListener.numSent + debugListener.numCached, numEvents);
+        EXPECT_LT(teardownMs, 4000);
+        if (persistOnly)
+        {
+            EXPECT_EQ(debugListener.numSent, 0u);
+        }
+    }
+    removeAllListeners(debugListener);
+    config = previous;
+    CleanStorage();
+}
+
 #endif // HAVE_MAT_DEFAULT_HTTP_CLIENT
 
 // TEST_PULL_ME_IN(APITest)
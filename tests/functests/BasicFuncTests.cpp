@@ -788,8 +788,8 @@ TEST_F(BasicFuncTests, restartRecoversEventsFromStorage)
         LogManager::UploadNow();
 
         // 1st request for realtime event
-        waitForEvents(3, 5); // start, first_event, second_event, ongoing, stop, start, fooEvent
-        // we drop two of the events during pause, though.
+        waitForEvents(3, 7); // start, first_event, second_event, ongoing, stop, start, fooEvent
+        // events logged during pause are saved on teardown and sent after the restart
         EXPECT_GE(receivedRequests.size(), (size_t)1);
         if (receivedRequests.size() != 0)
         {
@@ -810,6 +810,66 @@ TEST_F(BasicFuncTests, restartRecoversEventsFromStorage)
         */
 }
 
+TEST_F(BasicFuncTests, uploadsArePacedToBandwidthShare)
+{
+    static size_t const LINK_BANDWIDTH = 200 * 1024;
+    static size_t const MAX_BLOB_SIZE = 128 * 1024;
+    static size_t const EVENT_COUNT = 600;
+
+    CleanStorage();
+    auto& configuration = LogManager::GetLogConfiguration();
+    ILogConfiguration previous = configuration;
+    configuration[CFG_MAP_TPM][CFG_INT_TPM_MAX_BLOB_BYTES] = MAX_BLOB_SIZE;
+    configuration[CFG_MAP_TPM][CFG_INT_TPM_BANDWIDTH_SHARE] = 50;
+    server.setReadBandwidth(LINK_BANDWIDTH);
+
+    Initialize();
+    LogManager::PauseTransmission();
+    for (size_t i = 0; i < EVENT_COUNT; i++)
+    {
+        EventProperties event("paced_event");
+        event.SetProperty("big_data", std::string(1024, 'x'));
+        logger->LogEvent(event);
+    }
+    LogManager::ResumeTransmission();
+
+    // Note when each request completes
+    std::vector<std::pair<uint64_t, size_t>> arrivals;
+    size_t totalBytes = 0;
+    auto start = PAL::getMonotonicTimeMs();
+    while ((totalBytes < EVENT_COUNT * 1024) && (PAL::getMonotonicTimeMs() - start < 30000))
+    {
+        {
+            LOCKGUARD(mtx_requests);
+            while (arrivals.size() < receivedRequests.size())
+            {
+                size_t size = receivedRequests[arrivals.size()].content.size();
+                arrivals.push_back(std::make_pair(PAL::getMonotonicTimeMs(), size));
+                totalBytes += size;
+            }
+        }
+        PAL::sleep(5);
+    }
+    FlushAndTeardown();
+    server.setReadBandwidth(0);
+    configuration = previous;
+
+    // Uploads before the first full one measure the link, the following
+    // ones are smaller and get half of it
+    ASSERT_GE(arrivals.size(), 4u);
+    EXPECT_GE(totalBytes, EVENT_COUNT * 1024);
+    size_t pacedBytes = 0;
+    for (size_t i = 2; i < arrivals.size(); i++)
+    {
+        pacedBytes += arrivals[i].second;
+        EXPECT_LT(arrivals[i].second, MAX_BLOB_SIZE);
+    }
+    uint64_t elapsedMs = std::max<uint64_t>(arrivals.back().first - arrivals[1].first, 1);
+    size_t rate = static_cast<size_t>(pacedBytes * 1000 / elapsedMs);
+    std::cerr << "[          ] " << arrivals.size() << " uploads, paced at " << rate << " B/s over a " << LINK_BANDWIDTH << " B/s link" << std::endl;
+    EXPECT_LE(rate, LINK_BANDWIDTH * 3 / 4);
+}
+
 #if 0 // FIXME: 1445871 [v3][1DS] Offline storage size may exceed configured limit
 TEST_F(BasicFuncTests, storageFileSizeDoesntExceedConfiguredSize)
 {
@@ -20,6 +20,9 @@
 
 #include "sqlite3.h"
 
+#include <ctime>
+#include <fstream>
+
 #include "NullObjects.hpp"
 
 #if defined __has_include && defined(HAVE_MAT_PRIVACYGUARD)
@@ -229,6 +232,101 @@ TEST_F(MultipleLogManagersTests, MultiProcessesLogManager)
     CAPTURE_PERF_STATS("Log Manager deleted");
 }
 
+namespace
+{
+    struct ProcessStats
+    {
+        size_t threads = 0;   // 0 where /proc is not available
+        size_t rssKb = 0;
+        double cpuMs = 0;
+    };
+
+    ProcessStats GetProcessStats()
+    {
+        ProcessStats stats;
+        stats.cpuMs = 1000.0 * std::clock() / CLOCKS_PER_SEC;
+#ifdef __linux__
+        std::ifstream status("/proc/self/status");
+        std::string line;
+        while (std::getline(status, line))
+        {
+            if (line.compare(0, 8, "Threads:") == 0)
+            {
+                stats.threads = std::stoul(line.substr(8));
+            }
+            else if (line.compare(0, 6, "VmRSS:") == 0)
+            {
+                stats.rssKb = std::stoul(line.substr(6));
+            }
+        }
+#endif
+        return stats;
+    }
+}
+
+// Hosts N tenants, each with its own LogManager sending a few events, once with
+// the default runtime per instance and once with the shared runtime.
+TEST_F(MultipleLogManagersTests, SharedRuntimeScalesWithManagersPerfTest)
+{
+    size_t const managers = 12;
+    size_t const eventsPerManager = 100;
+    size_t const workerThreads = 2;
+    size_t idleThreads[2] = {};
+
+    for (int shared = 0; shared < 2; shared++)
+    {
+        ProcessStats before = GetProcessStats();
+        std::vector<ILogConfiguration> configs(managers);
+        std::vector<std::unique_ptr<ILogManager>> lms;
+        size_t requestsBefore = callback1.GetRequestCount();
+
+        for (size_t i = 0; i < managers; i++)
+        {
+            ILogConfiguration& config = configs[i];
+            config[CFG_STR_CACHE_FILE_PATH] = ":memory:";
+            config[CFG_STR_COLLECTOR_URL] = serverAddress + "/1/";
+            config[CFG_STR_FACTORY_NAME] = "Tenant" + std::to_string(i);
+            config["version"] = "1.0.0";
+            config[CFG_MAP_FACTORY_CONFIG][CFG_STR_FACTORY_HOST] = "Tenant" + std::to_string(i);
+            config[CFG_MAP_FACTORY_CONFIG][CFG_BOOL_FACTORY_SHARED_RUNTIME] = (shared != 0);
+            config[CFG_MAP_FACTORY_CONFIG][CFG_INT_FACTORY_WORKER_THREADS] = static_cast<int64_t>(workerThreads);
+            lms.emplace_back(LogManagerFactory::Create(config));
+
+            ILogger* logger = lms.back()->GetLogger("tenant_token");
+            for (size_t j = 0; j < eventsPerManager; j++)
+            {
+                logger->LogEvent(CreateSampleEvent("tenant_event", EventPriority_Normal));
+            }
+        }
+        for (auto& lm : lms)
+        {
+            lm->GetLogController()->UploadNow();
+        }
+        // Uploads may be done already, so count from before they started
+        auto start = PAL::getUtcSystemTimeMs();
+        while ((callback1.GetRequestCount() - requestsBefore < managers) && (PAL::getUtcSystemTimeMs() - start < 20000))
+        {
+            PAL::sleep(100);
+        }
+        ASSERT_GE(callback1.GetRequestCount() - requestsBefore, managers);
+
+        // What stays around while the tenants are idle
+        PAL::sleep(500);
+        ProcessStats idle = GetProcessStats();
+        lms.clear();
+        ProcessStats after = GetProcessStats();
+
+        idleThreads[shared] = idle.threads - before.threads;
+        std::cerr << "[          ] " << (shared ? "shared runtime" : "own runtime") << ", " << managers << " managers: "
+                  << idleThreads[shared] << " threads, "
+                  << static_cast<long long>(idle.rssKb) - static_cast<long long>(before.rssKb) << " KB RSS, "
+                  << static_cast<long long>(after.cpuMs - before.cpuMs) << " ms CPU" << std::endl;
+    }
+
+    // However many tenants there are, the shared runtime only adds its pool
+    EXPECT_LE(idleThreads[1], workerThreads);
+}
+
 #ifdef HAVE_MAT_PRIVACYGUARD
 class MockLogger : public NullLogger
 {
@@ -106,7 +106,7 @@ TEST(AIJsonSerializerTests, correctJsonStructure)
     std::unique_ptr<::CsProtocol::Record> record1 = createTestRecord(
         "event1", 1, app, device, proto, os, user, data
     );
-    IncomingEventContext context1(PAL::generateUuidString(), TEST_TOKEN, EventLatency_Unspecified, EventPersistence_Normal, record1.get());
+    IncomingEventContext context1(PAL::generateRecordId(), TEST_TOKEN, EventLatency_Unspecified, EventPersistence_Normal, record1.get());
 
     aiSerializer->serialize(&context1);
     ::nlohmann::json result1 = nlohmann::json::parse(context1.record.blob.begin(), context1.record.blob.end());
@@ -137,7 +137,7 @@ TEST(AIJsonSerializerTests, correctJsonStructure)
     std::unique_ptr<::CsProtocol::Record> record2 = createTestRecord(
         "event2", 2, app, device, proto, os, user, data2
     );
-    IncomingEventContext context2(PAL::generateUuidString(), TEST_TOKEN, EventLatency_Unspecified, EventPersistence_Normal, record2.get());
+    IncomingEventContext context2(PAL::generateRecordId(), TEST_TOKEN, EventLatency_Unspecified, EventPersistence_Normal, record2.get());
 
     aiSerializer->serialize(&context2);
     ::nlohmann::json result2 = nlohmann::json::parse(context2.record.blob.begin(), context2.record.blob.end());
@@ -155,7 +155,7 @@ TEST(AIJsonSerializerTests, valuesSanitized)
 {
     std::unique_ptr<::CsProtocol::Record> record = createInvalidTestRecord();
 
-    IncomingEventContext context(PAL::generateUuidString(), TEST_TOKEN, EventLatency_Unspecified, EventPersistence_Normal, record.get());
+    IncomingEventContext context(PAL::generateRecordId(), TEST_TOKEN, EventLatency_Unspecified, EventPersistence_Normal, record.get());
     std::unique_ptr<AIJsonSerializer> aiSerializer = std::make_unique<AIJsonSerializer>();
 
     aiSerializer->serialize(&context);
@@ -0,0 +1,100 @@
+//
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// SPDX-License-Identifier: Apache-2.0
+//
+#include "common/Common.hpp"
+#include "bwcontrol/BandwidthController_Default.hpp"
+
+#include <limits>
+
+using namespace testing;
+using namespace MAT;
+
+class TestBandwidthController : public BandwidthController_Default
+{
+  public:
+    uint64_t nowMs = 100000;
+
+    TestBandwidthController(unsigned sharePercent) :
+        BandwidthController_Default(sharePercent)
+    {
+    }
+
+    uint64_t getMonotonicTimeMs() const override
+    {
+        return nowMs;
+    }
+};
+
+class BandwidthControllerTests : public Test
+{
+  protected:
+    TestBandwidthController bwc { 50 };
+};
+
+TEST_F(BandwidthControllerTests, NoEstimateDoesNotLimitUploads)
+{
+    EXPECT_THAT(bwc.GetEstimatedBandwidthBps(), 0u);
+    EXPECT_THAT(bwc.GetProposedBandwidthBps(), std::numeric_limits<unsigned>::max());
+}
+
+TEST_F(BandwidthControllerTests, ProposesShareOfEstimatedBandwidth)
+{
+    bwc.OnUploadCompleted(200000, 1000, false);
+    EXPECT_THAT(bwc.GetEstimatedBandwidthBps(), 200000u);
+    EXPECT_THAT(bwc.GetProposedBandwidthBps(), 100000u);
+
+    // The bottleneck bandwidth is the largest sample in the window
+    bwc.nowMs += 1000;
+    bwc.OnUploadCompleted(100000, 1000, false);
+    EXPECT_THAT(bwc.GetEstimatedBandwidthBps(), 200000u);
+}
+
+TEST_F(BandwidthControllerTests, AppLimitedUploadsAloneMakeNoEstimate)
+{
+    bwc.OnUploadCompleted(1000, 100, true);
+    EXPECT_THAT(bwc.GetEstimatedBandwidthBps(), 0u);
+    EXPECT_THAT(bwc.GetProposedBandwidthBps(), std::numeric_limits<unsigned>::max());
+
+    // Once the link is known to be the bottleneck, they are samples as any other
+    bwc.nowMs += 100;
+    bwc.OnUploadCompleted(5000, 1000, false);
+    bwc.nowMs += 100;
+    bwc.OnUploadCompleted(20000, 100, true);
+    EXPECT_THAT(bwc.GetEstimatedBandwidthBps(), 200000u);
+}
+
+TEST_F(BandwidthControllerTests, ParallelUploadsShareTheLink)
+{
+    // Two uploads of 100 KB each finishing within the same second measure 200 KB/s
+    bwc.OnUploadCompleted(100000, 1000, false);
+    bwc.nowMs += 10;
+    bwc.OnUploadCompleted(100000, 1000, false);
+    EXPECT_THAT(bwc.GetEstimatedBandwidthBps(), 200000u);
+}
+
+TEST_F(BandwidthControllerTests, OldSamplesExpire)
+{
+    bwc.OnUploadCompleted(400000, 1000, false);
+    bwc.nowMs += BandwidthController_Default::DefaultWindowMs / 2;
+    bwc.OnUploadCompleted(100000, 1000, false);
+    EXPECT_THAT(bwc.GetEstimatedBandwidthBps(), 400000u);
+
+    // Bandwidth drops are picked up when the larger sample leaves the window
+    bwc.nowMs += BandwidthController_Default::DefaultWindowMs / 2 + 1;
+    EXPECT_THAT(bwc.GetEstimatedBandwidthBps(), 100000u);
+
+    bwc.nowMs += BandwidthController_Default::DefaultWindowMs;
+    EXPECT_THAT(bwc.GetProposedBandwidthBps(), std::numeric_limits<unsigned>::max());
+}
+
+TEST_F(BandwidthControllerTests, ShareIsClamped)
+{
+    TestBandwidthController full(250);
+    full.OnUploadCompleted(1000, 1000, false);
+    EXPECT_THAT(full.GetProposedBandwidthBps(), 1000u);
+
+    TestBandwidthController none(0);
+    none.OnUploadCompleted(1000, 1000, false);
+    EXPECT_THAT(none.GetProposedBandwidthBps(), 10u);
+}
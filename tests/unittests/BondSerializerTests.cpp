@@ -0,0 +1,156 @@
+//
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// SPDX-License-Identifier: Apache-2.0
+//
+
+#include "common/Common.hpp"
+#include "bond/BondSerializer.hpp"
+#include "bond/All.hpp"
+#include "bond/generated/CsProtocol_writers.hpp"
+#include "bond/generated/CsProtocol_readers.hpp"
+#include "PayloadDecoder.hpp"
+
+#include <chrono>
+
+using namespace testing;
+using namespace MAT;
+
+class ShadowBondSerializer : public BondSerializer
+{
+  public:
+    using BondSerializer::handleSerialize;
+    using BondSerializer::m_partACache;
+};
+
+class BondSerializerTests : public Test
+{
+  protected:
+    ShadowBondSerializer serializer;
+
+    static ::CsProtocol::Record makeRecord(int64_t seq)
+    {
+        ::CsProtocol::Record record;
+        record.name = "BondSerializerTests.Event";
+        record.iKey = "o:tenant";
+        record.time = 1234567890 + seq;
+        record.extProtocol.push_back(::CsProtocol::Protocol());
+        record.extProtocol[0].devMake = "Contoso";
+        record.extProtocol[0].devModel = "Model 1";
+        record.extUser.push_back(::CsProtocol::User());
+        record.extUser[0].localId = "c:user";
+        record.extUser[0].locale = "en-US";
+        record.extDevice.push_back(::CsProtocol::Device());
+        record.extDevice[0].localId = "c:device";
+        record.extDevice[0].deviceClass = "Desktop";
+        record.extOs.push_back(::CsProtocol::Os());
+        record.extOs[0].name = "Linux";
+        record.extOs[0].ver = "5.0";
+        record.extApp.push_back(::CsProtocol::App());
+        record.extApp[0].id = "app";
+        record.extApp[0].ver = "1.0.0";
+        record.extNet.push_back(::CsProtocol::Net());
+        record.extNet[0].type = "Wired";
+        record.extNet[0].cost = "Unmetered";
+        record.extSdk.push_back(::CsProtocol::Sdk());
+        record.extSdk[0].seq = seq;
+        record.extSdk[0].libVer = "1.0";
+        record.data.push_back(::CsProtocol::Data());
+        record.data[0].properties["prop"].stringValue = "value";
+        return record;
+    }
+
+    static std::vector<uint8_t> referenceEncoding(::CsProtocol::Record const& record)
+    {
+        std::vector<uint8_t> blob;
+        bond_lite::CompactBinaryProtocolWriter writer(blob);
+        bond_lite::Serialize(writer, record);
+        return blob;
+    }
+
+    std::vector<uint8_t> cachedEncoding(::CsProtocol::Record& record)
+    {
+        IncomingEventContext ctx(1, "tenant", EventLatency_Normal, EventPersistence_Normal, &record);
+        EXPECT_TRUE(serializer.handleSerialize(&ctx));
+        return ctx.record.blob;
+    }
+};
+
+TEST_F(BondSerializerTests, RepeatedPartA_IsSplicedFromCache)
+{
+    for (int64_t seq = 1; seq <= 3; seq++)
+    {
+        auto record = makeRecord(seq);
+        EXPECT_THAT(cachedEncoding(record), Eq(referenceEncoding(record)));
+    }
+    // Six cached extension structs, encoded once and reused twice
+    EXPECT_EQ(serializer.m_partACache.misses, size_t { 6 });
+    EXPECT_EQ(serializer.m_partACache.hits, size_t { 12 });
+}
+
+TEST_F(BondSerializerTests, ChangedPartA_IsEncodedAgain)
+{
+    auto record = makeRecord(1);
+    cachedEncoding(record);
+
+    record.extApp[0].expId = "exp:1";
+    record.extUser[0].localId.clear();
+    record.extDevice.clear();
+    EXPECT_THAT(cachedEncoding(record), Eq(referenceEncoding(record)));
+
+    record = makeRecord(2);
+    EXPECT_THAT(cachedEncoding(record), Eq(referenceEncoding(record)));
+}
+
+TEST_F(BondSerializerTests, CachedEncoding_RoundTripsThroughPayloadDecoder)
+{
+    auto record = makeRecord(1);
+    cachedEncoding(record);
+    record = makeRecord(2);
+    auto blob = cachedEncoding(record);
+
+    std::string cachedJson;
+    std::string referenceJson;
+    bool decoded = exporters::DecodeRequest(blob, cachedJson, false);
+    EXPECT_EQ(decoded, exporters::DecodeRequest(referenceEncoding(record), referenceJson, false));
+    EXPECT_EQ(cachedJson, referenceJson);
+
+    ::CsProtocol::Record decodedRecord;
+    bond_lite::CompactBinaryProtocolReader reader(blob);
+    ASSERT_TRUE(bond_lite::Deserialize(reader, decodedRecord));
+    EXPECT_EQ(decodedRecord, record);
+}
+
+TEST_F(BondSerializerTests, PartACacheThroughput)
+{
+    const size_t count = 50000;
+    std::vector<::CsProtocol::Record> records;
+    records.reserve(count);
+    for (size_t i = 0; i < count; i++)
+    {
+        records.push_back(makeRecord(static_cast<int64_t>(i)));
+    }
+
+    // Keep per-event trace output out of the measurement
+    auto logLevel = PAL::detail::g_logLevel;
+    PAL::detail::g_logLevel = PAL::LogLevel::Error;
+
+    auto start = std::chrono::steady_clock::now();
+    for (auto& record : records)
+    {
+        IncomingEventContext ctx(1, "tenant", EventLatency_Normal, EventPersistence_Normal, &record);
+        bond_lite::CompactBinaryProtocolWriter writer(ctx.record.blob);
+        bond_lite::Serialize(writer, record);
+    }
+    auto referenceUs = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+
+    start = std::chrono::steady_clock::now();
+    for (auto& record : records)
+    {
+        cachedEncoding(record);
+    }
+    auto cachedUs = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+    PAL::detail::g_logLevel = logLevel;
+
+    std::cerr << "[          ] uncached records/sec = " << (count * 1000000.0) / (std::max)(referenceUs, decltype(referenceUs)(1)) << std::endl;
+    std::cerr << "[          ] cached   records/sec = " << (count * 1000000.0) / (std::max)(cachedUs, decltype(cachedUs)(1)) << std::endl;
+}
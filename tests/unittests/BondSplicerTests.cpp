@@ -143,3 +143,32 @@ TEST_F(BondSplicerTests, splice_TwoDataPackagesWithOneNonEmptyRecordEach_SizeTwe
 
    EXPECT_THAT(bs.splice().size(), size_t { 20 });
 }
+
+TEST_F(BondSplicerTests, splice_InterleavedTenants_GroupsRecordsPerTenantInOrder)
+{
+   auto serialize = [](char const* name) {
+       ::CsProtocol::Record r;
+       r.name = name;
+       std::vector<uint8_t> blob;
+       bond_lite::CompactBinaryProtocolWriter writer(blob);
+       bond_lite::Serialize(writer, r);
+       return blob;
+   };
+   auto firstTokenIndex = bs.addTenantToken("tenant1");
+   auto secondTokenIndex = bs.addTenantToken("tenant2");
+   char const* names[] = { "A1", "A2", "B1", "A3", "B2", "B3" };
+   for (char const* name : names)
+   {
+       ::CsProtocol::Record r;
+       r.name = name;
+       bs.addCsRecord(name[0] == 'A' ? firstTokenIndex : secondTokenIndex, r);
+   }
+
+   std::vector<uint8_t> expected;
+   for (char const* name : { "A1", "A2", "A3", "B1", "B2", "B3" })
+   {
+       auto blob = serialize(name);
+       expected.insert(expected.end(), blob.begin(), blob.end());
+   }
+   EXPECT_THAT(bs.splice(), ContainerEq(expected));
+}
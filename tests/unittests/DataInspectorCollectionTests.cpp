@@ -0,0 +1,201 @@
+//
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// SPDX-License-Identifier: Apache-2.0
+//
+#include "common/Common.hpp"
+
+#include "api/DataInspectorCollection.hpp"
+
+#include <thread>
+
+using namespace testing;
+using namespace MAT;
+
+namespace {
+
+    /// <summary>
+    /// Counts the records it inspects and marks each of them with its name
+    /// </summary>
+    class CountingDataInspector : public IDataInspector
+    {
+    public:
+        explicit CountingDataInspector(const char* name) :
+            m_name(name)
+        {
+        }
+
+        void SetEnabled(bool) noexcept override {}
+
+        bool IsEnabled() const noexcept override
+        {
+            return true;
+        }
+
+        bool InspectRecord(::CsProtocol::Record& record) noexcept override
+        {
+            record.data[0].properties[m_name].stringValue += "x";
+            inspected++;
+            return true;
+        }
+
+        void InspectSemanticContext(const std::string&, const std::string&, bool, const std::string&) noexcept override
+        {
+            contexts++;
+        }
+
+        void InspectSemanticContext(const std::string&, GUID_t, bool, const std::string&) noexcept override
+        {
+            contexts++;
+        }
+
+        const char* GetName() const noexcept override
+        {
+            return m_name;
+        }
+
+        std::atomic<size_t> inspected { 0 };
+        std::atomic<size_t> contexts { 0 };
+
+    private:
+        const char* m_name;
+    };
+
+    /// <summary>
+    /// Records of a group of logged events
+    /// </summary>
+    class EventGroup
+    {
+    public:
+        explicit EventGroup(size_t count) :
+            m_records(count),
+            m_contexts(count)
+        {
+            for (size_t i = 0; i < count; i++)
+            {
+                m_records[i].data.push_back(::CsProtocol::Data());
+                m_contexts[i].source = &m_records[i];
+                events.push_back(&m_contexts[i]);
+            }
+        }
+
+        ::CsProtocol::Record const& Record(size_t i) const
+        {
+            return m_records[i];
+        }
+
+        std::vector<IncomingEventContextPtr> events;
+
+    private:
+        std::vector<::CsProtocol::Record>   m_records;
+        std::vector<IncomingEventContext>   m_contexts;
+    };
+
+}
+
+TEST(DataInspectorCollectionTests, SetReplacesInspectorOfSameName)
+{
+    DataInspectorCollection collection;
+    EXPECT_TRUE(collection.IsEmpty());
+
+    auto first = std::make_shared<CountingDataInspector>("inspector");
+    auto second = std::make_shared<CountingDataInspector>("inspector");
+    auto other = std::make_shared<CountingDataInspector>("other");
+    EXPECT_FALSE(collection.Set(first));
+    EXPECT_FALSE(collection.Set(other));
+    EXPECT_TRUE(collection.Set(second));
+
+    EXPECT_FALSE(collection.IsEmpty());
+    EXPECT_THAT(collection.Get("inspector"), Eq(second));
+    EXPECT_THAT(collection.Get("other"), Eq(other));
+    EXPECT_THAT(collection.Get("unknown"), IsNull());
+
+    collection.Remove("inspector");
+    EXPECT_THAT(collection.Get("inspector"), IsNull());
+    EXPECT_FALSE(collection.IsEmpty());
+
+    collection.Clear();
+    EXPECT_THAT(collection.Get("other"), IsNull());
+    EXPECT_TRUE(collection.IsEmpty());
+}
+
+TEST(DataInspectorCollectionTests, InspectRecordRunsAllInspectors)
+{
+    DataInspectorCollection collection;
+    auto first = std::make_shared<CountingDataInspector>("first");
+    auto second = std::make_shared<CountingDataInspector>("second");
+    collection.Set(first);
+    collection.Set(second);
+
+    EventGroup group(1);
+    collection.InspectRecord(*group.events[0]->source);
+    collection.InspectSemanticContext("name", std::string("value"), true, std::string {});
+
+    EXPECT_THAT(group.Record(0).data[0].properties.at("first").stringValue, Eq("x"));
+    EXPECT_THAT(group.Record(0).data[0].properties.at("second").stringValue, Eq("x"));
+    EXPECT_THAT(first->contexts.load(), Eq(1u));
+    EXPECT_THAT(second->contexts.load(), Eq(1u));
+}
+
+TEST(DataInspectorCollectionTests, WorkersInspectEveryRecordOnce)
+{
+    DataInspectorCollection collection(3);
+    EXPECT_THAT(collection.GetWorkerCount(), Eq(3u));
+    auto inspector = std::make_shared<CountingDataInspector>("inspector");
+    collection.Set(inspector);
+
+    // Smaller than a chunk, fits no chunk evenly, and many chunks per thread
+    for (size_t count : { size_t(1), DataInspectorCollection::MinRecordsPerChunk * 4 + 1, size_t(1000) })
+    {
+        inspector->inspected = 0;
+        EventGroup group(count);
+        collection.InspectRecords(group.events);
+
+        EXPECT_THAT(inspector->inspected.load(), Eq(count));
+        for (size_t i = 0; i < count; i++)
+        {
+            ASSERT_THAT(group.Record(i).data[0].properties.at("inspector").stringValue, Eq("x"));
+        }
+    }
+}
+
+TEST(DataInspectorCollectionTests, ConcurrentGroupsShareWorkers)
+{
+    DataInspectorCollection collection(2);
+    auto inspector = std::make_shared<CountingDataInspector>("inspector");
+    collection.Set(inspector);
+
+    std::vector<std::thread> threads;
+    for (int thread = 0; thread < 4; thread++)
+    {
+        threads.emplace_back([&collection]() {
+            for (int i = 0; i < 50; i++)
+            {
+                EventGroup group(37);
+                collection.InspectRecords(group.events);
+                for (size_t j = 0; j < 37; j++)
+                {
+                    ASSERT_THAT(group.Record(j).data[0].properties.at("inspector").stringValue, Eq("x"));
+                }
+            }
+        });
+    }
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+
+    EXPECT_THAT(inspector->inspected.load(), Eq(4u * 50u * 37u));
+}
+
+TEST(DataInspectorCollectionTests, RemovedInspectorIsNotUsedAnymore)
+{
+    DataInspectorCollection collection;
+    auto inspector = std::make_shared<CountingDataInspector>("inspector");
+    collection.Set(inspector);
+    collection.Remove("inspector");
+
+    EventGroup group(10);
+    collection.InspectRecords(group.events);
+    EXPECT_THAT(inspector->inspected.load(), Eq(0u));
+    EXPECT_THAT(inspector.use_count(), Eq(1));
+}
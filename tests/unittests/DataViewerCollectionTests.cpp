@@ -264,3 +264,103 @@ TEST(DataViewerCollectionTests, IsViewerEnabledNoParam_MultipleViewersRegistered
     ASSERT_TRUE(dataViewerCollection.IsViewerEnabled());
 }
 
+
+TEST(DataViewerCollectionTests, DispatchDataViewerEvent_ViewerRegisteredAndTransmitting_ReceivesPacketOnDispatchThread)
+{
+    auto viewer = std::make_shared<MockIDataViewer>("sharedName", /*isTransmissionEnabled*/ true);
+    TestDataViewerCollection dataViewerCollection { };
+    dataViewerCollection.RegisterViewer(viewer);
+
+    std::vector<uint8_t> packet { 1, 2, 3 };
+    dataViewerCollection.DispatchDataViewerEvent(packet);
+    dataViewerCollection.WaitForDispatch();
+
+    EXPECT_THAT(viewer->localPacketData, ContainerEq(packet));
+    EXPECT_THAT(dataViewerCollection.GetDispatchedCount(), Eq(1u));
+    EXPECT_THAT(dataViewerCollection.GetDroppedCount(), Eq(0u));
+}
+
+TEST(DataViewerCollectionTests, DispatchDataViewerEvent_NoViewerTransmitting_NothingDispatched)
+{
+    auto viewer = std::make_shared<MockIDataViewer>("sharedName", /*isTransmissionEnabled*/ false);
+    TestDataViewerCollection dataViewerCollection { };
+    dataViewerCollection.RegisterViewer(viewer);
+
+    dataViewerCollection.DispatchDataViewerEvent(std::vector<uint8_t> { 1, 2, 3 });
+    dataViewerCollection.WaitForDispatch();
+
+    EXPECT_THAT(viewer->localPacketData, IsEmpty());
+    EXPECT_THAT(dataViewerCollection.GetDispatchedCount(), Eq(0u));
+}
+
+namespace {
+
+    /// <summary>
+    /// A viewer that holds the dispatch thread until released
+    /// </summary>
+    class BlockingDataViewer : public MockIDataViewer
+    {
+    public:
+        BlockingDataViewer() :
+            MockIDataViewer("blocking", /*isTransmissionEnabled*/ true)
+        {
+        }
+
+        void ReceiveData(const std::vector<uint8_t>& packetData) noexcept override
+        {
+            std::unique_lock<std::mutex> lock(m_lock);
+            received.push_back(packetData[0]);
+            m_receiving = true;
+            m_changed.notify_all();
+            m_changed.wait(lock, [this]() { return m_released; });
+        }
+
+        void WaitUntilReceiving()
+        {
+            std::unique_lock<std::mutex> lock(m_lock);
+            m_changed.wait(lock, [this]() { return m_receiving; });
+        }
+
+        void Release()
+        {
+            std::lock_guard<std::mutex> lock(m_lock);
+            m_released = true;
+            m_changed.notify_all();
+        }
+
+        std::vector<uint8_t> received;
+
+    private:
+        std::mutex              m_lock;
+        std::condition_variable m_changed;
+        bool                    m_receiving = false;
+        bool                    m_released = false;
+    };
+
+}
+
+TEST(DataViewerCollectionTests, DispatchDataViewerEvent_ViewerDoesNotKeepUp_OldestPacketsDropped)
+{
+    auto viewer = std::make_shared<BlockingDataViewer>();
+    TestDataViewerCollection dataViewerCollection { };
+    dataViewerCollection.RegisterViewer(viewer);
+
+    // The first packet is held by the viewer, then the queue overflows by 5 packets
+    dataViewerCollection.DispatchDataViewerEvent(std::vector<uint8_t> { 0 });
+    viewer->WaitUntilReceiving();
+    size_t const overflow = 5;
+    for (size_t i = 1; i <= DataViewerCollection::MaxPendingPackets + overflow; i++)
+    {
+        dataViewerCollection.DispatchDataViewerEvent(std::vector<uint8_t> { static_cast<uint8_t>(i) });
+    }
+    EXPECT_THAT(dataViewerCollection.GetDroppedCount(), Eq(overflow));
+
+    viewer->Release();
+    dataViewerCollection.WaitForDispatch();
+
+    ASSERT_THAT(viewer->received, SizeIs(1 + DataViewerCollection::MaxPendingPackets));
+    EXPECT_THAT(viewer->received[0], Eq(0));
+    EXPECT_THAT(viewer->received[1], Eq(1 + overflow));
+    EXPECT_THAT(viewer->received.back(), Eq(DataViewerCollection::MaxPendingPackets + overflow));
+    EXPECT_THAT(dataViewerCollection.GetDispatchedCount(), Eq(1 + DataViewerCollection::MaxPendingPackets));
+}
@@ -232,3 +232,57 @@ TEST(HttpClientCAPITests, CancelAllThenSend)
     EXPECT_EQ(wasSent, true);
     EXPECT_EQ(wasReceived, true);
 }
+
+static std::vector<string> s_sentIds;
+static http_complete_fn_t s_completeFn = nullptr;
+
+void EVTSDK_LIBABI_CDECL OnHttpSendDeferred(http_request_t* request, http_complete_fn_t callback)
+{
+    s_sentIds.push_back(request->id);
+    s_completeFn = callback;
+}
+
+TEST(HttpClientCAPITests, QueuesRequestsOverPerHostLimit)
+{
+    HttpClient_CAPI httpClient(&OnHttpSendDeferred, &OnHttpCancel);
+    HttpConnectionPoolOptions options;
+    options.maxConnectionsPerHost = 1;
+    httpClient.SetConnectionPoolOptions(options);
+    s_sentIds.clear();
+
+    std::vector<HttpResult> results;
+    TestHttpResponseCallback responseCallback;
+    responseCallback.SetResponseValidation([&results](IHttpResponse* response) {
+        results.push_back(response->GetResult());
+        delete response;
+    });
+
+    std::vector<std::unique_ptr<IHttpRequest>> requests;
+    for (auto url : { "https://www.microsoft.com/a", "https://WWW.microsoft.com:443/b", "https://www.microsoft.com/c", "https://other.microsoft.com/" })
+    {
+        requests.emplace_back(httpClient.CreateRequest());
+        requests.back()->SetUrl(url);
+        httpClient.SendRequestAsync(requests.back().get(), &responseCallback);
+    }
+
+    // One request per host goes out, the other two wait for the busy host
+    ASSERT_EQ(s_sentIds.size(), size_t { 2 });
+    EXPECT_EQ(s_sentIds[0], requests[0]->GetId());
+    EXPECT_EQ(s_sentIds[1], requests[3]->GetId());
+
+    // A queued request is aborted without reaching the host stack
+    httpClient.CancelRequestAsync(requests[2]->GetId());
+    ASSERT_EQ(results.size(), size_t { 1 });
+    EXPECT_EQ(results[0], HttpResult_Aborted);
+
+    // Completing the first request sends the next queued one
+    s_completeFn(requests[0]->GetId().c_str(), HTTP_RESULT_NETWORK_FAILURE, nullptr);
+    ASSERT_EQ(s_sentIds.size(), size_t { 3 });
+    EXPECT_EQ(s_sentIds[2], requests[1]->GetId());
+    EXPECT_EQ(results.size(), size_t { 2 });
+
+    s_completeFn(requests[1]->GetId().c_str(), HTTP_RESULT_OK, nullptr);
+    s_completeFn(requests[3]->GetId().c_str(), HTTP_RESULT_OK, nullptr);
+    EXPECT_EQ(results.size(), size_t { 4 });
+    EXPECT_EQ(s_sentIds.size(), size_t { 3 });
+}
@@ -345,5 +345,54 @@ TEST_F(HttpClientTests, SurvivesManyRequests)
     EXPECT_THAT(it, _countedRequests.end());
 
 }
+
+// Sends requests one by one and returns the average round trip time in microseconds
+static uint64_t SendSequentially(HttpClientTests& test, IHttpClient& client, std::string const& url, size_t count,
+                                 std::vector<IHttpResponse*>& responses)
+{
+    auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < count; i++) {
+        IHttpRequest* request = client.CreateRequest();
+        request->SetUrl(url);
+        client.SendRequestAsync(request, &test);
+        for (int j = 0; j < 2000 && responses.size() <= i; j++) {
+            PAL::sleep(1);
+        }
+    }
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count()) / count;
+}
+
+TEST_F(HttpClientTests, ReusesPooledConnections)
+{
+    Clear();
+    const size_t Count = 20;
+    std::string url = "http://" + _hostname + "/simple/200";
+
+    HttpConnectionPoolOptions options;
+    options.maxConnectionsPerHost = 0;
+    _client->SetConnectionPoolOptions(options);
+    size_t accepted = _server.getAcceptedConnections();
+    uint64_t unpooledUs = SendSequentially(*this, *_client, url, Count, _responses);
+    size_t unpooledHandshakes = _server.getAcceptedConnections() - accepted;
+    ASSERT_THAT(_responses.size(), Count);
+
+    options.maxConnectionsPerHost = 4;
+    _client->SetConnectionPoolOptions(options);
+    Clear();
+    accepted = _server.getAcceptedConnections();
+    uint64_t pooledUs = SendSequentially(*this, *_client, url, Count, _responses);
+    size_t pooledHandshakes = _server.getAcceptedConnections() - accepted;
+    ASSERT_THAT(_responses.size(), Count);
+    for (auto& response : _responses) {
+        EXPECT_THAT(response->GetResult(), HttpResult_OK);
+        EXPECT_THAT(response->GetStatusCode(), 200u);
+    }
+
+    std::cerr << "[          ] handshakes unpooled=" << unpooledHandshakes << " pooled=" << pooledHandshakes << std::endl;
+    std::cerr << "[          ] request latency unpooled=" << unpooledUs << "us pooled=" << pooledUs << "us" << std::endl;
+    EXPECT_THAT(unpooledHandshakes, Ge(Count));
+    EXPECT_THAT(pooledHandshakes, Lt(unpooledHandshakes / 2));
+}
 #endif // HAVE_MAT_DEFAULT_HTTP_CLIENT
 
@@ -82,6 +82,59 @@ TEST(LogManagerImplTests, DeadLoggersAreDead)
     logger->LogEvent("DeadLoggerEvent");
 }
 
+TEST(LogManagerImplTests, GetLoggerIgnoresCaseOfTokenAndSource)
+{
+    ILogConfiguration configuration;
+    TestLogManagerImpl logManager{configuration};
+    logManager.PauseTransmission();
+    auto logger = logManager.GetLogger("Fred", "Source");
+    ASSERT_NE(logger, nullptr);
+    EXPECT_EQ(logManager.GetLogger("FRED", "source"), logger);
+    EXPECT_NE(logManager.GetLogger("fred", "other"), logger);
+    EXPECT_NE(logManager.GetLogger("fred", ""), logger);
+    // Token and source are not just joined into one key
+    EXPECT_NE(logManager.GetLogger("a/b", ""), logManager.GetLogger("a", "b/"));
+    logManager.FlushAndTeardown();
+    EXPECT_EQ(logManager.GetLogger("Fred", "Source"), nullptr);
+}
+
+TEST(LogManagerImplTests, GetLoggerFromManyThreadsCreatesOneLoggerPerToken)
+{
+    ILogConfiguration configuration;
+    size_t onEntry = LogManagerImpl::GetDeadLoggerCount();
+    TestLogManagerImpl logManager{configuration};
+    logManager.PauseTransmission();
+
+    size_t const tokenCount = 10;
+    std::vector<std::future<std::vector<ILogger*>>> threads;
+    for (size_t thread = 0; thread < 8; thread++)
+    {
+        threads.push_back(std::async(std::launch::async, [&logManager, thread, tokenCount]() {
+            std::vector<ILogger*> loggers(tokenCount, nullptr);
+            for (size_t i = 0; i < 1000; i++)
+            {
+                size_t token = (i + thread) % tokenCount;
+                ILogger* logger = logManager.GetLogger("token" + std::to_string(token));
+                if (loggers[token] == nullptr)
+                {
+                    loggers[token] = logger;
+                }
+                EXPECT_EQ(logger, loggers[token]);
+            }
+            return loggers;
+        }));
+    }
+    auto first = threads[0].get();
+    EXPECT_THAT(first, Each(NotNull()));
+    for (size_t thread = 1; thread < threads.size(); thread++)
+    {
+        EXPECT_THAT(threads[thread].get(), ContainerEq(first));
+    }
+
+    logManager.FlushAndTeardown();
+    EXPECT_EQ(onEntry + tokenCount, LogManagerImpl::GetDeadLoggerCount());
+}
+
 TEST(LogManagerImplTests, NotPausedInitially)
 {
     ILogConfiguration configuration;
@@ -325,3 +325,52 @@ TEST_F(LoggerTests, LogSession_CanEventPropertiesBeSentReturnsTrue_CallsSubmit)
 }
 
 
+
+class LoggerTestsCountingListener : public DebugEventListener
+{
+public:
+    std::atomic<size_t> count{0};
+    virtual void OnDebugEvent(DebugEvent&) override
+    {
+        count++;
+    }
+};
+
+TEST_F(LoggerTests, LogEvents_CanEventPropertiesBeSentReturnsFalse_FiltersEveryEvent)
+{
+    LoggerTestsCountingListener filtered;
+    LoggerTestsCountingListener logged;
+    logManager.AddEventListener(DebugEventType::EVT_FILTERED, filtered);
+    logManager.AddEventListener(DebugEventType::EVT_LOG_EVENT, logged);
+    logger.GetEventFilters().RegisterEventFilter(MakeTestEventFilter(false));
+    logger.LogEvents(std::vector<EventProperties>(3, EventProperties("batch_event")));
+    EXPECT_EQ(filtered.count, 3u);
+    EXPECT_EQ(logged.count, 0u);
+    logManager.RemoveEventListener(DebugEventType::EVT_FILTERED, filtered);
+    logManager.RemoveEventListener(DebugEventType::EVT_LOG_EVENT, logged);
+}
+
+TEST_F(LoggerTests, LogEvents_CanEventPropertiesBeSentReturnsTrue_LogsEveryEvent)
+{
+    LoggerTestsCountingListener filtered;
+    LoggerTestsCountingListener logged;
+    logManager.AddEventListener(DebugEventType::EVT_FILTERED, filtered);
+    logManager.AddEventListener(DebugEventType::EVT_LOG_EVENT, logged);
+    logger.GetEventFilters().RegisterEventFilter(MakeTestEventFilter(true));
+    logger.LogEvents(std::vector<EventProperties>(3, EventProperties("batch_event")));
+    EXPECT_EQ(filtered.count, 0u);
+    EXPECT_EQ(logged.count, 3u);
+    logManager.RemoveEventListener(DebugEventType::EVT_FILTERED, filtered);
+    logManager.RemoveEventListener(DebugEventType::EVT_LOG_EVENT, logged);
+}
+
+TEST_F(LoggerTests, LogEvents_LatencyOff_DropsOnlyThatEvent)
+{
+    LoggerTestsCountingListener dropped;
+    logManager.AddEventListener(DebugEventType::EVT_DROPPED, dropped);
+    std::vector<EventProperties> events { EventProperties("first_event"), EventProperties("second_event"), EventProperties("third_event") };
+    events[1].SetLatency(EventLatency_Off);
+    logger.LogEvents(events);
+    EXPECT_EQ(dropped.count, 1u);
+    logManager.RemoveEventListener(DebugEventType::EVT_DROPPED, dropped);
+}
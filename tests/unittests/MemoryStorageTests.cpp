@@ -84,7 +84,7 @@ size_t addEvents(MemoryStorage& storage)
     {
         for (const EventLatency &lat : latencies)
         {
-            StorageRecord record{ PAL::generateUuidString(), "token", lat, EventPersistence_Critical, INT64_MIN + 1, { 5, 4, 3, 2, 1 }, 77, INT64_MAX - 1 };
+            StorageRecord record{ PAL::generateRecordId(), "token", lat, EventPersistence_Critical, INT64_MIN + 1, { 5, 4, 3, 2, 1 }, 77, INT64_MAX - 1 };
             total_db_size += record.blob.size() + sizeof(record);
             storage.StoreRecord(record);
         }
@@ -135,7 +135,7 @@ TEST_F(MemoryStorageTests, StoreAndGetRecords)
     EXPECT_THAT(storage.GetSize(), 0);
     
     // Check that EventLatency_Off doesn't get saved to ram queue
-    StorageRecord record{ PAL::generateUuidString(), "token", EventLatency_Off, EventPersistence_Critical, INT64_MIN + 1, { 5, 4, 3, 2, 1 }, 77, INT64_MAX - 1 };
+    StorageRecord record{ PAL::generateRecordId(), "token", EventLatency_Off, EventPersistence_Critical, INT64_MIN + 1, { 5, 4, 3, 2, 1 }, 77, INT64_MAX - 1 };
     EXPECT_THAT(storage.StoreRecord(record), false);
     EXPECT_THAT(storage.GetSize(), 0);
 
@@ -378,3 +378,55 @@ TEST_F(MemoryStorageTests, MultiThreadPerfTest)
 
 }
 
+
+TEST_F(MemoryStorageTests, StoreRecordsCompactsStoredRecordsToFront)
+{
+    MemoryStorage storage(testLogManager, *testConfig);
+    storage.Initialize(testObserver);
+
+    std::vector<StorageRecord> records;
+    records.push_back(StorageRecord{ 1, "token", EventLatency_Off, EventPersistence_Normal, 0, { 1 } });
+    records.push_back(StorageRecord{ 2, "token", EventLatency_Normal, EventPersistence_Normal, 0, { 1 } });
+    records.push_back(StorageRecord{ 3, "token", EventLatency_Off, EventPersistence_Normal, 0, { 1 } });
+    records.push_back(StorageRecord{ 4, "token", EventLatency_RealTime, EventPersistence_Normal, 0, { 1 } });
+
+    // Latency Off records are rejected, stored ones keep their relative order
+    EXPECT_EQ(storage.StoreRecords(records), 2u);
+    EXPECT_EQ(records[0].id, 2u);
+    EXPECT_EQ(records[1].id, 4u);
+    EXPECT_EQ(storage.GetRecordCount(), 2u);
+}
+
+TEST_F(MemoryStorageTests, StoreRecordsBatchPerfTest)
+{
+    const size_t count = 100000;
+    std::vector<StorageRecord> records;
+    records.reserve(count);
+    for (size_t i = 0; i < count; i++)
+    {
+        records.push_back(StorageRecord{ i + 1, "token", EventLatency_Normal, EventPersistence_Normal, 0, { 5, 4, 3, 2, 1 } });
+    }
+
+    MemoryStorage single(testLogManager, *testConfig);
+    auto start = std::chrono::steady_clock::now();
+    for (auto& record : records)
+    {
+        single.StoreRecord(record);
+    }
+    auto singleMs = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count();
+
+    MemoryStorage batched(testLogManager, *testConfig);
+    start = std::chrono::steady_clock::now();
+    EXPECT_EQ(batched.StoreRecords(records), count);
+    auto batchMs = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count();
+
+    std::cerr << "[          ] StoreRecord x" << count << ": " << singleMs << " ms" << std::endl;
+    std::cerr << "[          ] StoreRecords x" << count << ": " << batchMs << " ms" << std::endl;
+    EXPECT_EQ(single.GetRecordCount(), batched.GetRecordCount());
+}
+
+TEST_F(MemoryStorageTests, StoreReserveReleaseDelete100kPerfTest)
+{
+    MemoryStorage storage(testLogManager, *testConfig);
+    MeasureStorageLifecycle(storage, 100000);
+}
@@ -41,8 +41,8 @@ TEST_F(MetaStatsTests, GenerateStartEvent)
     stats.updateOnStorageOpened("MyStorage/Normal");
     stats.updateOnPostData(postDataLength, false);
 
-    std::map<std::string, std::string> recordIdAndTenantid;
-    recordIdAndTenantid["r"] = "t";
+    PackagedRecords recordIdAndTenantid;
+    recordIdAndTenantid.add(1, "t");
     stats.updateOnPackageSentSucceeded(recordIdAndTenantid, EventLatency_Normal,        0,   333, std::vector<unsigned>{ 1333 },          false);
     stats.updateOnPackageSentSucceeded(recordIdAndTenantid, EventLatency_Normal,     1,   444, std::vector<unsigned>{ 1444, 2444 },    false);
     stats.updateOnPackageSentSucceeded(recordIdAndTenantid, EventLatency_RealTime,       3,  5555, std::vector<unsigned>{ 15, 255, 3555 }, false);
@@ -69,8 +69,8 @@ TEST_F(MetaStatsTests, GenerateStopEvent)
     EXPECT_CALL(runtimeConfigMock, GetMetaStatsSendIntervalSec()).WillRepeatedly(Return(0));
     EXPECT_CALL(runtimeConfigMock, GetMetaStatsTenantToken()).WillRepeatedly(Return("metastats-tenant-token"));
     stats.updateOnPostData(16, false);
-    std::map<std::string, std::string> recordIdAndTenantid;
-    recordIdAndTenantid["r"] = "t";
+    PackagedRecords recordIdAndTenantid;
+    recordIdAndTenantid.add(1, "t");
     stats.updateOnPackageSentSucceeded(recordIdAndTenantid, EventLatency_RealTime, 1, 99, std::vector<unsigned>{ 100, 101, 102, 103, 104, 105, 106 }, false);
     stats.updateOnPackageFailed(501);
     stats.updateOnPackageFailed(403);
@@ -102,8 +102,8 @@ TEST_F(MetaStatsTests, NoNewDataOrMetastatsOnlyGenerateNoEvents)
     stats.updateOnEventIncoming("s",123, EventLatency_RealTime, true);
     stats.updateOnEventIncoming("s",123, EventLatency_Normal, true);
     stats.updateOnPostData(123, true);
-    std::map<std::string, std::string> recordIdAndTenantid;
-    recordIdAndTenantid["r"] = "t";
+    PackagedRecords recordIdAndTenantid;
+    recordIdAndTenantid.add(1, "t");
     stats.updateOnPackageSentSucceeded(recordIdAndTenantid, EventLatency_RealTime, 0, 123, std::vector<unsigned>{ 1234 }, true);
     events = stats.generateStatsEvent(ACT_STATS_ROLLUP_KIND_ONGOING);
     //EXPECT_THAT(events, SizeIs(0));
@@ -0,0 +1,221 @@
+//
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// SPDX-License-Identifier: Apache-2.0
+//
+#include "common/Common.hpp"
+#include "stats/MetricAggregator.hpp"
+#include "AggregatedMetric.hpp"
+#include "NullObjects.hpp"
+
+#include <thread>
+
+using namespace testing;
+using namespace MAT;
+
+class RollUpLogger : public NullLogger
+{
+  public:
+    std::mutex lock;
+    std::vector<AggregatedMetricData> rollUps;
+    std::vector<std::string> eventNames;
+
+    virtual void LogAggregatedMetric(AggregatedMetricData const& metricData, EventProperties const& properties) override
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        rollUps.push_back(metricData);
+        eventNames.push_back(properties.GetName());
+    }
+
+    size_t count()
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        return rollUps.size();
+    }
+};
+
+class MetricAggregatorTests : public Test
+{
+  protected:
+    RollUpLogger logger;
+    AggregatedMetricData metric { "latency", 0, 0 };
+    EventProperties properties { "latency_event" };
+};
+
+TEST_F(MetricAggregatorTests, BucketsArePowersOfTwo)
+{
+    EXPECT_THAT(MetricAggregator::GetBucket(0), 0);
+    EXPECT_THAT(MetricAggregator::GetBucket(0.5), 0);
+    EXPECT_THAT(MetricAggregator::GetBucket(-0.5), 0);
+    EXPECT_THAT(MetricAggregator::GetBucket(1), 1);
+    EXPECT_THAT(MetricAggregator::GetBucket(1.5), 2);
+    EXPECT_THAT(MetricAggregator::GetBucket(2), 2);
+    EXPECT_THAT(MetricAggregator::GetBucket(3), 4);
+    EXPECT_THAT(MetricAggregator::GetBucket(1000), 1024);
+    EXPECT_THAT(MetricAggregator::GetBucket(-5), -8);
+
+    long largest = 1L << MetricAggregator::MaxBucketExponent;
+    EXPECT_THAT(MetricAggregator::GetBucket(1e300), largest);
+    EXPECT_THAT(MetricAggregator::GetBucket(-std::numeric_limits<double>::infinity()), -largest);
+}
+
+TEST_F(MetricAggregatorTests, RollUpAggregatesSamples)
+{
+    metric.units = "ms";
+    metric.objectClass = "request";
+    MetricAggregator aggregator(metric, 0, properties, &logger);
+    for (double value : { 3.0, 1.0, 7.0, 100.0, 0.25 })
+    {
+        aggregator.Push(value);
+    }
+    aggregator.Push(std::numeric_limits<double>::quiet_NaN());
+
+    EXPECT_TRUE(aggregator.RollUp());
+    ASSERT_THAT(logger.rollUps, SizeIs(1));
+    auto const& data = logger.rollUps[0];
+    EXPECT_THAT(data.name, Eq("latency"));
+    EXPECT_THAT(data.units, Eq("ms"));
+    EXPECT_THAT(data.objectClass, Eq("request"));
+    EXPECT_THAT(logger.eventNames[0], Eq("latency_event"));
+    EXPECT_THAT(data.count, 5);
+    EXPECT_THAT(data.duration, Ge(0));
+    EXPECT_THAT(data.aggregates, ElementsAre(
+        Pair(AggregateType_Sum, DoubleEq(111.25)),
+        Pair(AggregateType_Maximum, DoubleEq(100)),
+        Pair(AggregateType_Minimum, DoubleEq(0.25)),
+        Pair(AggregateType_SumOfSquares, DoubleEq(9 + 1 + 49 + 10000 + 0.0625))));
+    EXPECT_THAT(data.buckets, ElementsAre(Pair(0, 1), Pair(1, 1), Pair(4, 1), Pair(8, 1), Pair(128, 1)));
+
+    // Every roll-up starts over, and empty intervals are not logged
+    EXPECT_FALSE(aggregator.RollUp());
+    aggregator.Push(-2);
+    EXPECT_TRUE(aggregator.RollUp());
+    ASSERT_THAT(logger.rollUps, SizeIs(2));
+    EXPECT_THAT(logger.rollUps[1].count, 1);
+    EXPECT_THAT(logger.rollUps[1].aggregates[AggregateType_Minimum], DoubleEq(-2));
+    EXPECT_THAT(logger.rollUps[1].buckets, ElementsAre(Pair(-2, 1)));
+}
+
+TEST_F(MetricAggregatorTests, DestructorRollsUpRemainingSamples)
+{
+    {
+        MetricAggregator aggregator(metric, 3600, properties, &logger);
+        aggregator.Push(1);
+    }
+    ASSERT_THAT(logger.rollUps, SizeIs(1));
+    EXPECT_THAT(logger.rollUps[0].count, 1);
+}
+
+TEST_F(MetricAggregatorTests, TimerRollsUpPeriodically)
+{
+    MetricAggregator aggregator(metric, 1, properties, &logger);
+    aggregator.Push(1);
+    for (size_t i = 0; (i < 300) && (logger.count() == 0); i++)
+    {
+        PAL::sleep(10);
+    }
+    ASSERT_THAT(logger.count(), 1u);
+    EXPECT_THAT(logger.rollUps[0].duration, Ge(900 * 1000));
+}
+
+TEST_F(MetricAggregatorTests, ConcurrentPushesAreNeverLost)
+{
+    static size_t const threadCount = 8;
+    static size_t const pushCount = 20000;
+    MetricAggregator aggregator(metric, 0, properties, &logger);
+
+    std::atomic<size_t> running { threadCount };
+    std::vector<std::thread> threads;
+    for (size_t t = 0; t < threadCount; t++)
+    {
+        threads.emplace_back([&aggregator, &running, t]() {
+            for (size_t i = 0; i < pushCount; i++)
+            {
+                aggregator.Push(static_cast<double>(t + 1));
+            }
+            running--;
+        });
+    }
+    // Roll up while the threads are pushing
+    while (running > 0)
+    {
+        aggregator.RollUp();
+        std::this_thread::yield();
+    }
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+    aggregator.RollUp();
+
+    long count = 0;
+    double sum = 0, min = 100, max = 0;
+    std::map<long, long> buckets;
+    for (auto& data : logger.rollUps)
+    {
+        long bucketTotal = 0;
+        for (auto const& bucket : data.buckets)
+        {
+            buckets[bucket.first] += bucket.second;
+            bucketTotal += bucket.second;
+        }
+        // Samples are never split between roll-ups
+        EXPECT_THAT(bucketTotal, data.count);
+        count += data.count;
+        sum += data.aggregates[AggregateType_Sum];
+        min = std::min(min, data.aggregates[AggregateType_Minimum]);
+        max = std::max(max, data.aggregates[AggregateType_Maximum]);
+    }
+    EXPECT_THAT(count, static_cast<long>(threadCount * pushCount));
+    EXPECT_THAT(sum, DoubleEq(pushCount * (threadCount * (threadCount + 1) / 2)));
+    EXPECT_THAT(min, DoubleEq(1));
+    EXPECT_THAT(max, DoubleEq(threadCount));
+    EXPECT_THAT(buckets, ElementsAre(Pair(1, pushCount), Pair(2, pushCount), Pair(4, 2 * pushCount), Pair(8, 4 * pushCount)));
+}
+
+TEST_F(MetricAggregatorTests, AggregatedMetricLogsThroughLogger)
+{
+    {
+        Models::AggregatedMetric aggregated("size", "bytes", 3600, "instance", "class", "id", properties, &logger);
+        aggregated.PushMetric(10);
+        aggregated.PushMetric(20);
+    }
+    ASSERT_THAT(logger.rollUps, SizeIs(1));
+    auto const& data = logger.rollUps[0];
+    EXPECT_THAT(data.name, Eq("size"));
+    EXPECT_THAT(data.units, Eq("bytes"));
+    EXPECT_THAT(data.instanceName, Eq("instance"));
+    EXPECT_THAT(data.objectId, Eq("id"));
+    EXPECT_THAT(data.count, 2);
+    EXPECT_THAT(data.aggregates.at(AggregateType_Sum), DoubleEq(30));
+}
+
+TEST_F(MetricAggregatorTests, PushMetricPerfTest)
+{
+    static size_t const pushCount = 1000000;
+    size_t hardwareThreads = std::max(std::thread::hardware_concurrency(), 1u);
+    for (size_t threadCount = 1; threadCount <= std::max<size_t>(hardwareThreads, 4); threadCount *= 2)
+    {
+        MetricAggregator aggregator(metric, 0, properties, &logger);
+        std::vector<std::thread> threads;
+        auto start = std::chrono::steady_clock::now();
+        for (size_t t = 0; t < threadCount; t++)
+        {
+            threads.emplace_back([&aggregator]() {
+                for (size_t i = 0; i < pushCount; i++)
+                {
+                    aggregator.Push(static_cast<double>(i & 1023));
+                }
+            });
+        }
+        for (auto& thread : threads)
+        {
+            thread.join();
+        }
+        auto elapsedUs = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+        EXPECT_TRUE(aggregator.RollUp());
+
+        double pushesPerSec = (elapsedUs > 0) ? (threadCount * pushCount * 1e6 / elapsedUs) : 0;
+        std::cerr << "[          ] PushMetric x" << pushCount << " on " << threadCount << " thread(s): "
+                  << elapsedUs / 1000 << " ms, " << static_cast<uint64_t>(pushesPerSec / 1e6) << "M pushes/s" << std::endl;
+    }
+}
@@ -85,8 +85,8 @@ TEST_F(OfflineStorageTests, RetrieveEventsPassesRecordsThrough)
     ctx->requestedMinLatency = EventLatency_Normal;
     ctx->requestedMaxCount = 6;
 
-    StorageRecord record1("r1", "tenant1-token", EventLatency_Normal, EventPersistence_Normal, 1234567890, std::vector<uint8_t>{1, 127, 255});
-    StorageRecord record2("r2", "tenant2-token", EventLatency_Normal, EventPersistence_Normal, 1234567891, std::vector<uint8_t>{2, 128, 0});
+    StorageRecord record1(1, "tenant1-token", EventLatency_Normal, EventPersistence_Normal, 1234567890, std::vector<uint8_t>{1, 127, 255});
+    StorageRecord record2(2, "tenant2-token", EventLatency_Normal, EventPersistence_Normal, 1234567891, std::vector<uint8_t>{2, 128, 0});
     EXPECT_CALL(offlineStorageMock, GetAndReserveRecords(_, Gt(1000u), ctx->requestedMinLatency, ctx->requestedMaxCount))
         .WillOnce(DoAll(
             Invoke([&record1, &record2](std::function<bool(StorageRecord&&)> const& consumer, unsigned, EventLatency, unsigned) {
@@ -133,11 +133,7 @@ TEST_F(OfflineStorageTests, DeleteRecordsIsForwarded)
     auto ctx = std::make_shared<EventsUploadContext>();
     HttpHeaders test;
     bool fromMemory = false;
-    std::vector<std::string> recordIds;
-    for (const auto& element : ctx->recordIdsAndTenantIds)
-    {
-        recordIds.push_back(element.first);
-    }
+    std::vector<StorageRecordId> recordIds = ctx->recordIdsAndTenantIds.ids();
     ctx->fromMemory = fromMemory;
     EXPECT_CALL(offlineStorageMock, DeleteRecords(recordIds, test, fromMemory)).WillOnce(Return());
     EXPECT_THAT(offlineStorage.deleteRecords(ctx), true);
@@ -148,11 +144,7 @@ TEST_F(OfflineStorageTests, ReleaseRecordsIsForwarded)
     auto ctx = std::make_shared<EventsUploadContext>();
     HttpHeaders test;
     bool fromMemory = false;
-    std::vector<std::string> recordIds;
-    for (const auto& element : ctx->recordIdsAndTenantIds)
-    {
-        recordIds.push_back(element.first);
-    }
+    std::vector<StorageRecordId> recordIds = ctx->recordIdsAndTenantIds.ids();
     ctx->fromMemory = fromMemory;
     EXPECT_CALL(offlineStorageMock, ReleaseRecords(recordIds, false, test, fromMemory))
         .WillOnce(Return());
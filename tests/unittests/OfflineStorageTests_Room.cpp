@@ -112,7 +112,7 @@ public:
         if (records.empty()) {
             return;
         }
-        std::vector<std::string> ids;
+        std::vector<StorageRecordId> ids;
         ids.reserve(records.size());
         for (auto &record : records) {
             ids.emplace_back(std::move(record.id));
@@ -141,7 +141,7 @@ public:
                 id_stream << "Fred-" << i << "-" << latency;
                 std::string id = id_stream.str();
                 records.emplace_back(
-                        id,
+                        PAL::generateRecordId(),
                         id,
                         latency,
                         EventPersistence_Normal,
@@ -218,7 +218,7 @@ TEST_P(OfflineStorageTestsRoom, TestStoreRecords)
         id_stream << "Fred-" << i;
         std::string id = id_stream.str();
         records.emplace_back(
-                id,
+                PAL::generateRecordId(),
                 id,
                 EventLatency_Normal,
                 EventPersistence_Normal,
@@ -263,7 +263,7 @@ TEST_P(OfflineStorageTestsRoom, TestGetAndReserveManyAcceptSome) {
         id_stream << "Fred-" << i;
         std::string id = id_stream.str();
         records.emplace_back(
-                id,
+                PAL::generateRecordId(),
                 id,
                 EventLatency_Normal,
                 EventPersistence_Normal,
@@ -380,7 +380,7 @@ TEST_P(OfflineStorageTestsRoom, TestGetRecords) {
         std::ostringstream s;
         s << "Fred-" << i;
         records.emplace_back(
-                s.str(),
+                PAL::generateRecordId(),
                 s.str(),
                 i < 10 ? EventLatency_Normal : EventLatency_RealTime,
                 EventPersistence_Normal,
@@ -414,7 +414,7 @@ TEST_P(OfflineStorageTestsRoom, TestManyExpiredRecords) {
     for (size_t i = 0; i < count; ++i) {
         std::string thing = std::to_string(i);
         manyRecords.emplace_back(
-            thing, // id std::string const& tenantToken, EventLatency latency, EventPersistence persistence)
+            static_cast<StorageRecordId>(i + 1), // id
             thing, // token
             EventLatency_Normal,
             EventPersistence_Normal,
@@ -464,7 +464,7 @@ TEST_P(OfflineStorageTestsRoom, LastReadRecordCount) {
         auto id = id_hash(i);
         auto id_string = std::to_string(id);
         records.emplace_back(
-                id_string,
+                static_cast<StorageRecordId>(i + 1),
                 id_string,
                 EventLatency_Normal,
                 EventPersistence_Normal,
@@ -491,7 +491,7 @@ TEST_P(OfflineStorageTestsRoom, LastReadRecordCount) {
 TEST_P(OfflineStorageTestsRoom, ReleaseActuallyReleases) {
     auto now = PAL::getUtcSystemTimeMs();
     StorageRecord r(
-            "Fred",
+            1,
             "George",
             EventLatency_Normal,
             EventPersistence_Normal,
@@ -532,10 +532,9 @@ TEST_P(OfflineStorageTestsRoom, DeleteByToken)
     StorageRecordVector records;
     auto now = PAL::getUtcSystemTimeMs();
     for (size_t i = 0; i < 1000; ++i) {
-        auto id = std::to_string(i);
         auto tenantToken = std::to_string(i % 5);
         records.emplace_back(
-                id,
+                static_cast<StorageRecordId>(i + 1),
                 tenantToken,
                 EventLatency_Normal,
                 EventPersistence_Normal,
@@ -558,7 +557,7 @@ TEST_P(OfflineStorageTestsRoom, ResizeDB)
     auto now = PAL::getUtcSystemTimeMs();
 
     StorageRecord record(
-            "",
+            0,
             "TenantFred",
             EventLatency_Normal,
             EventPersistence_Normal,
@@ -567,7 +566,7 @@ TEST_P(OfflineStorageTestsRoom, ResizeDB)
             );
     size_t index = 1;
     while (offlineStorage->GetSize() <= configMock.GetOfflineStorageMaximumSizeBytes()) {
-        record.id = std::to_string(index);
+        record.id = index;
         offlineStorage->StoreRecord(record);
         index += 1;
     }
@@ -599,7 +598,7 @@ TEST_P(OfflineStorageTestsRoom, StoreManyRecords)
     records.reserve(blockSize);
     while (records.size() < blockSize) {
         records.emplace_back(
-                "",
+                0,
                 "Fred-Doom-Token23",
                 EventLatency_Normal,
                 EventPersistence_Normal,
@@ -610,7 +609,7 @@ TEST_P(OfflineStorageTestsRoom, StoreManyRecords)
 
     while (offlineStorage->GetSize() < targetSize) {
         for (auto & record : records) {
-            record.id = std::to_string(randomWord(gen));
+            record.id = randomWord(gen);
         }
         offlineStorage->StoreRecords(records);
         ++blocks;
@@ -39,6 +39,12 @@ class OfflineStorage_SQLiteNoAutoCommit : public OfflineStorage_SQLite
     virtual void scheduleAutoCommitTransaction()
     {
     }
+
+    // Bytes of ids, tokens and (possibly compressed) payloads stored so far
+    size_t GetStoredSizeEstimate() const
+    {
+        return m_DbSizeEstimate;
+    }
 };
 
 
@@ -126,8 +132,8 @@ TEST_F(OfflineStorageTests_SQLite, InitializeAndShutdownCreateFileThatCanBeDelet
 TEST_F(OfflineStorageTests_SQLite, StorageRecordConstructorSetsAllFields)
 {
     initializeStorage();
-    StorageRecord record{ "guid", "token", EventLatency_RealTime, EventPersistence_Critical, INT64_MIN + 1, { 5, 4, 3, 2, 1 }, 77, INT64_MAX - 1 };
-    EXPECT_THAT(record.id, StrEq("guid"));
+    StorageRecord record{ 1, "token", EventLatency_RealTime, EventPersistence_Critical, INT64_MIN + 1, { 5, 4, 3, 2, 1 }, 77, INT64_MAX - 1 };
+    EXPECT_THAT(record.id, Eq(1u));
     EXPECT_THAT(record.tenantToken, StrEq("token"));
     EXPECT_THAT(record.latency, EventLatency_RealTime);
     EXPECT_THAT(record.timestamp, INT64_MIN + 1);
@@ -139,7 +145,7 @@ TEST_F(OfflineStorageTests_SQLite, StorageRecordConstructorSetsAllFields)
 TEST_F(OfflineStorageTests_SQLite, GetAndReservedReturnsStoredRecord)
 {
     initializeStorage();
-    StorageRecord record{ "guid", "token", EventLatency_Normal, EventPersistence_Normal, 1, { 5, 4, 3, 2, 1 } };
+    StorageRecord record{ 1, "token", EventLatency_Normal, EventPersistence_Normal, 1, { 5, 4, 3, 2, 1 } };
     ASSERT_THAT(offlineStorage->StoreRecord(record), true);
     TestRecordConsumer consumer;
     EXPECT_THAT(offlineStorage->GetAndReserveRecords(consumer, 100000), true);
@@ -156,9 +162,9 @@ TEST_F(OfflineStorageTests_SQLite, GetAndReservedReturnsStoredRecord)
 TEST_F(OfflineStorageTests_SQLite, ReservedRecordIsNotReturned)
 {
     initializeStorage();
-    ASSERT_THAT(offlineStorage->StoreRecord({"guid1", "token", EventLatency_Normal, EventPersistence_Normal, 1, {}}), true);
-    ASSERT_THAT(offlineStorage->StoreRecord({"guid2", "token", EventLatency_Normal, EventPersistence_Normal, 1, {}}), true);
-    ASSERT_THAT(offlineStorage->StoreRecord({"guid3", "token", EventLatency_Normal, EventPersistence_Normal, 1, {}}), true);
+    ASSERT_THAT(offlineStorage->StoreRecord({1, "token", EventLatency_Normal, EventPersistence_Normal, 1, {}}), true);
+    ASSERT_THAT(offlineStorage->StoreRecord({2, "token", EventLatency_Normal, EventPersistence_Normal, 1, {}}), true);
+    ASSERT_THAT(offlineStorage->StoreRecord({3, "token", EventLatency_Normal, EventPersistence_Normal, 1, {}}), true);
     TestRecordConsumer consumer;
     EXPECT_THAT(offlineStorage->GetAndReserveRecords(consumer, 100000, EventLatency_Unspecified, 1), true);
     ASSERT_THAT(consumer.records.size(), 1);
@@ -170,24 +176,41 @@ TEST_F(OfflineStorageTests_SQLite, ReservedRecordIsNotReturned)
 TEST_F(OfflineStorageTests_SQLite, DeletedRecordsAreNotReturned)
 {
     initializeStorage();
-    ASSERT_THAT(offlineStorage->StoreRecord({"guid1", "token", EventLatency_Normal, EventPersistence_Normal, 1, {}}), true);
-    ASSERT_THAT(offlineStorage->StoreRecord({"guid2", "token", EventLatency_Normal, EventPersistence_Normal, 1, {}}), true);
-    ASSERT_THAT(offlineStorage->StoreRecord({"guid3", "token", EventLatency_Normal, EventPersistence_Normal, 1, {}}), true);
+    ASSERT_THAT(offlineStorage->StoreRecord({1, "token", EventLatency_Normal, EventPersistence_Normal, 1, {}}), true);
+    ASSERT_THAT(offlineStorage->StoreRecord({2, "token", EventLatency_Normal, EventPersistence_Normal, 1, {}}), true);
+    ASSERT_THAT(offlineStorage->StoreRecord({3, "token", EventLatency_Normal, EventPersistence_Normal, 1, {}}), true);
+    HttpHeaders test;
+    bool fromMemory = false;
+    offlineStorage->DeleteRecords({ 1, 3 }, test, fromMemory);
+
+    TestRecordConsumer consumer;
+    EXPECT_THAT(offlineStorage->GetAndReserveRecords(consumer, 100000), true);
+    ASSERT_THAT(consumer.records.size(), 1);
+    EXPECT_THAT(consumer.records[0].id, Eq(2u));
+}
+
+TEST_F(OfflineStorageTests_SQLite, RecordsAreFoundByIdsInWholeRange)
+{
+    initializeStorage();
+    // IDs from 2^63 up do not fit a signed SQLite integer
+    ASSERT_THAT(offlineStorage->StoreRecord({UINT64_MAX, "token", EventLatency_Normal, EventPersistence_Normal, 1, {}}), true);
+    ASSERT_THAT(offlineStorage->StoreRecord({uint64_t(1) << 63, "token", EventLatency_Normal, EventPersistence_Normal, 2, {}}), true);
+    ASSERT_THAT(offlineStorage->StoreRecord({INT64_MAX, "token", EventLatency_Normal, EventPersistence_Normal, 3, {}}), true);
     HttpHeaders test;
     bool fromMemory = false;
-    offlineStorage->DeleteRecords({"guid1", "guid3"}, test, fromMemory);
+    offlineStorage->DeleteRecords({ UINT64_MAX, INT64_MAX }, test, fromMemory);
 
     TestRecordConsumer consumer;
     EXPECT_THAT(offlineStorage->GetAndReserveRecords(consumer, 100000), true);
     ASSERT_THAT(consumer.records.size(), 1);
-    EXPECT_THAT(consumer.records[0].id, StrEq("guid2"));
+    EXPECT_THAT(consumer.records[0].id, Eq(uint64_t(1) << 63));
 }
 
 TEST_F(OfflineStorageTests_SQLite, ReservedRecordsAreReleasedAfterTimeout)
 {
     initializeStorage();
-    ASSERT_THAT(offlineStorage->StoreRecord({"guid1", "token", EventLatency_Normal, EventPersistence_Normal, 1, {}}), true);
-    ASSERT_THAT(offlineStorage->StoreRecord({"guid2", "token", EventLatency_Normal, EventPersistence_Normal, 1, {}}), true);
+    ASSERT_THAT(offlineStorage->StoreRecord({1, "token", EventLatency_Normal, EventPersistence_Normal, 1, {}}), true);
+    ASSERT_THAT(offlineStorage->StoreRecord({2, "token", EventLatency_Normal, EventPersistence_Normal, 1, {}}), true);
     TestRecordConsumer consumer;
     // Reserve first for 2 secs
     EXPECT_THAT(offlineStorage->GetAndReserveRecords(consumer, 2000, EventLatency_Unspecified, 1), true);
@@ -214,12 +237,12 @@ TEST_F(OfflineStorageTests_SQLite, GetAndReserveRecordsReservesRecordsSortedByTi
 {
     initializeStorage();
     StorageRecord unsortedRecords[] = {
-        { "guid-6", "token", EventLatency_Normal, EventPersistence_Normal, 3, {11} },
-        { "guid-1", "token", EventLatency_Normal, EventPersistence_Normal, 4, {22} },
-        { "guid-5", "token", EventLatency_Normal, EventPersistence_Normal, 1, {33} },
-        { "guid-4", "token", EventLatency_Normal, EventPersistence_Normal, 2, {44} },
-        { "guid-3", "token", EventLatency_Normal, EventPersistence_Normal, 6, {55} },
-        { "guid-2", "token", EventLatency_Normal, EventPersistence_Normal, 5, {66} }
+        { 6, "token", EventLatency_Normal, EventPersistence_Normal, 3, {11} },
+        { 1, "token", EventLatency_Normal, EventPersistence_Normal, 4, {22} },
+        { 5, "token", EventLatency_Normal, EventPersistence_Normal, 1, {33} },
+        { 4, "token", EventLatency_Normal, EventPersistence_Normal, 2, {44} },
+        { 3, "token", EventLatency_Normal, EventPersistence_Normal, 6, {55} },
+        { 2, "token", EventLatency_Normal, EventPersistence_Normal, 5, {66} }
     };
 
     for (auto const& r : unsortedRecords) {
@@ -244,74 +267,74 @@ TEST_F(OfflineStorageTests_SQLite, GetAndReserveRecordsReservesRecordsSortedByTi
 TEST_F(OfflineStorageTests_SQLite, GetAndReserveRecordsReturnsOnlyHighestPriority)
 {
     initializeStorage();
-    ASSERT_THAT(offlineStorage->StoreRecord({"guid-11", "token1", EventLatency_Normal, EventPersistence_Normal, 1, {}}), true);
-    ASSERT_THAT(offlineStorage->StoreRecord({"guid-12", "token1", EventLatency_Normal, EventPersistence_Normal, 2, {}}), true);
-    ASSERT_THAT(offlineStorage->StoreRecord({"guid-13", "token1", EventLatency_RealTime, EventPersistence_Critical,   3, {}}), true);
-    ASSERT_THAT(offlineStorage->StoreRecord({"guid-21", "token2", EventLatency_Normal, EventPersistence_Normal, 4, {}}), true);
-    ASSERT_THAT(offlineStorage->StoreRecord({"guid-22", "token2", EventLatency_RealTime, EventPersistence_Critical,   5, {}}), true);
+    ASSERT_THAT(offlineStorage->StoreRecord({11, "token1", EventLatency_Normal, EventPersistence_Normal, 1, {}}), true);
+    ASSERT_THAT(offlineStorage->StoreRecord({12, "token1", EventLatency_Normal, EventPersistence_Normal, 2, {}}), true);
+    ASSERT_THAT(offlineStorage->StoreRecord({13, "token1", EventLatency_RealTime, EventPersistence_Critical,   3, {}}), true);
+    ASSERT_THAT(offlineStorage->StoreRecord({21, "token2", EventLatency_Normal, EventPersistence_Normal, 4, {}}), true);
+    ASSERT_THAT(offlineStorage->StoreRecord({22, "token2", EventLatency_RealTime, EventPersistence_Critical,   5, {}}), true);
 
     TestRecordConsumer consumer;
     EXPECT_THAT(offlineStorage->GetAndReserveRecords(consumer, 10000, EventLatency_RealTime), true);
     ASSERT_THAT(consumer.records.size(), 2);
-    EXPECT_THAT(consumer.records[0].id, StrEq("guid-13"));
-    EXPECT_THAT(consumer.records[1].id, StrEq("guid-22"));
+    EXPECT_THAT(consumer.records[0].id, Eq(13u));
+    EXPECT_THAT(consumer.records[1].id, Eq(22u));
 }
 
 TEST_F(OfflineStorageTests_SQLite, GetAndReserveRecordsReturnsLowerPriorityIfHighestReserved)
 {
     initializeStorage();
-    ASSERT_THAT(offlineStorage->StoreRecord({"guid-11", "token1", EventLatency_RealTime, EventPersistence_Critical,   1, {}}), true);
-    ASSERT_THAT(offlineStorage->StoreRecord({"guid-12", "token1", EventLatency_Normal, EventPersistence_Normal, 2, {}}), true);
-    ASSERT_THAT(offlineStorage->StoreRecord({"guid-13", "token1", EventLatency_Normal, EventPersistence_Normal, 3, {}}), true);
+    ASSERT_THAT(offlineStorage->StoreRecord({11, "token1", EventLatency_RealTime, EventPersistence_Critical,   1, {}}), true);
+    ASSERT_THAT(offlineStorage->StoreRecord({12, "token1", EventLatency_Normal, EventPersistence_Normal, 2, {}}), true);
+    ASSERT_THAT(offlineStorage->StoreRecord({13, "token1", EventLatency_Normal, EventPersistence_Normal, 3, {}}), true);
 
     TestRecordConsumer consumer;
     EXPECT_THAT(offlineStorage->GetAndReserveRecords(consumer, 10000, EventLatency_RealTime), true);
     ASSERT_THAT(consumer.records.size(), 1);
-    EXPECT_THAT(consumer.records[0].id, StrEq("guid-11"));
+    EXPECT_THAT(consumer.records[0].id, Eq(11u));
     consumer.records.clear();
     EXPECT_THAT(offlineStorage->GetAndReserveRecords(consumer, 10000, EventLatency_Normal), true);
     ASSERT_THAT(consumer.records.size(), 2);
-    EXPECT_THAT(consumer.records[0].id, StrEq("guid-12"));
-    EXPECT_THAT(consumer.records[1].id, StrEq("guid-13"));
+    EXPECT_THAT(consumer.records[0].id, Eq(12u));
+    EXPECT_THAT(consumer.records[1].id, Eq(13u));
 }
 
 TEST_F(OfflineStorageTests_SQLite, GetAndReserveRecordsReservesOnlyReturnedRecordsWhenLimited)
 {
     initializeStorage();
-    ASSERT_THAT(offlineStorage->StoreRecord({"guid-1", "token", EventLatency_Normal, EventPersistence_Normal, 1, {}}), true);
-    ASSERT_THAT(offlineStorage->StoreRecord({"guid-2", "token", EventLatency_Normal, EventPersistence_Normal, 2, {}}), true);
-    ASSERT_THAT(offlineStorage->StoreRecord({"guid-3", "token", EventLatency_Normal, EventPersistence_Normal, 3, {}}), true);
-    ASSERT_THAT(offlineStorage->StoreRecord({"guid-4", "token", EventLatency_Normal, EventPersistence_Normal, 4, {}}), true);
-    ASSERT_THAT(offlineStorage->StoreRecord({"guid-5", "token", EventLatency_Normal, EventPersistence_Normal, 5, {}}), true);
-    ASSERT_THAT(offlineStorage->StoreRecord({"guid-6", "token", EventLatency_Normal, EventPersistence_Normal, 6, {}}), true);
+    ASSERT_THAT(offlineStorage->StoreRecord({1, "token", EventLatency_Normal, EventPersistence_Normal, 1, {}}), true);
+    ASSERT_THAT(offlineStorage->StoreRecord({2, "token", EventLatency_Normal, EventPersistence_Normal, 2, {}}), true);
+    ASSERT_THAT(offlineStorage->StoreRecord({3, "token", EventLatency_Normal, EventPersistence_Normal, 3, {}}), true);
+    ASSERT_THAT(offlineStorage->StoreRecord({4, "token", EventLatency_Normal, EventPersistence_Normal, 4, {}}), true);
+    ASSERT_THAT(offlineStorage->StoreRecord({5, "token", EventLatency_Normal, EventPersistence_Normal, 5, {}}), true);
+    ASSERT_THAT(offlineStorage->StoreRecord({6, "token", EventLatency_Normal, EventPersistence_Normal, 6, {}}), true);
 
     // limiting by consumer
     TestRecordConsumer limitedConsumer;
     limitedConsumer.maxCount = 2;
     EXPECT_THAT(offlineStorage->GetAndReserveRecords(limitedConsumer, 10000), true);
     ASSERT_THAT(limitedConsumer.records.size(), 2);
-    EXPECT_THAT(limitedConsumer.records[0].id, StrEq("guid-1"));
-    EXPECT_THAT(limitedConsumer.records[1].id, StrEq("guid-2"));
+    EXPECT_THAT(limitedConsumer.records[0].id, Eq(1u));
+    EXPECT_THAT(limitedConsumer.records[1].id, Eq(2u));
 
     // limiting by maxCount in getAndReserveRecords
     TestRecordConsumer consumer;
     EXPECT_THAT(offlineStorage->GetAndReserveRecords(consumer, 10000, EventLatency_Normal, 2), true);
     ASSERT_THAT(consumer.records.size(), 2);
-    EXPECT_THAT(consumer.records[0].id, StrEq("guid-3"));
-    EXPECT_THAT(consumer.records[1].id, StrEq("guid-4"));
+    EXPECT_THAT(consumer.records[0].id, Eq(3u));
+    EXPECT_THAT(consumer.records[1].id, Eq(4u));
 
     // still can reserve not consumed records
     consumer.records.clear();
     EXPECT_THAT(offlineStorage->GetAndReserveRecords(consumer, 10000), true);
     ASSERT_THAT(consumer.records.size(), 2);
-    EXPECT_THAT(consumer.records[0].id, StrEq("guid-5"));
-    EXPECT_THAT(consumer.records[1].id, StrEq("guid-6"));
+    EXPECT_THAT(consumer.records[0].id, Eq(5u));
+    EXPECT_THAT(consumer.records[1].id, Eq(6u));
 }
 
 TEST_F(OfflineStorageTests_SQLite, ReleaseRecordsMakesThemAvailableAgain)
 {
     initializeStorage();
-    StorageRecord record{ "guid", "token", EventLatency_Normal, EventPersistence_Normal, 1, {11} };
+    StorageRecord record{ 1, "token", EventLatency_Normal, EventPersistence_Normal, 1, {11} };
     ASSERT_THAT(offlineStorage->StoreRecord(record), true);
 
     TestRecordConsumer consumer;
@@ -320,7 +343,7 @@ TEST_F(OfflineStorageTests_SQLite, ReleaseRecordsMakesThemAvailableAgain)
     EXPECT_THAT(consumer.records[0].retryCount, 0);
     HttpHeaders test;
     bool fromMemory = false;
-    offlineStorage->ReleaseRecords({ "guid" }, false, test, fromMemory);
+    offlineStorage->ReleaseRecords({ 1 }, false, test, fromMemory);
 
     consumer.records.clear();
     EXPECT_THAT(offlineStorage->GetAndReserveRecords(consumer, 100000), true);
@@ -331,7 +354,7 @@ TEST_F(OfflineStorageTests_SQLite, ReleaseRecordsMakesThemAvailableAgain)
 TEST_F(OfflineStorageTests_SQLite, ReleaseRecordsIncrementsRetryCount)
 {
     initializeStorage();
-    StorageRecord record{ "guid", "token", EventLatency_Normal, EventPersistence_Normal, 1, {11} };
+    StorageRecord record{ 1, "token", EventLatency_Normal, EventPersistence_Normal, 1, {11} };
     ASSERT_THAT(offlineStorage->StoreRecord(record), true);
 
     TestRecordConsumer consumer;
@@ -343,7 +366,7 @@ TEST_F(OfflineStorageTests_SQLite, ReleaseRecordsIncrementsRetryCount)
         .WillOnce(Return(2));
     HttpHeaders test;
     bool fromMemory = false;
-    offlineStorage->ReleaseRecords({ "guid" }, true, test, fromMemory);
+    offlineStorage->ReleaseRecords({ 1 }, true, test, fromMemory);
 
     consumer.records.clear();
     EXPECT_THAT(offlineStorage->GetAndReserveRecords(consumer, 100000), true);
@@ -354,14 +377,14 @@ TEST_F(OfflineStorageTests_SQLite, ReleaseRecordsIncrementsRetryCount)
 TEST_F(OfflineStorageTests_SQLite, ReleaseUnreservedRecordsDoesntIncrementRetryCount)
 {
     initializeStorage();
-    StorageRecord record{ "guid", "token", EventLatency_Normal, EventPersistence_Normal, 1, {11} };
+    StorageRecord record{ 1, "token", EventLatency_Normal, EventPersistence_Normal, 1, {11} };
     ASSERT_THAT(offlineStorage->StoreRecord(record), true);
 
     EXPECT_CALL(configMock, GetMaximumRetryCount())
         .WillOnce(Return(2));
     HttpHeaders test;
     bool fromMemory = false;
-    offlineStorage->ReleaseRecords({ "guid" }, true, test, fromMemory);
+    offlineStorage->ReleaseRecords({ 1 }, true, test, fromMemory);
 
     TestRecordConsumer consumer;
     EXPECT_THAT(offlineStorage->GetAndReserveRecords(consumer, 100000), true);
@@ -372,8 +395,8 @@ TEST_F(OfflineStorageTests_SQLite, ReleaseUnreservedRecordsDoesntIncrementRetryC
 TEST_F(OfflineStorageTests_SQLite, ReleaseRecordsDeletesRecordsOverMaxRetryCount)
 {
     initializeStorage();
-    ASSERT_THAT(offlineStorage->StoreRecord({ "guid",  "token", EventLatency_RealTime, EventPersistence_Critical, 1, {11} }), true);
-    ASSERT_THAT(offlineStorage->StoreRecord({ "guid2", "token", EventLatency_Normal, EventPersistence_Normal, 1, {22} }), true);
+    ASSERT_THAT(offlineStorage->StoreRecord({ 1, "token", EventLatency_RealTime, EventPersistence_Critical, 1, {11} }), true);
+    ASSERT_THAT(offlineStorage->StoreRecord({ 2, "token", EventLatency_Normal, EventPersistence_Normal, 1, {22} }), true);
 
     TestRecordConsumer consumer;
     int const MaxRetryCount = 5;
@@ -391,13 +414,13 @@ TEST_F(OfflineStorageTests_SQLite, ReleaseRecordsDeletesRecordsOverMaxRetryCount
             .Times((i == MaxRetryCount) ? 1 : 0);
         HttpHeaders test;
         bool fromMemory = false;
-        offlineStorage->ReleaseRecords({ "guid" }, true, test, fromMemory);
+        offlineStorage->ReleaseRecords({ 1 }, true, test, fromMemory);
     }
 
     consumer.records.clear();
     EXPECT_THAT(offlineStorage->GetAndReserveRecords(consumer, 100000, EventLatency_Normal), true);
     ASSERT_THAT(consumer.records.size(), 1);
-    EXPECT_THAT(consumer.records[0].id, StrEq("guid2"));
+    EXPECT_THAT(consumer.records[0].id, Eq(2u));
     EXPECT_THAT(consumer.records[0].retryCount, 0);
 }
 
@@ -405,12 +428,12 @@ TEST_F(OfflineStorageTests_SQLite, GetAndReserveRecordsReturnsRecordsSortedByTim
 {
     initializeStorage();
     StorageRecord unsortedRecords[] = {
-        { "guid-6", "token3", EventLatency_Normal, EventPersistence_Normal,    3, {11} },
-        { "guid-1", "token5", EventLatency_RealTime, EventPersistence_Critical, 4, {22} },
-        { "guid-5", "token4", EventLatency_Max, EventPersistence_Critical,2, {33} },
-        { "guid-4", "token2", EventLatency_Normal, EventPersistence_Normal, 1, {44} },
-        { "guid-3", "token1", EventLatency_Max, EventPersistence_Critical, 6, {55} },
-        { "guid-2", "token6", EventLatency_Max, EventPersistence_Critical, 5, {66} }
+        { 6, "token3", EventLatency_Normal, EventPersistence_Normal,    3, {11} },
+        { 1, "token5", EventLatency_RealTime, EventPersistence_Critical, 4, {22} },
+        { 5, "token4", EventLatency_Max, EventPersistence_Critical,2, {33} },
+        { 4, "token2", EventLatency_Normal, EventPersistence_Normal, 1, {44} },
+        { 3, "token1", EventLatency_Max, EventPersistence_Critical, 6, {55} },
+        { 2, "token6", EventLatency_Max, EventPersistence_Critical, 5, {66} }
     };
 
     for (auto const& r : unsortedRecords) {
@@ -420,9 +443,9 @@ TEST_F(OfflineStorageTests_SQLite, GetAndReserveRecordsReturnsRecordsSortedByTim
     TestRecordConsumer consumer;
     EXPECT_THAT(offlineStorage->GetAndReserveRecords(consumer, 100000, EventLatency_Max), true);
     ASSERT_THAT(consumer.records.size(), 3);
-    EXPECT_THAT(consumer.records[0].id, StrEq("guid-5"));
-    EXPECT_THAT(consumer.records[1].id, StrEq("guid-2"));
-    EXPECT_THAT(consumer.records[2].id, StrEq("guid-3"));
+    EXPECT_THAT(consumer.records[0].id, Eq(5u));
+    EXPECT_THAT(consumer.records[1].id, Eq(2u));
+    EXPECT_THAT(consumer.records[2].id, Eq(3u));
 }
 
 // Timing tests do not make sense in debug builds.
@@ -434,7 +457,7 @@ TEST_F(OfflineStorageTests_SQLite, StoreThousandEventsTakesLessThanASecond)
     auto startTimeMs = PAL::getMonotonicTimeMs();
 
     for (int i = 0; i < 1000; ++i) {
-        EXPECT_THAT(offlineStorage->StoreRecord({std::to_string(i), "token", EventLatency_Normal, EventPersistence_Normal, 1, {}}), true);
+        EXPECT_THAT(offlineStorage->StoreRecord({static_cast<StorageRecordId>(i + 1), "token", EventLatency_Normal, EventPersistence_Normal, 1, {}}), true);
     }
 
     TestRecordConsumer consumer;
@@ -448,6 +471,32 @@ TEST_F(OfflineStorageTests_SQLite, StoreThousandEventsTakesLessThanASecond)
 
 #endif  // NDEBUG
 
+TEST_F(OfflineStorageTests_SQLite, StoreReserveReleaseDelete100kPerfTest)
+{
+    initializeStorage();
+    MeasureStorageLifecycle(*offlineStorage, 100000);
+}
+
+TEST_F(OfflineStorageTests_SQLite, StoreRecordsStoresValidRecordsOfBatchInOrder)
+{
+    initializeStorage();
+    std::vector<StorageRecord> records {
+        { 1, "token", EventLatency_Normal, EventPersistence_Normal, 1, { 1 } },
+        { 0, "token", EventLatency_Normal, EventPersistence_Normal, 2, { 2 } },
+        { 3, "token", EventLatency_Normal, EventPersistence_Normal, 3, { 3 } }
+    };
+    EXPECT_CALL(observerMock, OnStorageFailed("Invalid parameters"));
+    EXPECT_THAT(offlineStorage->StoreRecords(records), 2);
+    EXPECT_THAT(records[0].id, Eq(1u));
+    EXPECT_THAT(records[1].id, Eq(3u));
+
+    TestRecordConsumer consumer;
+    EXPECT_THAT(offlineStorage->GetAndReserveRecords(consumer, 10000), true);
+    ASSERT_THAT(consumer.records, SizeIs(2));
+    EXPECT_THAT(consumer.records[0].id, Eq(1u));
+    EXPECT_THAT(consumer.records[1].id, Eq(3u));
+}
+
 TEST_F(OfflineStorageTests_SQLite, OnInvalidFilename)
 {
     initializeStorage();
@@ -556,17 +605,17 @@ TEST_P(BadRecordsTests, BadRecordStoredIsNotFoundInDb)
 }
 
 StorageRecord GOOD_RECORDS[] = {
-    { "{ guid-\"' ", "tenant -to\"ken'", EventLatency_Normal, EventPersistence_Normal, INT64_MAX, StorageBlob{ 1, 2, 3, 4, 5, 6, 7 } },
-    { "guid",        "tenant-token",     EventLatency_Max, EventPersistence_Critical, 1, StorageBlob(1024 * 1024, uint8_t(7)) },
-    { "guid",        "tenant-token",     EventLatency_Off, EventPersistence_Normal, 1, {} }
+    { INT64_MAX, "tenant -to\"ken'", EventLatency_Normal, EventPersistence_Normal, INT64_MAX, StorageBlob{ 1, 2, 3, 4, 5, 6, 7 } },
+    { 1,         "tenant-token",     EventLatency_Max, EventPersistence_Critical, 1, StorageBlob(1024 * 1024, uint8_t(7)) },
+    { 1,         "tenant-token",     EventLatency_Off, EventPersistence_Normal, 1, {} }
 };
 
 StorageRecord BAD_RECORDS[] = {
-    { "",     "tenant-token", EventLatency_Normal, EventPersistence_Normal,                2, { 1, 2, 3 } },
-    { "guid", "",             EventLatency_Normal, EventPersistence_Normal,                2, { 1, 2, 3 } },
-    { "guid", "tenant-token", EventLatency_Unspecified,EventPersistence_Normal,       0, {} },
-    { "guid", "tenant-token", static_cast<EventLatency>(987),EventPersistence_Normal,  0, {} },
-    { "guid", "tenant-token", EventLatency_Normal, EventPersistence_Normal,            -1, {} }
+    { 0, "tenant-token", EventLatency_Normal, EventPersistence_Normal,                2, { 1, 2, 3 } },
+    { 1, "",             EventLatency_Normal, EventPersistence_Normal,                2, { 1, 2, 3 } },
+    { 1, "tenant-token", EventLatency_Unspecified,EventPersistence_Normal,       0, {} },
+    { 1, "tenant-token", static_cast<EventLatency>(987),EventPersistence_Normal,  0, {} },
+    { 1, "tenant-token", EventLatency_Normal, EventPersistence_Normal,            -1, {} }
 };
 
 INSTANTIATE_TEST_SUITE_P(OfflineStorageTests_SQLite, GoodRecordsTests, ::testing::ValuesIn(GOOD_RECORDS));
@@ -628,12 +677,12 @@ TEST_F(OfflineStorageTests_SQLite, APICallsAreHarmlessAfterStorageIsShutdown)
     offlineStorage->Shutdown();
     HttpHeaders test;
     bool fromMemory = false;
-    offlineStorage->DeleteRecords({ "1", "2", "" }, test, fromMemory);
+    offlineStorage->DeleteRecords({ 1, 2, 0 }, test, fromMemory);
     TestRecordConsumer consumer;
     EXPECT_THAT(offlineStorage->GetAndReserveRecords(consumer, 100000), false);
     fromMemory = false;
-    offlineStorage->ReleaseRecords({ "1", "2", "" }, true, test, fromMemory);
-    offlineStorage->StoreRecord({"guid-1", "token", EventLatency_Normal, EventPersistence_Normal, 1, {}});
+    offlineStorage->ReleaseRecords({ 1, 2, 0 }, true, test, fromMemory);
+    offlineStorage->StoreRecord({1, "token", EventLatency_Normal, EventPersistence_Normal, 1, {}});
     offlineStorage->StoreSetting("name", "value");
     EXPECT_THAT(offlineStorage->GetSetting("name"), StrEq(""));
 
@@ -647,25 +696,25 @@ TEST_F(OfflineStorageTests_SQLite, ExceededStorageSizeCausesDbToDropOldestEvents
     configMock[CFG_BOOL_ENABLE_DB_DROP_IF_FULL] = true;
     initializeStorage(false);
 
-    ASSERT_THAT(offlineStorage->StoreRecord({"oldest with high prio", "token", EventLatency_RealTime, EventPersistence_Critical,   1, StorageBlob(1024 * 1024)}), true);
-    ASSERT_THAT(offlineStorage->StoreRecord({"oldest with mid prio1", "token", EventLatency_Normal, EventPersistence_Normal, 2, StorageBlob(1024 * 1024)}), true); // X
-    ASSERT_THAT(offlineStorage->StoreRecord({"some more mid prio e1", "token", EventLatency_Normal, EventPersistence_Normal, 3, StorageBlob(1024 * 1024)}), true);
-    ASSERT_THAT(offlineStorage->StoreRecord({"oldest with low prio ", "token", EventLatency_Normal, EventPersistence_Normal,    4, StorageBlob(1024 * 1024)}), true); // X
+    ASSERT_THAT(offlineStorage->StoreRecord({101, "token", EventLatency_RealTime, EventPersistence_Critical,   1, StorageBlob(1024 * 1024)}), true);
+    ASSERT_THAT(offlineStorage->StoreRecord({102, "token", EventLatency_Normal, EventPersistence_Normal, 2, StorageBlob(1024 * 1024)}), true); // X
+    ASSERT_THAT(offlineStorage->StoreRecord({103, "token", EventLatency_Normal, EventPersistence_Normal, 3, StorageBlob(1024 * 1024)}), true);
+    ASSERT_THAT(offlineStorage->StoreRecord({104, "token", EventLatency_Normal, EventPersistence_Normal,    4, StorageBlob(1024 * 1024)}), true); // X
 
     std::map<std::string, size_t> trimedRecord;
     trimedRecord["token"] = 3;
     // This should exceed storage size and trigger resize
     // EXPECT_CALL(observerMock, OnStorageTrimmed(trimedRecord));
-    ASSERT_THAT(offlineStorage->StoreRecord({"newest with low prio", "token", EventLatency_Normal, EventPersistence_Normal, 5, StorageBlob(1024 * 1024)}), true); // X
+    ASSERT_THAT(offlineStorage->StoreRecord({105, "token", EventLatency_Normal, EventPersistence_Normal, 5, StorageBlob(1024 * 1024)}), true); // X
 
     TestRecordConsumer consumer;
     EXPECT_THAT(offlineStorage->GetAndReserveRecords(consumer, 100000, EventLatency_RealTime), true);
     ASSERT_THAT(consumer.records.size(), 1);
-    EXPECT_THAT(consumer.records[0].id, StrEq("oldest with high prio"));
+    EXPECT_THAT(consumer.records[0].id, Eq(101u));
     consumer.records.clear();
     EXPECT_THAT(offlineStorage->GetAndReserveRecords(consumer, 100000, EventLatency_Normal), true);
     ASSERT_THAT(consumer.records.size(), 3);
-    EXPECT_THAT(consumer.records[0].id, StrEq("some more mid prio e1"));
+    EXPECT_THAT(consumer.records[0].id, Eq(103u));
     consumer.records.clear();
     EXPECT_THAT(offlineStorage->GetAndReserveRecords(consumer, 100000, EventLatency_Normal), false);
     ASSERT_THAT(consumer.records.size(), 0);
@@ -682,19 +731,179 @@ TEST_F(OfflineStorageTests_SQLite, TrimmingAlwaysDropsAtLeastOneEvent)
     trimedRecord["token"] = 1;
     // EXPECT_CALL(observerMock, OnStorageTrimmed(trimedRecord));
 
-    ASSERT_THAT(offlineStorage->StoreRecord({"old", "token", EventLatency_Normal, EventPersistence_Normal, 1, StorageBlob(33 * 1024)}), true); // X
-    ASSERT_THAT(offlineStorage->StoreRecord({"mid", "token", EventLatency_Normal, EventPersistence_Normal, 2, StorageBlob(33 * 1024)}), true);
+    ASSERT_THAT(offlineStorage->StoreRecord({106, "token", EventLatency_Normal, EventPersistence_Normal, 1, StorageBlob(33 * 1024)}), true); // X
+    ASSERT_THAT(offlineStorage->StoreRecord({107, "token", EventLatency_Normal, EventPersistence_Normal, 2, StorageBlob(33 * 1024)}), true);
     // The next call triggers the trimming (after the insertion is done) and
     // removes the oldest event marked with X above.
-    ASSERT_THAT(offlineStorage->StoreRecord({"new", "token", EventLatency_Normal, EventPersistence_Normal, 3, StorageBlob(33 * 1024)}), true);
+    ASSERT_THAT(offlineStorage->StoreRecord({108, "token", EventLatency_Normal, EventPersistence_Normal, 3, StorageBlob(33 * 1024)}), true);
 
     TestRecordConsumer consumer;
     EXPECT_THAT(offlineStorage->GetAndReserveRecords(consumer, 100000), true);
     ASSERT_THAT(consumer.records.size(), 2);
-    EXPECT_THAT(consumer.records[0].id, StrEq("mid"));
-    EXPECT_THAT(consumer.records[1].id, StrEq("new"));
+    EXPECT_THAT(consumer.records[0].id, Eq(107u));
+    EXPECT_THAT(consumer.records[1].id, Eq(108u));
+}
+
+TEST_F(OfflineStorageTests_SQLite, Version1DatabaseIsUpgradedAndKeepsRecords)
+{
+    initializeStorage();
+    offlineStorage->Execute("DROP TABLE events");
+    offlineStorage->Execute("CREATE TABLE events (record_id TEXT,tenant_token TEXT NOT NULL,latency INTEGER,persistence INTEGER,"
+                            "timestamp INTEGER,retry_count INTEGER DEFAULT 0,reserved_until INTEGER DEFAULT 0,payload BLOB)");
+    offlineStorage->Execute("INSERT INTO events (record_id,tenant_token,latency,persistence,timestamp,payload)"
+                            " VALUES ('old','token',2,1,1,x'010203')");
+    offlineStorage->Execute("PRAGMA user_version=1");
+    offlineStorage->Shutdown();
+
+    EXPECT_CALL(observerMock, OnStorageOpened("SQLite/Default"));
+    offlineStorage->Initialize(observerMock);
+    ASSERT_THAT(offlineStorage->StoreRecord({PAL::generateRecordId(), "token", EventLatency_Normal, EventPersistence_Normal, 2, { 4, 5 }}), true);
+
+    TestRecordConsumer consumer;
+    EXPECT_THAT(offlineStorage->GetAndReserveRecords(consumer, 100000), true);
+    ASSERT_THAT(consumer.records.size(), 2);
+    // The UUID of the old record is replaced with a numeric ID of its own
+    EXPECT_THAT(consumer.records[0].id, Ne(0u));
+    EXPECT_THAT(consumer.records[0].id, Ne(consumer.records[1].id));
+    EXPECT_THAT(consumer.records[0].blob, StorageBlob({ 1, 2, 3 }));
+    EXPECT_THAT(consumer.records[1].blob, StorageBlob({ 4, 5 }));
+}
+
+TEST_F(OfflineStorageTests_SQLite, RecordDigestIsStoredWithRecord)
+{
+    initializeStorage();
+    StorageRecord signedRecord{ 109, "token", EventLatency_Normal, EventPersistence_Normal, 1, { 1, 2, 3 } };
+    signedRecord.digest = { 0xDE, 0xAD, 0xBE, 0xEF };
+    ASSERT_THAT(offlineStorage->StoreRecord(signedRecord), true);
+    ASSERT_THAT(offlineStorage->StoreRecord({110, "token", EventLatency_Normal, EventPersistence_Normal, 2, { 4, 5 }}), true);
+    offlineStorage->Shutdown();
+
+    EXPECT_CALL(observerMock, OnStorageOpened("SQLite/Default"));
+    offlineStorage->Initialize(observerMock);
+    TestRecordConsumer consumer;
+    EXPECT_THAT(offlineStorage->GetAndReserveRecords(consumer, 100000), true);
+    ASSERT_THAT(consumer.records.size(), 2);
+    EXPECT_THAT(consumer.records[0].digest, signedRecord.digest);
+    EXPECT_THAT(consumer.records[1].digest, IsEmpty());
+
+    auto records = offlineStorage->GetRecords(true);
+    ASSERT_THAT(records.size(), 2);
+    EXPECT_THAT(records[0].digest, signedRecord.digest);
+}
+
+#ifdef HAVE_MAT_ZLIB
+
+// Bond-like payload: field names and values repeat across events, ids do not
+static StorageBlob makeEventPayload(size_t index)
+{
+    std::string payload;
+    for (size_t field = 0; field < 12; field++)
+    {
+        payload += "\x29\x0b" "Ms.Telemetry.Field" + std::to_string(field) + "\x09";
+        payload += "value-" + std::to_string(field * 7) + "-" + std::to_string(index * 2654435761u) + ";";
+    }
+    return StorageBlob(payload.begin(), payload.end());
+}
+
+TEST_F(OfflineStorageTests_SQLite, CompressedPayloadsAreSmallerAndRetrievedIntact)
+{
+    configMock[CFG_BOOL_ENABLE_DB_COMPRESS] = true;
+    initializeStorage();
+
+    StorageRecord record{ 1, "token", EventLatency_Normal, EventPersistence_Normal, 1, StorageBlob(64 * 1024, uint8_t(7)) };
+    size_t sizeBefore = offlineStorage->GetStoredSizeEstimate();
+    ASSERT_THAT(offlineStorage->StoreRecord(record), true);
+    EXPECT_THAT(offlineStorage->GetStoredSizeEstimate() - sizeBefore, Lt(record.blob.size() / 10));
+
+    TestRecordConsumer consumer;
+    EXPECT_THAT(offlineStorage->GetAndReserveRecords(consumer, 100000), true);
+    ASSERT_THAT(consumer.records.size(), 1);
+    EXPECT_THAT(consumer.records[0].blob, record.blob);
+
+    auto records = offlineStorage->GetRecords(true);
+    ASSERT_THAT(records.size(), 1);
+    EXPECT_THAT(records[0].blob, record.blob);
+}
+
+TEST_F(OfflineStorageTests_SQLite, CompressedAndRawPayloadsCanBeMixed)
+{
+    initializeStorage();
+    ASSERT_THAT(offlineStorage->StoreRecord({111, "token", EventLatency_Normal, EventPersistence_Normal, 1, makeEventPayload(1)}), true);
+    offlineStorage->Shutdown();
+
+    configMock[CFG_BOOL_ENABLE_DB_COMPRESS] = true;
+    offlineStorage.reset(new OfflineStorage_SQLiteNoAutoCommit(*logManager, configMock));
+    EXPECT_CALL(observerMock, OnStorageOpened("SQLite/Default"));
+    offlineStorage->Initialize(observerMock);
+    ASSERT_THAT(offlineStorage->StoreRecord({112, "token", EventLatency_Normal, EventPersistence_Normal, 2, makeEventPayload(2)}), true);
+    // Payloads that would not shrink are stored as they are
+    ASSERT_THAT(offlineStorage->StoreRecord({113, "token", EventLatency_Normal, EventPersistence_Normal, 3, { 1, 2, 3 }}), true);
+
+    TestRecordConsumer consumer;
+    EXPECT_THAT(offlineStorage->GetAndReserveRecords(consumer, 100000), true);
+    ASSERT_THAT(consumer.records.size(), 3);
+    EXPECT_THAT(consumer.records[0].blob, makeEventPayload(1));
+    EXPECT_THAT(consumer.records[1].blob, makeEventPayload(2));
+    EXPECT_THAT(consumer.records[2].blob, StorageBlob({ 1, 2, 3 }));
+}
+
+TEST_F(OfflineStorageTests_SQLite, CorruptCompressedPayloadsAreDropped)
+{
+    configMock[CFG_BOOL_ENABLE_DB_COMPRESS] = true;
+    initializeStorage();
+    ASSERT_THAT(offlineStorage->StoreRecord({114, "token", EventLatency_Normal, EventPersistence_Normal, 1, makeEventPayload(1)}), true);
+    offlineStorage->Execute("INSERT INTO events (record_id,tenant_token,latency,persistence,timestamp,payload,compressed)"
+                            " VALUES ('bad','token',2,1,2,x'DEADBEEF',1)");
+
+    TestRecordConsumer consumer;
+    EXPECT_THAT(offlineStorage->GetAndReserveRecords(consumer, 100000), true);
+    ASSERT_THAT(consumer.records.size(), 1);
+    EXPECT_THAT(consumer.records[0].id, Eq(114u));
+    EXPECT_THAT(offlineStorage->GetRecordCount(EventLatency_Unspecified), 1);
+}
+
+TEST_F(OfflineStorageTests_SQLite, PayloadCompressionPerfTest)
+{
+    static size_t const recordCount = 2000;
+    for (bool compress : { false, true })
+    {
+        configMock[CFG_BOOL_ENABLE_DB_COMPRESS] = compress;
+        initializeStorage();
+
+        std::vector<StorageRecord> records;
+        size_t rawBytes = 0;
+        for (size_t i = 0; i < recordCount; i++)
+        {
+            records.push_back({ i + 1, "token", EventLatency_Normal, EventPersistence_Normal, static_cast<int64_t>(i + 1), makeEventPayload(i) });
+            rawBytes += sizeof(StorageRecordId) + records.back().tenantToken.size() + records.back().blob.size();
+        }
+
+        size_t sizeBefore = offlineStorage->GetStoredSizeEstimate();
+        auto start = std::chrono::steady_clock::now();
+        EXPECT_THAT(offlineStorage->StoreRecords(records), recordCount);
+        auto storeUs = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+
+        TestRecordConsumer consumer;
+        start = std::chrono::steady_clock::now();
+        EXPECT_THAT(offlineStorage->GetAndReserveRecords(consumer, 100000), true);
+        auto readUs = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+        EXPECT_THAT(consumer.records.size(), recordCount);
+
+        size_t storedBytes = offlineStorage->GetStoredSizeEstimate() - sizeBefore;
+        if (compress)
+        {
+            EXPECT_THAT(storedBytes, Lt(rawBytes));
+        }
+        std::cerr << "[          ] " << (compress ? "Compressed" : "Raw") << " payloads x" << recordCount << ": "
+                  << storedBytes / recordCount << " bytes/record stored (" << rawBytes / recordCount << " raw, "
+                  << (storedBytes ? (100 * rawBytes / storedBytes) : 0) << "% capacity), store "
+                  << storeUs / recordCount << " us/record, read " << readUs / recordCount << " us/record" << std::endl;
+        shutdownAndRemoveFile();
+    }
 }
 
+#endif // HAVE_MAT_ZLIB
+
 TEST_F(OfflineStorageTests_SQLite, SqliteDbInstancesAreCounted)
 {
     OfflineStorage_SQLiteNoAutoCommit offline2(*logManager, configMock, true);
@@ -8,6 +8,8 @@
 #include "CsProtocol_types.hpp"
 #include "bond/generated/CsProtocol_readers.hpp"
 
+#include <chrono>
+
 using namespace testing;
 using namespace MAT;
 
@@ -48,7 +50,7 @@ TEST_F(PackagerTests, PackagesEventsByTenant)
         .WillOnce(Return(100000))
         .RetiresOnSaturation();
 
-    StorageRecord record1("r1", "tenant1-token", EventLatency_Normal, EventPersistence_Normal, 1234567890, std::vector<uint8_t>{1, 1, 1, 0});
+    StorageRecord record1(1, "tenant1-token", EventLatency_Normal, EventPersistence_Normal, 1234567890, std::vector<uint8_t>{1, 1, 1, 0});
     bool wantMore = true;
     packager.addEventToPackage(ctx, record1, wantMore);
 
@@ -57,13 +59,9 @@ TEST_F(PackagerTests, PackagesEventsByTenant)
     packager.finalizePackage(ctx);
 
     EXPECT_THAT(ctx->body, Not(IsEmpty()));
-    EXPECT_THAT(ctx->recordIdsAndTenantIds, SizeIs(1));
-    std::vector<std::string> recordIds;
-    for (const auto& element : ctx->recordIdsAndTenantIds)
-    {
-        recordIds.push_back(element.first);
-    }
-    EXPECT_THAT(recordIds, Contains("r1"));
+    EXPECT_THAT(ctx->recordIdsAndTenantIds.ids(), SizeIs(1));
+    EXPECT_THAT(ctx->recordIdsAndTenantIds.ids(), Contains(1u));
+    EXPECT_THAT(ctx->recordIdsAndTenantIds.tenantToken(0), Eq("tenant1-token"));
     EXPECT_THAT(ctx->packageIds, SizeIs(1));
     EXPECT_THAT(ctx->packageIds, Contains(Key("tenant1-token")));
 
@@ -75,7 +73,7 @@ TEST_F(PackagerTests, PackagesEventsByTenant)
 
     wantMore = true;
     packager.addEventToPackage(ctx, record1, wantMore);
-    StorageRecord record2("r2", "tenant2-token", EventLatency_Normal, EventPersistence_Normal, 1234567891, std::vector<uint8_t>{2, 2, 2, 0});
+    StorageRecord record2(2, "tenant2-token", EventLatency_Normal, EventPersistence_Normal, 1234567891, std::vector<uint8_t>{2, 2, 2, 0});
     packager.addEventToPackage(ctx, record2, wantMore);
 
     EXPECT_CALL(*this, resultPackagedEvents(ctx))
@@ -83,15 +81,10 @@ TEST_F(PackagerTests, PackagesEventsByTenant)
     packager.finalizePackage(ctx);
 
     EXPECT_THAT(ctx->body, Not(IsEmpty()));
-    EXPECT_THAT(ctx->recordIdsAndTenantIds, SizeIs(2));
-
-    recordIds.clear();
-    for (const auto& element : ctx->recordIdsAndTenantIds)
-    {
-        recordIds.push_back(element.first);
-    }
-    EXPECT_THAT(recordIds, Contains("r1"));
-    EXPECT_THAT(recordIds, Contains("r2"));
+    EXPECT_THAT(ctx->recordIdsAndTenantIds.ids(), SizeIs(2));
+    EXPECT_THAT(ctx->recordIdsAndTenantIds.ids(), Contains(1u));
+    EXPECT_THAT(ctx->recordIdsAndTenantIds.ids(), Contains(2u));
+    EXPECT_THAT(ctx->recordIdsAndTenantIds.tenantTokens(), ElementsAre("tenant1-token", "tenant2-token"));
     EXPECT_THAT(ctx->packageIds, SizeIs(2));
     EXPECT_THAT(ctx->packageIds, Contains(Key("tenant1-token")));
     EXPECT_THAT(ctx->packageIds, Contains(Key("tenant2-token")));
@@ -105,7 +98,7 @@ TEST_F(PackagerTests, UsesPriorityOfTheFirstEvent)
         .RetiresOnSaturation();
     EXPECT_THAT(ctx->latency, EventLatency_Unspecified);
 
-    StorageRecord record("r1", "tenant1-token", EventLatency_Normal, EventPersistence_Normal, 1234567890, std::vector<uint8_t>{1, 1, 1, 0});
+    StorageRecord record(1, "tenant1-token", EventLatency_Normal, EventPersistence_Normal, 1234567890, std::vector<uint8_t>{1, 1, 1, 0});
     bool wantMore = false;
     packager.addEventToPackage(ctx, record, wantMore);
     EXPECT_THAT(ctx->latency, EventLatency_Normal);
@@ -124,7 +117,7 @@ TEST_F(PackagerTests, HonorsMaximumPackageSize)
     bool wantMore = true;
     int i = 0;
     while (i < 4 && wantMore) {
-        StorageRecord record("r" + toString(i), "tenant1-token", EventLatency_Normal, EventPersistence_Normal, 1234567890 + i, std::vector<uint8_t>(PartSize, 0));
+        StorageRecord record(i + 1, "tenant1-token", EventLatency_Normal, EventPersistence_Normal, 1234567890 + i, std::vector<uint8_t>(PartSize, 0));
         packager.addEventToPackage(ctx, record, wantMore);
         i++;
     }
@@ -149,7 +142,7 @@ TEST_F(PackagerTests, PackagesAtLeastOneEventEvenIfOverSizeLimit)
         .RetiresOnSaturation();
 
     bool wantMore = true;
-    StorageRecord record("r", "tenant1-token", EventLatency_Normal, EventPersistence_Normal, 1234567890, std::vector<uint8_t>(MaxSize, 0));
+    StorageRecord record(1, "tenant1-token", EventLatency_Normal, EventPersistence_Normal, 1234567890, std::vector<uint8_t>(MaxSize, 0));
     packager.addEventToPackage(ctx, record, wantMore);
     EXPECT_THAT(wantMore, false);
 
@@ -168,11 +161,11 @@ TEST_F(PackagerTests, SetsRequestBondFieldsCorrectly)
         .RetiresOnSaturation();
 
     bool wantMore = true;
-    StorageRecord record1("r1", "tenant1-token", EventLatency_Normal, EventPersistence_Normal, 1234567890, std::vector<uint8_t>{0});
+    StorageRecord record1(1, "tenant1-token", EventLatency_Normal, EventPersistence_Normal, 1234567890, std::vector<uint8_t>{0});
     packager.addEventToPackage(ctx, record1, wantMore);
-    StorageRecord record2("r2", "tenant2-token", EventLatency_Normal, EventPersistence_Normal, 1234567891, std::vector<uint8_t>{0});
+    StorageRecord record2(2, "tenant2-token", EventLatency_Normal, EventPersistence_Normal, 1234567891, std::vector<uint8_t>{0});
     packager.addEventToPackage(ctx, record2, wantMore);
-    StorageRecord record3("r3", "tenant1-token", EventLatency_Normal, EventPersistence_Normal, 1234567892, std::vector<uint8_t>{0});
+    StorageRecord record3(3, "tenant1-token", EventLatency_Normal, EventPersistence_Normal, 1234567892, std::vector<uint8_t>{0});
     packager.addEventToPackage(ctx, record1, wantMore);
 
     EXPECT_CALL(*this, resultPackagedEvents(ctx))
@@ -214,11 +207,11 @@ TEST_F(PackagerTests, ForcedTenantIsForced)
         .RetiresOnSaturation();
 
     bool wantMore = true;
-    StorageRecord record1("r1", "tenant1-token", EventLatency_Normal, EventPersistence_Normal, 1234567890, std::vector<uint8_t>{0});
+    StorageRecord record1(1, "tenant1-token", EventLatency_Normal, EventPersistence_Normal, 1234567890, std::vector<uint8_t>{0});
     packagerF.addEventToPackage(ctx, record1, wantMore);
-    StorageRecord record2("r2", "tenant2-token", EventLatency_Normal, EventPersistence_Normal, 1234567891, std::vector<uint8_t>{0});
+    StorageRecord record2(2, "tenant2-token", EventLatency_Normal, EventPersistence_Normal, 1234567891, std::vector<uint8_t>{0});
     packagerF.addEventToPackage(ctx, record2, wantMore);
-    StorageRecord record3("r3", "tenant1-token", EventLatency_Normal, EventPersistence_Normal, 1234567892, std::vector<uint8_t>{0});
+    StorageRecord record3(3, "tenant1-token", EventLatency_Normal, EventPersistence_Normal, 1234567892, std::vector<uint8_t>{0});
     packagerF.addEventToPackage(ctx, record1, wantMore);
 
     EXPECT_CALL(*this, resultPackagedEvents(ctx))
@@ -227,6 +220,8 @@ TEST_F(PackagerTests, ForcedTenantIsForced)
 
     EXPECT_THAT(ctx->packageIds, SizeIs(1));
     EXPECT_THAT(ctx->packageIds, Contains(Key("forced-Tenant-Token")));
+    // Statistics still see the tenants of the records
+    EXPECT_THAT(ctx->recordIdsAndTenantIds.countPerTenant(), ElementsAre(Pair("tenant1-token", 2u), Pair("tenant2-token", 1u)));
 /*
     AriaProtocol::ClientToCollectorRequest r;
     bond_lite::CompactBinaryProtocolReader reader(ctx->body);
@@ -238,3 +233,47 @@ TEST_F(PackagerTests, ForcedTenantIsForced)
     ASSERT_THAT(r.TokenToDataPackagesMap["forced-tenant-token"][0].Records, SizeIs(3));
 */
 }
+
+TEST_F(PackagerTests, Package50kRecordsPerfTest)
+{
+    size_t const count = 50000;
+    std::vector<std::string> tenants{ "tenant1-token", "tenant2-token", "tenant3-token" };
+    std::vector<StorageRecord> records;
+    records.reserve(count);
+    for (size_t i = 0; i < count; i++)
+    {
+        // Runs of records per tenant, as they come out of storage
+        std::vector<uint8_t> blob(300, static_cast<uint8_t>(i));
+        blob.back() = 0;
+        records.push_back(StorageRecord(PAL::generateRecordId(), tenants[(i / 100) % tenants.size()], EventLatency_Normal, EventPersistence_Normal, 1234567890 + i, std::move(blob)));
+    }
+
+    auto ctx = std::make_shared<EventsUploadContext>();
+    EXPECT_CALL(runtimeConfigMock, GetMaximumUploadSizeBytes())
+        .WillOnce(Return(0xFFFFFFFFu))
+        .RetiresOnSaturation();
+    EXPECT_CALL(*this, resultPackagedEvents(ctx))
+        .WillOnce(Return());
+
+    // Per-record trace messages would be all that is measured otherwise
+    auto logLevel = PAL::detail::g_logLevel;
+    PAL::detail::g_logLevel = PAL::LogLevel::Error;
+    auto start = std::chrono::steady_clock::now();
+    bool wantMore = true;
+    for (auto const& record : records)
+    {
+        packager.addEventToPackage(ctx, record, wantMore);
+    }
+    auto added = std::chrono::steady_clock::now();
+    packager.finalizePackage(ctx);
+    auto spliced = std::chrono::steady_clock::now();
+    PAL::detail::g_logLevel = logLevel;
+
+    EXPECT_THAT(ctx->body, SizeIs(count * 300));
+    EXPECT_THAT(ctx->packageIds, SizeIs(tenants.size()));
+    auto nsPerRecord = [&](std::chrono::steady_clock::time_point from, std::chrono::steady_clock::time_point to) {
+        return static_cast<long long>(std::chrono::duration_cast<std::chrono::nanoseconds>(to - from).count() / count);
+    };
+    std::cerr << "[          ] add: " << nsPerRecord(start, added) << " ns/record, splice: "
+              << nsPerRecord(added, spliced) << " ns/record (" << count << " records)" << std::endl;
+}
@@ -41,6 +41,16 @@ TEST_F(PalTests, UuidGeneration)
     EXPECT_THAT(diff, Gt(20u));
 }
 
+TEST_F(PalTests, RecordIdGeneration)
+{
+    uint64_t id0 = PAL::generateRecordId();
+    uint64_t id1 = PAL::generateRecordId();
+
+    EXPECT_THAT(id0, Ge(uint64_t(1) << 62));
+    EXPECT_THAT(id0, Le(static_cast<uint64_t>(INT64_MAX)));
+    EXPECT_THAT(id1, Gt(id0));
+}
+
 TEST_F(PalTests, PseudoRandomGenerator)
 {
     PAL::PseudoRandomGenerator prg;
@@ -127,3 +137,56 @@ TEST_F(PalTests, SdkVersion)
 
     EXPECT_THAT(PAL::getSdkVersion(), Eq(v));
 }
+
+TEST_F(PalTests, ComponentLogLevelOverridesGlobalLevel)
+{
+    auto logLevel = PAL::detail::g_logLevel;
+    PAL::detail::g_logLevel = PAL::LogLevel::Warning;
+
+    EXPECT_TRUE(PAL::setComponentLogLevel("Tests.Verbose", PAL::LogLevel::Detail));
+    EXPECT_TRUE(PAL::setComponentLogLevel("Tests.Quiet", PAL::LogLevel::Error));
+
+    EXPECT_TRUE(MATSDK_LOG_MAYBE_ENABLED_(PAL::Detail));
+    EXPECT_TRUE(PAL::detail::isComponentLogEnabled("Tests.Verbose", PAL::Detail));
+    EXPECT_FALSE(PAL::detail::isComponentLogEnabled("Tests.Quiet", PAL::Warning));
+    EXPECT_TRUE(PAL::detail::isComponentLogEnabled("Tests.Quiet", PAL::Error));
+    EXPECT_TRUE(PAL::detail::isComponentLogEnabled("Tests.Other", PAL::Warning));
+    EXPECT_FALSE(PAL::detail::isComponentLogEnabled("Tests.Other", PAL::Info));
+
+    PAL::resetComponentLogLevels();
+    EXPECT_FALSE(MATSDK_LOG_MAYBE_ENABLED_(PAL::Detail));
+    EXPECT_FALSE(PAL::detail::isComponentLogEnabled("Tests.Verbose", PAL::Detail));
+    EXPECT_TRUE(PAL::detail::isComponentLogEnabled("Tests.Quiet", PAL::Warning));
+
+    PAL::detail::g_logLevel = logLevel;
+}
+
+TEST_F(PalTests, TraceArgumentsAreOnlyEvaluatedWhenEnabled)
+{
+    auto logLevel = PAL::detail::g_logLevel;
+    PAL::detail::g_logLevel = PAL::LogLevel::Error;
+
+    int evaluated = 0;
+    auto argument = [&evaluated]() { evaluated++; return "argument"; };
+    MATSDK_LOG_(PAL::Detail, "Tests.Arguments", "%s", argument());
+    EXPECT_THAT(evaluated, Eq(0));
+
+    PAL::setComponentLogLevel("Tests.Arguments", PAL::LogLevel::Detail);
+    MATSDK_LOG_(PAL::Detail, "Tests.Arguments", "%s", argument());
+    EXPECT_THAT(evaluated, Eq(MATSDK_LOG_LEVEL_MAX >= PAL::Detail ? 1 : 0));
+
+    PAL::resetComponentLogLevels();
+    PAL::detail::g_logLevel = logLevel;
+}
+
+TEST_F(PalTests, TenantIdTraceArguments)
+{
+    std::string token = "6d084bbf6a9644ef83f40a77c9e34580-c2d379e0-4408-4325-9b4d-2a7d78131e14-7322";
+    char buffer[64];
+    snprintf(buffer, sizeof(buffer), "%.*s", MATSDK_TENANT_ID_ARGS(token));
+    EXPECT_THAT(std::string(buffer), Eq(MAT::tenantTokenToId(token)));
+
+    std::string id = "6d084bbf6a9644ef83f40a77c9e34580";
+    snprintf(buffer, sizeof(buffer), "%.*s", MATSDK_TENANT_ID_ARGS(id));
+    EXPECT_THAT(std::string(buffer), Eq(id));
+}
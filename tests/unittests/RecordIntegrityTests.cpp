@@ -0,0 +1,212 @@
+//
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// SPDX-License-Identifier: Apache-2.0
+//
+
+#include "common/Common.hpp"
+#include "common/MockIRuntimeConfig.hpp"
+#include "offline/RecordIntegrity.hpp"
+#include "utils/Crc32c.hpp"
+#include "utils/Sha256.hpp"
+
+#include <chrono>
+#include <cstring>
+
+using namespace testing;
+using namespace MAT;
+
+namespace {
+
+    std::vector<uint8_t> bytes(char const* text)
+    {
+        return std::vector<uint8_t>(text, text + strlen(text));
+    }
+
+    std::string toHex(std::vector<uint8_t> const& digest)
+    {
+        static char const digits[] = "0123456789abcdef";
+        std::string hex;
+        for (uint8_t b : digest)
+        {
+            hex += digits[b >> 4];
+            hex += digits[b & 0x0F];
+        }
+        return hex;
+    }
+
+    StorageRecord makeRecord(size_t size)
+    {
+        StorageRecord record{ 1, "token", EventLatency_Normal, EventPersistence_Normal, 1, StorageBlob(size) };
+        for (size_t i = 0; i < size; i++)
+        {
+            record.blob[i] = static_cast<uint8_t>(i * 31 + 7);
+        }
+        return record;
+    }
+
+}
+
+TEST(RecordIntegrityTests, Crc32cMatchesCheckValue)
+{
+    auto data = bytes("123456789");
+    EXPECT_EQ(Crc32c::Compute(data.data(), data.size()), 0xE3069283u);
+    EXPECT_EQ(Crc32c::ComputeSoftware(data.data(), data.size()), 0xE3069283u);
+    EXPECT_EQ(Crc32c::Compute(nullptr, 0), 0u);
+}
+
+TEST(RecordIntegrityTests, Crc32cCanBeComputedIncrementally)
+{
+    auto data = bytes("The quick brown fox jumps over the lazy dog");
+    uint32_t crc = Crc32c::Compute(data.data(), 10);
+    crc = Crc32c::Compute(data.data() + 10, data.size() - 10, crc);
+    EXPECT_EQ(crc, Crc32c::Compute(data.data(), data.size()));
+}
+
+TEST(RecordIntegrityTests, Crc32cImplementationsAgreeOnAllLengthsAndAlignments)
+{
+    std::vector<uint8_t> data(128 + 8);
+    for (size_t i = 0; i < data.size(); i++)
+    {
+        data[i] = static_cast<uint8_t>(i * 131 + 17);
+    }
+    for (size_t offset = 0; offset < 8; offset++)
+    {
+        for (size_t size = 0; size <= 128; size++)
+        {
+            ASSERT_EQ(Crc32c::Compute(data.data() + offset, size), Crc32c::ComputeSoftware(data.data() + offset, size))
+                << "offset " << offset << ", size " << size;
+        }
+    }
+}
+
+TEST(RecordIntegrityTests, Sha256MatchesTestVectors)
+{
+    EXPECT_EQ(toHex(Sha256::Hash(nullptr, 0)), "e3b0c44298fc1c149afbf4c8996fb92427ae41e4649b934ca495991b7852b855");
+    auto abc = bytes("abc");
+    EXPECT_EQ(toHex(Sha256::Hash(abc.data(), abc.size())), "ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad");
+    auto twoBlocks = bytes("abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq");
+    EXPECT_EQ(toHex(Sha256::Hash(twoBlocks.data(), twoBlocks.size())), "248d6a61d20638b8e5c026930c3e6039a33ce45964ff2167f6ecedd419db06c1");
+
+    Sha256 sha;
+    for (uint8_t b : twoBlocks)
+    {
+        sha.Update(&b, 1);
+    }
+    EXPECT_EQ(toHex(sha.Finish()), "248d6a61d20638b8e5c026930c3e6039a33ce45964ff2167f6ecedd419db06c1");
+}
+
+TEST(RecordIntegrityTests, HmacSha256MatchesRfc4231)
+{
+    auto data = bytes("what do ya want for nothing?");
+    EXPECT_EQ(toHex(Sha256::Hmac(bytes("Jefe"), data.data(), data.size())), "5bdcc146bf60754e6a042426089575c75a003f089d2739839dec58b964ec3843");
+
+    // Keys longer than a block are hashed first
+    std::vector<uint8_t> longKey(131, 0xAA);
+    auto message = bytes("Test Using Larger Than Block-Size Key - Hash Key First");
+    EXPECT_EQ(toHex(Sha256::Hmac(longKey, message.data(), message.size())), "60e431591ee0b67f0d8a26aacbf5b77f8e0bc6213728c5140546040f0ee37f54");
+}
+
+TEST(RecordIntegrityTests, ModeFollowsConfiguration)
+{
+    EXPECT_EQ(RecordIntegrity().GetMode(), RecordIntegrity::Mode::None);
+
+    MockIRuntimeConfig config;
+    EXPECT_EQ(RecordIntegrity(config).GetMode(), RecordIntegrity::Mode::None);
+
+    config[CFG_BOOL_ENABLE_CRC32] = true;
+    EXPECT_EQ(RecordIntegrity(config).GetMode(), RecordIntegrity::Mode::Crc32c);
+
+    // HMAC without a key falls back to CRC-32C
+    config[CFG_BOOL_ENABLE_CRC32] = false;
+    config[CFG_BOOL_ENABLE_HMAC] = true;
+    EXPECT_EQ(RecordIntegrity(config).GetMode(), RecordIntegrity::Mode::Crc32c);
+
+    config[CFG_STR_HMAC_KEY] = "secret";
+    EXPECT_EQ(RecordIntegrity(config).GetMode(), RecordIntegrity::Mode::HmacSha256);
+}
+
+TEST(RecordIntegrityTests, SignedRecordsVerifyUntilTampered)
+{
+    MockIRuntimeConfig config;
+    config[CFG_BOOL_ENABLE_CRC32] = true;
+    RecordIntegrity crc(config);
+    config[CFG_BOOL_ENABLE_HMAC] = true;
+    config[CFG_STR_HMAC_KEY] = "secret";
+    RecordIntegrity hmac(config);
+
+    for (RecordIntegrity const* integrity : { &crc, &hmac })
+    {
+        StorageRecord record = makeRecord(100);
+        integrity->Sign(record);
+        EXPECT_THAT(record.digest, Not(IsEmpty()));
+        EXPECT_TRUE(integrity->Verify(record));
+
+        record.blob[50] ^= 0x01;
+        EXPECT_FALSE(integrity->Verify(record));
+        record.blob[50] ^= 0x01;
+        record.blob.push_back(0);
+        EXPECT_FALSE(integrity->Verify(record));
+    }
+}
+
+TEST(RecordIntegrityTests, RecordsAreCheckedWhateverTheCurrentMode)
+{
+    MockIRuntimeConfig config;
+    config[CFG_BOOL_ENABLE_CRC32] = true;
+    StorageRecord record = makeRecord(10);
+    RecordIntegrity(config).Sign(record);
+
+    RecordIntegrity verifyOnly;
+    EXPECT_TRUE(verifyOnly.Verify(record));
+    record.blob[0] ^= 0xFF;
+    EXPECT_FALSE(verifyOnly.Verify(record));
+
+    // Unsigned records are accepted, digests of unknown size are not
+    record.digest.clear();
+    EXPECT_TRUE(verifyOnly.Verify(record));
+    record.digest = { 1, 2, 3 };
+    EXPECT_FALSE(verifyOnly.Verify(record));
+
+    // Signing without a mode clears a stale digest
+    verifyOnly.Sign(record);
+    EXPECT_THAT(record.digest, IsEmpty());
+}
+
+TEST(RecordIntegrityTests, HmacDetectsRecordsSignedWithAnotherKey)
+{
+    MockIRuntimeConfig config;
+    config[CFG_BOOL_ENABLE_HMAC] = true;
+    config[CFG_STR_HMAC_KEY] = "first";
+    StorageRecord record = makeRecord(64);
+    RecordIntegrity(config).Sign(record);
+
+    config[CFG_STR_HMAC_KEY] = "second";
+    EXPECT_FALSE(RecordIntegrity(config).Verify(record));
+}
+
+TEST(RecordIntegrityTests, ThroughputPerfTest)
+{
+    std::vector<uint8_t> data(1024 * 1024);
+    for (size_t i = 0; i < data.size(); i++)
+    {
+        data[i] = static_cast<uint8_t>(i * 2654435761u >> 13);
+    }
+    size_t const rounds = 32;
+
+    auto measure = [&](char const* name, std::function<uint32_t()> const& run) {
+        uint32_t reference = run();
+        auto start = std::chrono::steady_clock::now();
+        for (size_t i = 0; i < rounds; i++)
+        {
+            EXPECT_EQ(run(), reference);
+        }
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        std::cerr << "[          ] " << name << ": " << static_cast<int>(rounds / seconds) << " MB/s" << std::endl;
+    };
+
+    measure(Crc32c::IsHardwareAccelerated() ? "CRC-32C (hardware)" : "CRC-32C (software only)",
+            [&]() { return Crc32c::Compute(data.data(), data.size()); });
+    measure("CRC-32C slicing-by-8", [&]() { return Crc32c::ComputeSoftware(data.data(), data.size()); });
+    std::vector<uint8_t> key = bytes("secret");
+    measure("HMAC-SHA256", [&]() { return static_cast<uint32_t>(Sha256::Hmac(key, data.data(), data.size())[0]); });
+}
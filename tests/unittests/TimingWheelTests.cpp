@@ -0,0 +1,210 @@
+//
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// SPDX-License-Identifier: Apache-2.0
+//
+#include "common/Common.hpp"
+
+#include "pal/TaskDispatcher.hpp"
+#include "pal/TimingWheel.hpp"
+#include "pal/WorkerThread.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <random>
+
+using namespace testing;
+using namespace MAT;
+using namespace PAL;
+
+namespace {
+
+    std::vector<Task*> popAll(TimingWheel& wheel, uint64_t now)
+    {
+        std::vector<Task*> tasks;
+        while (Task* task = wheel.PopExpired(now))
+        {
+            tasks.push_back(task);
+        }
+        return tasks;
+    }
+
+    class TimerCounter
+    {
+    public:
+        std::atomic<size_t> fired{ 0 };
+
+        void onTimer()
+        {
+            fired++;
+        }
+    };
+
+}
+
+TEST(TimingWheelTests, TasksBecomeDueAtTheirTargetTime)
+{
+    TimingWheel wheel(1000);
+    Task early, late, past;
+    wheel.Add(&late, 1100);
+    wheel.Add(&early, 1001);
+    wheel.Add(&past, 900);
+    EXPECT_EQ(wheel.Size(), 3u);
+
+    EXPECT_THAT(popAll(wheel, 1000), ElementsAre(&past));
+    EXPECT_EQ(wheel.NextWakeup(), 1001u);
+    EXPECT_THAT(popAll(wheel, 1001), ElementsAre(&early));
+    EXPECT_THAT(popAll(wheel, 1099), IsEmpty());
+    EXPECT_THAT(popAll(wheel, 1100), ElementsAre(&late));
+    EXPECT_TRUE(wheel.Empty());
+    EXPECT_EQ(wheel.NextWakeup(), TimingWheel::NoWakeup);
+}
+
+TEST(TimingWheelTests, TasksComeOutInTargetTimeOrderAcrossLevels)
+{
+    uint64_t const start = 0x123456789ull;
+    TimingWheel wheel(start);
+    std::mt19937_64 random(42);
+    std::vector<Task> tasks(2000);
+    std::vector<std::pair<uint64_t, Task*>> expected;
+    for (size_t i = 0; i < tasks.size(); i++)
+    {
+        // From the same millisecond up to days ahead, so that every level is used
+        uint64_t delay = random() % (uint64_t(1) << (1 + (i % 36)));
+        wheel.Add(&tasks[i], start + delay);
+        expected.push_back(std::make_pair(start + delay, &tasks[i]));
+    }
+    std::stable_sort(expected.begin(), expected.end(),
+                     [](std::pair<uint64_t, Task*> const& a, std::pair<uint64_t, Task*> const& b) { return a.first < b.first; });
+
+    // Advance by the wakeups the wheel asks for, as the worker thread does
+    uint64_t now = start;
+    std::vector<uint64_t> times;
+    while (!wheel.Empty())
+    {
+        while (Task* task = wheel.PopExpired(now))
+        {
+            auto it = std::find_if(expected.begin(), expected.end(),
+                                   [task](std::pair<uint64_t, Task*> const& e) { return e.second == task; });
+            ASSERT_NE(it, expected.end());
+            EXPECT_EQ(it->first, now);
+            times.push_back(it->first);
+        }
+        uint64_t wakeup = wheel.NextWakeup();
+        if (wakeup != TimingWheel::NoWakeup)
+        {
+            ASSERT_GT(wakeup, now);
+            now = wakeup;
+        }
+    }
+    ASSERT_EQ(times.size(), expected.size());
+    EXPECT_TRUE(std::is_sorted(times.begin(), times.end()));
+}
+
+TEST(TimingWheelTests, LateAdvanceReturnsAllDueTasks)
+{
+    TimingWheel wheel(0);
+    Task a, b, c;
+    wheel.Add(&c, 5000000);
+    wheel.Add(&b, 70000);
+    wheel.Add(&a, 10);
+    EXPECT_THAT(popAll(wheel, 10000000), ElementsAre(&a, &b, &c));
+}
+
+TEST(TimingWheelTests, RemoveOnlyTouchesQueuedTasks)
+{
+    TimingWheel wheel(0);
+    Task a, b, c;
+    wheel.Add(&a, 100);
+    wheel.Add(&b, 100);
+    wheel.Add(&c, 100000);
+
+    EXPECT_TRUE(wheel.Remove(&a));
+    EXPECT_FALSE(wheel.Remove(&a));
+    EXPECT_TRUE(wheel.Remove(&c));
+    EXPECT_LE(wheel.NextWakeup(), 100u);
+    EXPECT_THAT(popAll(wheel, 100), ElementsAre(&b));
+    EXPECT_FALSE(wheel.Remove(&b));
+    EXPECT_EQ(wheel.NextWakeup(), TimingWheel::NoWakeup);
+}
+
+TEST(TimingWheelTests, AddingQueuedTaskAgainReschedulesIt)
+{
+    TimingWheel wheel(0);
+    Task a;
+    wheel.Add(&a, 50);
+    wheel.Add(&a, 5000);
+    EXPECT_EQ(wheel.Size(), 1u);
+    EXPECT_THAT(popAll(wheel, 50), IsEmpty());
+    EXPECT_THAT(popAll(wheel, 5000), ElementsAre(&a));
+}
+
+TEST(TimingWheelTests, WorkerThreadRunsAndCancelsTimers)
+{
+    auto dispatcher = WorkerThreadFactory::Create();
+    TimerCounter counter;
+    std::vector<DeferredCallbackHandle> handles;
+    for (unsigned i = 0; i < 10; i++)
+    {
+        handles.push_back(scheduleTask(dispatcher.get(), 10 + i, &counter, &TimerCounter::onTimer));
+    }
+    auto cancelled = scheduleTask(dispatcher.get(), 10, &counter, &TimerCounter::onTimer);
+    EXPECT_TRUE(cancelled.Cancel());
+
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while ((counter.fired < 10) && (std::chrono::steady_clock::now() < deadline))
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    EXPECT_EQ(counter.fired, 10u);
+
+    // Cancelling timers that already ran does nothing
+    for (auto& handle : handles)
+    {
+        EXPECT_TRUE(handle.Cancel());
+    }
+    dispatcher->Join();
+    EXPECT_EQ(counter.fired, 10u);
+}
+
+TEST(TimingWheelTests, ScheduleAndCancel10kTimersPerfTest)
+{
+    size_t const timers = 10000;
+    auto dispatcher = WorkerThreadFactory::Create();
+    TimerCounter counter;
+    std::mt19937 random(7);
+
+    std::vector<DeferredCallbackHandle> handles;
+    handles.reserve(timers);
+    auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < timers; i++)
+    {
+        // Spread like retries, flushes and uploads: from seconds up to an hour
+        handles.push_back(scheduleTask(dispatcher.get(), 1000 + random() % 3600000, &counter, &TimerCounter::onTimer));
+    }
+    auto scheduled = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < timers; i++)
+    {
+        EXPECT_TRUE(handles[(i * 7919) % timers].Cancel());
+    }
+    auto cancelled = std::chrono::steady_clock::now();
+
+    auto nsPerTimer = [&](std::chrono::steady_clock::time_point from, std::chrono::steady_clock::time_point to) {
+        return static_cast<long long>(std::chrono::duration_cast<std::chrono::nanoseconds>(to - from).count() / timers);
+    };
+    std::cerr << "[          ] schedule: " << nsPerTimer(start, scheduled) << " ns/timer, cancel: "
+              << nsPerTimer(scheduled, cancelled) << " ns/timer (" << timers << " concurrent timers)" << std::endl;
+
+    // Timers due together fire from a single wakeup
+    for (size_t i = 0; i < timers; i++)
+    {
+        scheduleTask(dispatcher.get(), 50, &counter, &TimerCounter::onTimer);
+    }
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+    while ((counter.fired < timers) && (std::chrono::steady_clock::now() < deadline))
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    EXPECT_EQ(counter.fired, timers);
+    dispatcher->Join();
+}
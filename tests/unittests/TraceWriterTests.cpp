@@ -0,0 +1,160 @@
+//
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// SPDX-License-Identifier: Apache-2.0
+//
+#include "common/Common.hpp"
+
+#include "pal/TraceWriter.hpp"
+
+#include <cstdio>
+#include <fstream>
+#include <thread>
+
+using namespace testing;
+using namespace MAT;
+using namespace PAL;
+
+namespace {
+
+    std::string traceFilePath(char const* name)
+    {
+        return MAT::GetTempDirectory() + "trace-" + name + "-" + std::to_string(MAT::GetCurrentProcessId()) + ".log";
+    }
+
+    std::vector<std::string> readLines(std::string const& path)
+    {
+        std::vector<std::string> lines;
+        std::ifstream file(path);
+        std::string line;
+        while (std::getline(file, line))
+        {
+            lines.push_back(line);
+        }
+        return lines;
+    }
+
+    void appendLine(TraceWriter& writer, LogLevel level, std::string const& message)
+    {
+        writer.Append(level, "Tests", message.data(), message.size());
+    }
+
+}
+
+TEST(TraceWriterTests, WritesLinesOfAllThreadsWithPrefix)
+{
+    std::string path = traceFilePath("threads");
+    TraceWriter writer;
+    ASSERT_TRUE(writer.Start(path, 0));
+
+    std::vector<std::thread> threads;
+    for (int thread = 0; thread < 4; thread++)
+    {
+        threads.emplace_back([&writer, thread]() {
+            for (int i = 0; i < 200; i++)
+            {
+                appendLine(writer, PAL::Info, "thread " + std::to_string(thread) + " line " + std::to_string(i));
+                if (i % 50 == 0)
+                {
+                    // Let the writer catch up, the rings must not overflow here
+                    std::this_thread::sleep_for(std::chrono::milliseconds(TraceWriter::DrainIntervalMs * 2));
+                }
+            }
+        });
+    }
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+    writer.Stop();
+
+    auto lines = readLines(path);
+    EXPECT_THAT(lines, SizeIs(800));
+    EXPECT_THAT(writer.GetDroppedCount(), Eq(0u));
+    for (auto const& line : lines)
+    {
+        // "yyyy-mm-ddThh:mm:ss.mmmZ|<thread>|I|Tests|thread <n> line <i>"
+        ASSERT_THAT(line.size(), Gt(25u));
+        EXPECT_THAT(line.substr(4, 1), Eq("-"));
+        EXPECT_THAT(line.substr(10, 1), Eq("T"));
+        EXPECT_THAT(line.substr(23, 2), Eq("Z|"));
+        EXPECT_THAT(line, HasSubstr("|I|Tests|thread "));
+    }
+    EXPECT_THAT(lines, Contains(EndsWith("|thread 3 line 199")));
+
+    ::remove(path.c_str());
+}
+
+TEST(TraceWriterTests, FullRingDropsAndCountsLines)
+{
+    std::string path = traceFilePath("dropped");
+    TraceWriter writer(8 * 1024);
+    ASSERT_TRUE(writer.Start(path, 0));
+
+    // Much more than the ring holds before the writer thread gets to it
+    std::string const message(1000, 'x');
+    for (int i = 0; i < 1000; i++)
+    {
+        appendLine(writer, PAL::Detail, message);
+    }
+    writer.Stop();
+
+    auto lines = readLines(path);
+    size_t written = 0;
+    for (auto const& line : lines)
+    {
+        if (line.find(message) != std::string::npos)
+        {
+            written++;
+        }
+    }
+    EXPECT_THAT(writer.GetDroppedCount(), Gt(0u));
+    EXPECT_THAT(written + writer.GetDroppedCount(), Eq(1000u));
+    EXPECT_THAT(lines, Contains(HasSubstr("|W|MATSDK.PAL|Dropped ")));
+
+    ::remove(path.c_str());
+}
+
+TEST(TraceWriterTests, RotatesFileAtMaximumSize)
+{
+    std::string path = traceFilePath("rotated");
+    std::string previous = path + ".1";
+    ::remove(previous.c_str());
+
+    TraceWriter writer;
+    ASSERT_TRUE(writer.Start(path, 4096));
+    std::string const message(100, 'y');
+    for (int i = 0; i < 100; i++)
+    {
+        appendLine(writer, PAL::Warning, message);
+        writer.Flush();
+    }
+    writer.Stop();
+
+    auto current = readLines(path);
+    auto rotated = readLines(previous);
+    EXPECT_THAT(rotated, Not(IsEmpty()));
+    EXPECT_THAT(current.size() + rotated.size(), Lt(100u));
+    for (auto const& line : rotated)
+    {
+        EXPECT_THAT(line, HasSubstr("|W|Tests|"));
+    }
+
+    ::remove(path.c_str());
+    ::remove(previous.c_str());
+}
+
+TEST(TraceWriterTests, AppendIsIgnoredUnlessStarted)
+{
+    std::string path = traceFilePath("stopped");
+    TraceWriter writer;
+    appendLine(writer, PAL::Error, "before start");
+    ASSERT_TRUE(writer.Start(path, 0));
+    appendLine(writer, PAL::Error, "while running");
+    writer.Stop();
+    appendLine(writer, PAL::Error, "after stop");
+    writer.Flush();
+
+    EXPECT_THAT(readLines(path), ElementsAre(EndsWith("|E|Tests|while running")));
+
+    ::remove(path.c_str());
+}
@@ -11,6 +11,8 @@
 #include "tpm/TransmissionPolicyManager.hpp"
 #include "TransmitProfiles.hpp"
 
+#include <thread>
+
 using namespace testing;
 using namespace MAT;
 
@@ -37,32 +39,29 @@ class TransmissionPolicyManager4Test : public TransmissionPolicyManager {
     using TransmissionPolicyManager::removeUpload;
     using TransmissionPolicyManager::getCancelWaitTime;
     using TransmissionPolicyManager::cancelUploadTask;
+    using TransmissionPolicyManager::laneFor;
+    using TransmissionPolicyManager::tryAddUpload;
 
     using TransmissionPolicyManager::m_backoff;
     using TransmissionPolicyManager::m_isPaused;
     using TransmissionPolicyManager::m_scheduledUploadAborted;
-    using TransmissionPolicyManager::m_isUploadScheduled;
-    using TransmissionPolicyManager::m_scheduledUploadTime;
-    using TransmissionPolicyManager::m_timerdelay;
-    using TransmissionPolicyManager::m_runningLatency;
+    using TransmissionPolicyManager::m_lanes;
     using TransmissionPolicyManager::m_backoffConfig;
 
     MOCK_METHOD3(scheduleUpload, void(const std::chrono::milliseconds&, EventLatency,bool));
     MOCK_METHOD1(uploadAsync, void(EventLatency));
     MOCK_METHOD0(handleStop, bool());
 
-    bool uploadScheduled() const { return m_isUploadScheduled; }
-    void uploadScheduled(bool state) { m_isUploadScheduled = state; }
+    bool uploadScheduled() const { return m_lanes[0].isUploadScheduled; }
+    void uploadScheduled(bool state) { m_lanes[0].isUploadScheduled = state; }
 
     std::set<EventsUploadContextPtr> const& activeUploads() const { return m_activeUploads; }
-    EventsUploadContextPtr fakeActiveUpload() { auto ctx = std::make_shared<EventsUploadContext>(); ctx->requestedMinLatency = EventLatency_RealTime; m_activeUploads.insert(ctx); return ctx; }
-    EventsUploadContextPtr fakeActiveUpload(EventLatency latency) { auto ctx = std::make_shared<EventsUploadContext>(); ctx->requestedMinLatency = latency; m_activeUploads.insert(ctx); return ctx; }
+    EventsUploadContextPtr fakeActiveUpload() { return fakeActiveUpload(EventLatency_RealTime); }
+    EventsUploadContextPtr fakeActiveUpload(EventLatency latency) { auto ctx = std::make_shared<EventsUploadContext>(); ctx->requestedMinLatency = latency; addUpload(ctx); return ctx; }
 
     bool paused() const { return m_isPaused; }
     void paused(bool state) { m_isPaused = state; }
 
-    void runningLatency(EventLatency latency) { m_runningLatency = latency; }
-
     void NotMockScheduleUpload(const std::chrono::milliseconds& delay, EventLatency latency, bool force)
     {
         TransmissionPolicyManager::scheduleUpload(delay, latency, force);
@@ -178,7 +177,7 @@ TEST_F(TransmissionPolicyManagerTests, IncomingEventSchedulesUpload)
     event->record.latency = EventLatency_Normal;
 
     
-    EXPECT_CALL(tpm, scheduleUpload(std::chrono::milliseconds { 1000 }, EventLatency_Normal, true))
+    EXPECT_CALL(tpm, scheduleUpload(std::chrono::milliseconds { 4000 }, EventLatency_Normal, true))
         .WillOnce(Return());
     tpm.eventArrived(event);
 }
@@ -307,8 +306,7 @@ TEST_F(TransmissionPolicyManagerTests, EmptyUploadReschedulesAtTimerDelayForRunn
 {
     auto upload = tpm.fakeActiveUpload();
     constexpr std::chrono::milliseconds delay { std::chrono::seconds(300) };
-    tpm.m_timerdelay = delay;
-    tpm.runningLatency(EventLatency_RealTime);
+    tpm.laneFor(EventLatency_RealTime).interval = delay;
     EXPECT_CALL(tpm, scheduleUpload(delay, EventLatency_Normal, false))
       .WillOnce(Return());
     tpm.nothingToUpload(upload);
@@ -317,7 +315,7 @@ TEST_F(TransmissionPolicyManagerTests, EmptyUploadReschedulesAtTimerDelayForRunn
 TEST_F(TransmissionPolicyManagerTests, FailedUploadPackagingSchedulesNextOneWithDelay)
 {
     auto upload = tpm.fakeActiveUpload();
-    EXPECT_CALL(tpm, scheduleUpload(std::chrono::milliseconds{ 2000 }, EventLatency_Normal, false))
+    EXPECT_CALL(tpm, scheduleUpload(std::chrono::milliseconds{ 2000 }, EventLatency_RealTime, false))
         .WillOnce(Return());
     tpm.packagingFailed(upload);
 }
@@ -325,7 +323,7 @@ TEST_F(TransmissionPolicyManagerTests, FailedUploadPackagingSchedulesNextOneWith
 TEST_F(TransmissionPolicyManagerTests, SuccessfulUploadSchedulesNextOneImmediately)
 {
     auto upload = tpm.fakeActiveUpload();
-    EXPECT_CALL(tpm, scheduleUpload(std::chrono::milliseconds{ 0 }, EventLatency_Normal, false))
+    EXPECT_CALL(tpm, scheduleUpload(std::chrono::milliseconds{ 0 }, EventLatency_RealTime, false))
         .WillOnce(Return());
     tpm.eventsUploadSuccessful(upload);
 }
@@ -452,7 +450,7 @@ TEST_F(TransmissionPolicyManagerTests, FinishAllUploads)
         .WillOnce(Return());
     tpm.start();
 
-    EXPECT_CALL(tpm, scheduleUpload(std::chrono::milliseconds { 0 }, EventLatency_Normal, false))
+    EXPECT_CALL(tpm, scheduleUpload(std::chrono::milliseconds { 0 }, EventLatency_RealTime, false))
         .Times(2)
         .WillOnce(Return())
         .WillOnce(Return());
@@ -473,6 +471,153 @@ TEST_F(TransmissionPolicyManagerTests, FinishAllUploads)
     tpm.stop();
 }
 
+TEST_F(TransmissionPolicyManagerTests, LanesShareMaxPendingRequestsByWeight)
+{
+    auto upload = [](EventLatency latency) { auto ctx = std::make_shared<EventsUploadContext>(); ctx->requestedMinLatency = latency; return ctx; };
+
+    // Default limit of 4 requests: Normal 1, RealTime 1, Max 2
+    EXPECT_TRUE(tpm.tryAddUpload(upload(EventLatency_Normal)));
+    EXPECT_FALSE(tpm.tryAddUpload(upload(EventLatency_CostDeferred)));
+    EXPECT_TRUE(tpm.tryAddUpload(upload(EventLatency_RealTime)));
+    EXPECT_FALSE(tpm.tryAddUpload(upload(EventLatency_RealTime)));
+    EXPECT_TRUE(tpm.tryAddUpload(upload(EventLatency_Max)));
+    EXPECT_TRUE(tpm.tryAddUpload(upload(EventLatency_Max)));
+    EXPECT_FALSE(tpm.tryAddUpload(upload(EventLatency_Max)));
+
+    EXPECT_THAT(tpm.activeUploads(), SizeIs(4));
+    EXPECT_TRUE(tpm.laneFor(EventLatency_Normal).waiting);
+    EXPECT_TRUE(tpm.laneFor(EventLatency_RealTime).waiting);
+    EXPECT_TRUE(tpm.laneFor(EventLatency_Max).waiting);
+}
+
+TEST_F(TransmissionPolicyManagerTests, HigherLanesBorrowUnusedShareOfLowerLanes)
+{
+    // Idle Normal and RealTime lanes leave all requests to immediate uploads
+    for (size_t i = 0; i < 4; i++)
+    {
+        tpm.fakeActiveUpload(EventLatency_Max);
+    }
+    EXPECT_THAT(tpm.laneFor(EventLatency_Max).inFlight, 4u);
+
+    // ... but never the other way round
+    auto ctx = std::make_shared<EventsUploadContext>();
+    ctx->requestedMinLatency = EventLatency_Normal;
+    EXPECT_FALSE(tpm.tryAddUpload(ctx));
+    EXPECT_TRUE(tpm.laneFor(EventLatency_Normal).waiting);
+}
+
+TEST_F(TransmissionPolicyManagerTests, NormalBacklogDoesNotBlockRealTimeUpload)
+{
+    tpm.paused(false);
+    auto backlog = tpm.fakeActiveUpload(EventLatency_Normal);
+
+    EventsUploadContextPtr upload;
+    EXPECT_CALL(*this, resultInitiateUpload(_))
+        .WillOnce(SaveArg<0>(&upload));
+    tpm.uploadAsync(EventLatency_RealTime);
+
+    ASSERT_THAT(upload, NotNull());
+    EXPECT_THAT(upload->requestedMinLatency, EventLatency_RealTime);
+    EXPECT_THAT(upload->maxUploadSize, testing::getSystem().getConfig().GetMaximumUploadSizeBytes() / 4);
+    EXPECT_THAT(tpm.activeUploads(), SizeIs(2));
+
+    // Another Normal upload waits for the running one
+    tpm.uploadAsync(EventLatency_Normal);
+    EXPECT_THAT(tpm.activeUploads(), SizeIs(2));
+    EXPECT_TRUE(tpm.laneFor(EventLatency_Normal).waiting);
+}
+
+TEST_F(TransmissionPolicyManagerTests, FinishedUploadResumesWaitingLane)
+{
+    tpm.paused(false);
+    std::vector<EventsUploadContextPtr> uploads;
+    for (size_t i = 0; i < 4; i++)
+    {
+        uploads.push_back(tpm.fakeActiveUpload(EventLatency_Max));
+    }
+
+    EXPECT_CALL(*this, resultInitiateUpload(_))
+        .Times(0);
+    tpm.uploadAsync(EventLatency_RealTime);
+    tpm.uploadAsync(EventLatency_Normal);
+    Mock::VerifyAndClearExpectations(this);
+
+    // The freed request goes to the waiting lane with the larger weight
+    {
+        InSequence sequence;
+        EXPECT_CALL(tpm, scheduleUpload(std::chrono::milliseconds { 0 }, EventLatency_RealTime, false))
+            .WillOnce(Return());
+        EXPECT_CALL(tpm, scheduleUpload(std::chrono::milliseconds { 0 }, EventLatency_Max, false))
+            .WillOnce(Return());
+    }
+    tpm.eventsUploadSuccessful(uploads[0]);
+    EXPECT_FALSE(tpm.laneFor(EventLatency_RealTime).waiting);
+    EXPECT_TRUE(tpm.laneFor(EventLatency_Normal).waiting);
+}
+
+TEST_F(TransmissionPolicyManagerTests, PacedUploadsCarryOneIntervalOfProposedBandwidth)
+{
+    tpm.paused(false);
+    std::vector<EventsUploadContextPtr> uploads;
+    EXPECT_CALL(*this, resultInitiateUpload(_))
+        .WillRepeatedly(Invoke([&uploads](EventsUploadContextPtr const& ctx) { uploads.push_back(ctx); }));
+
+    EXPECT_CALL(bandwidthControllerMock, GetProposedBandwidthBps())
+        .WillRepeatedly(Return(100000));
+    tpm.uploadAsync(EventLatency_Normal);
+
+    // Slow links still get packages of a reasonable size
+    EXPECT_CALL(bandwidthControllerMock, GetProposedBandwidthBps())
+        .WillRepeatedly(Return(1000));
+    tpm.uploadAsync(EventLatency_Max);
+
+    ASSERT_THAT(uploads, SizeIs(2));
+    EXPECT_THAT(uploads[0]->maxUploadSize, 100000u);
+    EXPECT_THAT(uploads[1]->maxUploadSize, MinPacedUploadSize);
+}
+
+TEST_F(TransmissionPolicyManagerTests, SuccessfulUploadIsReportedAndPaced)
+{
+    auto upload = tpm.fakeActiveUpload(EventLatency_Normal);
+    auto request = new SimpleHttpRequest("paced");
+    request->m_body.resize(50000);
+    request->m_method.clear();
+    upload->httpRequest = request;
+    upload->durationMs = 200;
+    upload->packageFull = true;
+
+    // 50 KB at 100 KB/s take 500 ms, of which 200 ms were spent uploading
+    EXPECT_CALL(bandwidthControllerMock, GetProposedBandwidthBps())
+        .WillRepeatedly(Return(100000));
+    EXPECT_CALL(bandwidthControllerMock, OnUploadCompleted(50000, 200, false))
+        .WillOnce(Return());
+    EXPECT_CALL(tpm, scheduleUpload(std::chrono::milliseconds { 300 }, EventLatency_Normal, false))
+        .WillOnce(Return());
+    tpm.eventsUploadSuccessful(upload);
+}
+
+TEST_F(TransmissionPolicyManagerTests, PacedNormalLaneLimitsBytesInFlight)
+{
+    auto& config = testing::getSystem().getConfig();
+    Variant previous = config[CFG_INT_MAX_PENDING_REQ];
+    config[CFG_INT_MAX_PENDING_REQ] = 14;
+
+    // Normal lane share is 2 requests, but at most two intervals of data fly
+    EXPECT_CALL(bandwidthControllerMock, GetProposedBandwidthBps())
+        .WillRepeatedly(Return(100000));
+    auto upload = [](unsigned size) { auto ctx = std::make_shared<EventsUploadContext>(); ctx->requestedMinLatency = EventLatency_Normal; ctx->maxUploadSize = size; return ctx; };
+    EXPECT_TRUE(tpm.tryAddUpload(upload(150000)));
+    EXPECT_FALSE(tpm.tryAddUpload(upload(100000)));
+    EXPECT_THAT(tpm.laneFor(EventLatency_Normal).inFlightBytes, 150000u);
+
+    // Without an estimate the lane uses its full share
+    EXPECT_CALL(bandwidthControllerMock, GetProposedBandwidthBps())
+        .WillRepeatedly(Return(std::numeric_limits<unsigned>::max()));
+    EXPECT_TRUE(tpm.tryAddUpload(upload(100000)));
+
+    config[CFG_INT_MAX_PENDING_REQ] = previous;
+}
+
 TEST_F(TransmissionPolicyManagerTests, FredProfile)
 {
     const char* fredProfile = R"(
@@ -498,6 +643,76 @@ TEST_F(TransmissionPolicyManagerTests, FredProfile)
     tpm.eventArrived(event);
 }
 
+TEST_F(TransmissionPolicyManagerTests, TimersFollowDeviceStateOfProfileRules)
+{
+    TransmitProfiles::reset();
+    EXPECT_TRUE(TransmitProfiles::setProfile("REAL_TIME"));
+    TimerArray timers;
+
+    EXPECT_TRUE(TransmitProfiles::updateStates(NetworkCost_Metered, PowerSource_Charging));
+    EXPECT_TRUE(TransmitProfiles::isTimerUpdateRequired());
+    TransmitProfiles::getTimers(timers);
+    EXPECT_FALSE(TransmitProfiles::isTimerUpdateRequired());
+    EXPECT_THAT(timers[0], 12000);
+    EXPECT_THAT(timers[1], 3000);
+
+    EXPECT_TRUE(TransmitProfiles::updateStates(NetworkCost_Roaming, PowerSource_Battery));
+    TransmitProfiles::getTimers(timers);
+    EXPECT_THAT(timers[0], -1000);
+    EXPECT_THAT(timers[1], -1000);
+
+    // Power states without a rule of their own match the catch-all rule
+    EXPECT_TRUE(TransmitProfiles::updateStates(NetworkCost_Unmetered, PowerSource_LowBattery));
+    TransmitProfiles::getTimers(timers);
+    EXPECT_THAT(timers[0], -1000);
+
+    EXPECT_TRUE(TransmitProfiles::updateStates(NetworkCost_Any, PowerSource_Any));
+    TransmitProfiles::getTimers(timers);
+    EXPECT_THAT(timers[0], -1000);
+
+    EXPECT_TRUE(TransmitProfiles::updateStates(NetworkCost_Unknown, PowerSource_Charging));
+    TransmitProfiles::getTimers(timers);
+    EXPECT_THAT(timers[0], 4000);
+    EXPECT_THAT(timers[1], 1000);
+}
+
+TEST_F(TransmissionPolicyManagerTests, EventArrivedPerfTest)
+{
+    static size_t const eventCount = 1000000;
+    TransmitProfiles::reset();
+    tpm.paused(false);
+    EXPECT_CALL(tpm, scheduleUpload(_, _, _)).WillRepeatedly(Return());
+
+    IncomingEventContext event;
+    event.record.latency = EventLatency_Normal;
+    // The first event picks up the timers, the rest only check for an update
+    tpm.eventArrived(&event);
+    tpm.uploadScheduled(true);
+
+    for (size_t threadCount = 1; threadCount <= 4; threadCount *= 2)
+    {
+        std::vector<std::thread> threads;
+        auto start = std::chrono::steady_clock::now();
+        for (size_t t = 0; t < threadCount; t++)
+        {
+            threads.emplace_back([this, &event]() {
+                for (size_t i = 0; i < eventCount; i++)
+                {
+                    tpm.eventArrived(&event);
+                }
+            });
+        }
+        for (auto& thread : threads)
+        {
+            thread.join();
+        }
+        auto elapsedNs = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+        std::cerr << "[          ] eventArrived x" << eventCount << " on " << threadCount << " thread(s): "
+                  << elapsedNs / eventCount << " ns/event" << std::endl;
+    }
+    tpm.uploadScheduled(false);
+}
+
 TEST_F(TransmissionPolicyManagerTests, Constructor_IsPaused_True)
 {
     ASSERT_TRUE(tpm.m_isPaused);
@@ -505,7 +720,10 @@ TEST_F(TransmissionPolicyManagerTests, Constructor_IsPaused_True)
 
 TEST_F(TransmissionPolicyManagerTests, Constructor_IsUploadScheduled_False)
 {
-    ASSERT_FALSE(tpm.m_isUploadScheduled);
+    for (auto const& lane : tpm.m_lanes)
+    {
+        ASSERT_FALSE(lane.isUploadScheduled);
+    }
 }
 
 TEST_F(TransmissionPolicyManagerTests, Constructor_ScheduledUploadAborted_False)
@@ -515,22 +733,34 @@ TEST_F(TransmissionPolicyManagerTests, Constructor_ScheduledUploadAborted_False)
 
 TEST_F(TransmissionPolicyManagerTests, Constructor_ScheduledUploadTime_Uint64Max)
 {
-    ASSERT_EQ(tpm.m_scheduledUploadTime, std::numeric_limits<uint64_t>::max());
+    for (auto const& lane : tpm.m_lanes)
+    {
+        ASSERT_EQ(lane.scheduledUploadTime, std::numeric_limits<uint64_t>::max());
+    }
 }
 
 TEST_F(TransmissionPolicyManagerTests, Constructor_TimerDelay_TwoSeconds)
 {
-    ASSERT_EQ(tpm.m_timerdelay, std::chrono::seconds{ 2 });
+    ASSERT_EQ(tpm.laneFor(EventLatency_Normal).interval, std::chrono::seconds{ 2 });
+    ASSERT_EQ(tpm.laneFor(EventLatency_RealTime).interval, std::chrono::seconds{ 2 });
 }
 
 TEST_F(TransmissionPolicyManagerTests, Constructor_TimerDelayInteger_TwoThousand)
 {
-    ASSERT_EQ(tpm.m_timerdelay.count(), 2000);
+    ASSERT_EQ(tpm.laneFor(EventLatency_Normal).interval.count(), 2000);
+    ASSERT_EQ(tpm.laneFor(EventLatency_RealTime).interval.count(), 2000);
+    ASSERT_EQ(tpm.laneFor(EventLatency_Max).interval.count(), 0);
 }
 
-TEST_F(TransmissionPolicyManagerTests, Constructor_RunningLatency_RealTime)
+TEST_F(TransmissionPolicyManagerTests, Constructor_Lanes_OrderedByPriority)
 {
-    ASSERT_EQ(tpm.m_runningLatency, EventLatency_RealTime);
+    EXPECT_EQ(&tpm.laneFor(EventLatency_Off), &tpm.m_lanes[0]);
+    EXPECT_EQ(&tpm.laneFor(EventLatency_Normal), &tpm.m_lanes[0]);
+    EXPECT_EQ(&tpm.laneFor(EventLatency_CostDeferred), &tpm.m_lanes[0]);
+    EXPECT_EQ(&tpm.laneFor(EventLatency_RealTime), &tpm.m_lanes[1]);
+    EXPECT_EQ(&tpm.laneFor(EventLatency_Max), &tpm.m_lanes[2]);
+    EXPECT_LT(tpm.m_lanes[0].weight, tpm.m_lanes[1].weight);
+    EXPECT_LT(tpm.m_lanes[1].weight, tpm.m_lanes[2].weight);
 }
 
 TEST_F(TransmissionPolicyManagerTests, Constructor_BackoffConfig_RealTime)
@@ -603,9 +833,9 @@ TEST_F(TransmissionPolicyManagerTests, cancelUploadTask_ScheduledUpload_ReturnsT
 
 TEST_F(TransmissionPolicyManagerTests, cancelUploadTask_ScheduledUpload_IsUploadScheduledSetToFalse)
 {
-    tpm.m_isUploadScheduled = true;
+    tpm.uploadScheduled(true);
     tpm.cancelUploadTask();
-    ASSERT_FALSE(tpm.m_isUploadScheduled);
+    ASSERT_FALSE(tpm.uploadScheduled());
 }
 
 TEST_F(TransmissionPolicyManagerTests, increaseBackoff_EmptyBackoffObject_ReturnZero)
@@ -0,0 +1,169 @@
+//
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// SPDX-License-Identifier: Apache-2.0
+//
+#include "common/Common.hpp"
+
+#include "pal/TaskDispatcher.hpp"
+#include "pal/WorkerPool.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+
+using namespace testing;
+using namespace MAT;
+using namespace PAL;
+
+namespace {
+
+    class Recorder
+    {
+    public:
+        std::mutex              lock;
+        std::condition_variable changed;
+        std::vector<std::string> calls;
+        std::atomic<int>        running{ 0 };
+        std::atomic<int>        maxRunning{ 0 };
+        bool                    released = false;
+
+        void record(std::string name)
+        {
+            int now = ++running;
+            int max = maxRunning;
+            while ((now > max) && !maxRunning.compare_exchange_weak(max, now))
+            {
+            }
+            std::this_thread::sleep_for(std::chrono::microseconds(100));
+            --running;
+
+            std::lock_guard<std::mutex> guard(lock);
+            calls.push_back(name);
+            changed.notify_all();
+        }
+
+        void block()
+        {
+            std::unique_lock<std::mutex> guard(lock);
+            changed.wait(guard, [this]() { return released; });
+        }
+
+        void release()
+        {
+            std::lock_guard<std::mutex> guard(lock);
+            released = true;
+            changed.notify_all();
+        }
+
+        bool waitForCalls(size_t count)
+        {
+            std::unique_lock<std::mutex> guard(lock);
+            return changed.wait_for(guard, std::chrono::seconds(10), [this, count]() { return calls.size() >= count; });
+        }
+    };
+
+}
+
+TEST(WorkerPoolTests, LaneRunsItsTasksInOrderOneAtATime)
+{
+    auto pool = WorkerPool::Create(4);
+    EXPECT_EQ(pool->GetThreadCount(), 4u);
+    auto lane = pool->CreateLane();
+    Recorder recorder;
+
+    std::vector<std::string> expected;
+    for (int i = 0; i < 100; i++)
+    {
+        expected.push_back(std::to_string(i));
+        dispatchTask(lane.get(), &recorder, &Recorder::record, expected.back());
+    }
+    ASSERT_TRUE(recorder.waitForCalls(expected.size()));
+    EXPECT_THAT(recorder.calls, ContainerEq(expected));
+    EXPECT_EQ(recorder.maxRunning, 1);
+}
+
+TEST(WorkerPoolTests, LanesRunInParallel)
+{
+    auto pool = WorkerPool::Create(2);
+    auto first = pool->CreateLane();
+    auto second = pool->CreateLane();
+    Recorder recorder;
+
+    // The first lane is stuck until the second one runs
+    dispatchTask(first.get(), &recorder, &Recorder::block);
+    dispatchTask(second.get(), &recorder, &Recorder::release);
+    dispatchTask(first.get(), &recorder, &Recorder::record, std::string("done"));
+    EXPECT_TRUE(recorder.waitForCalls(1));
+}
+
+TEST(WorkerPoolTests, BusyLaneDoesNotHoldBackOthers)
+{
+    auto pool = WorkerPool::Create(1);
+    auto busy = pool->CreateLane();
+    auto quiet = pool->CreateLane();
+    Recorder recorder;
+
+    dispatchTask(busy.get(), &recorder, &Recorder::block);
+    for (int i = 0; i < 100; i++)
+    {
+        dispatchTask(busy.get(), &recorder, &Recorder::record, std::string("busy"));
+    }
+    dispatchTask(quiet.get(), &recorder, &Recorder::record, std::string("quiet"));
+    recorder.release();
+
+    ASSERT_TRUE(recorder.waitForCalls(101));
+    auto position = std::find(recorder.calls.begin(), recorder.calls.end(), "quiet") - recorder.calls.begin();
+    EXPECT_LE(position, 1);
+}
+
+TEST(WorkerPoolTests, TimersRunOnTheirLaneUnlessCancelled)
+{
+    auto pool = WorkerPool::Create(2);
+    auto first = pool->CreateLane();
+    auto second = pool->CreateLane();
+    Recorder recorder;
+
+    auto late = scheduleTask(first.get(), 30, &recorder, &Recorder::record, std::string("late"));
+    auto early = scheduleTask(second.get(), 10, &recorder, &Recorder::record, std::string("early"));
+    auto cancelled = scheduleTask(first.get(), 10, &recorder, &Recorder::record, std::string("cancelled"));
+    EXPECT_TRUE(cancelled.Cancel());
+
+    ASSERT_TRUE(recorder.waitForCalls(2));
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    EXPECT_THAT(recorder.calls, ElementsAre("early", "late"));
+
+    // Already done
+    EXPECT_TRUE(late.Cancel());
+    EXPECT_TRUE(early.Cancel());
+}
+
+TEST(WorkerPoolTests, JoinRunsQueuedTasksAndDropsTimers)
+{
+    auto pool = WorkerPool::Create(1);
+    auto lane = pool->CreateLane();
+    Recorder recorder;
+
+    scheduleTask(lane.get(), 60000, &recorder, &Recorder::record, std::string("timer"));
+    for (int i = 0; i < 10; i++)
+    {
+        dispatchTask(lane.get(), &recorder, &Recorder::record, std::string("queued"));
+    }
+    lane->Join();
+    EXPECT_EQ(recorder.calls.size(), 10u);
+
+    // Nothing runs on a lane after Join
+    dispatchTask(lane.get(), &recorder, &Recorder::record, std::string("late"));
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    EXPECT_EQ(recorder.calls.size(), 10u);
+}
+
+TEST(WorkerPoolTests, PoolOutlivesItsUsers)
+{
+    auto lane = WorkerPool::Create(1)->CreateLane();
+    Recorder recorder;
+    scheduleTask(lane.get(), 5, &recorder, &Recorder::record, std::string("timer"));
+    EXPECT_TRUE(recorder.waitForCalls(1));
+    lane.reset();
+}